@@ -184,6 +184,10 @@ func (binding *Builtin) GetMeta(namespace, key string) (bindings.RawBuffer, erro
 	return ret2go(C.reindexer_get_meta(str2c(namespace), str2c(key)))
 }
 
+func (binding *Builtin) GetMemStat(namespace string) (bindings.RawBuffer, error) {
+	return ret2go(C.reindexer_get_memstat(str2c(namespace)))
+}
+
 func (binding *Builtin) Select(query string, withItems bool, ptVersions []int32, fetchCount int) (bindings.RawBuffer, error) {
 	cgoLimiter <- struct{}{}
 	defer func() { <-cgoLimiter }()
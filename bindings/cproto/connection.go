@@ -43,6 +43,7 @@ const (
 	cmdGetMeta        = 64
 	cmdPutMeta        = 65
 	cmdEnumMeta       = 66
+	cmdGetMemStat     = 80
 	cmdCodeMax        = 128
 )
 
@@ -91,6 +91,7 @@ type indexDef struct {
 	IsArray      bool   `json:"is_array"`
 	IsDense      bool   `json:"is_dense"`
 	IsAppendable bool   `json:"is_appendable"`
+	IsSparse     bool   `json:"is_sparse"`
 	CollateMode  string `json:"collate_mode"`
 	SortOrder    string `json:"sort_order_letters"`
 }
@@ -118,6 +119,7 @@ func (binding *NetCProto) AddIndex(namespace, index, jsonPath, indexType, fieldT
 		IsPK:         opts.IsPK(),
 		IsDense:      opts.IsDense(),
 		IsAppendable: opts.IsAppendable(),
+		IsSparse:     opts.IsSparse(),
 		CollateMode:  cm,
 		SortOrder:    sortOrder,
 	}
@@ -153,6 +155,18 @@ func (binding *NetCProto) GetMeta(namespace, key string) (bindings.RawBuffer, er
 	return buf, nil
 }
 
+func (binding *NetCProto) GetMemStat(namespace string) (bindings.RawBuffer, error) {
+	conn := binding.getConn()
+	buf, err := conn.rpcCall(cmdGetMemStat, namespace)
+	if err != nil {
+		buf.Free()
+		return nil, err
+	}
+	buf.result = buf.args[0].([]byte)
+	buf.reqID = -1
+	return buf, nil
+}
+
 func (binding *NetCProto) Select(query string, withItems bool, ptVersions []int32, fetchCount int) (bindings.RawBuffer, error) {
 	conn := binding.getConn()
 	flags := bindings.ResultsWithPayloadTypes
@@ -14,24 +14,31 @@ const CInt32Max = int(^uint32(0) >> 1)
 
 // public go consts from type_consts.h and reindexer_ctypes.h
 const (
-	EQ     = int(C.CondEq)
-	GT     = int(C.CondGt)
-	LT     = int(C.CondLt)
-	GE     = int(C.CondGe)
-	LE     = int(C.CondLe)
-	SET    = int(C.CondSet)
-	ALLSET = int(C.CondAllSet)
-	RANGE  = int(C.CondRange)
-	ANY    = int(C.CondAny)
-	EMPTY  = int(C.CondEmpty)
+	EQ      = int(C.CondEq)
+	GT      = int(C.CondGt)
+	LT      = int(C.CondLt)
+	GE      = int(C.CondGe)
+	LE      = int(C.CondLe)
+	SET     = int(C.CondSet)
+	ALLSET  = int(C.CondAllSet)
+	RANGE   = int(C.CondRange)
+	ANY     = int(C.CondAny)
+	EMPTY   = int(C.CondEmpty)
+	DWITHIN = int(C.CondDWithin)
+	BOX     = int(C.CondBox)
 
 	ERROR   = int(C.LogError)
 	WARNING = int(C.LogWarning)
 	INFO    = int(C.LogInfo)
 	TRACE   = int(C.LogTrace)
 
-	AggAvg = int(C.AggAvg)
-	AggSum = int(C.AggSum)
+	AggAvg                 = int(C.AggAvg)
+	AggSum                 = int(C.AggSum)
+	AggMin                 = int(C.AggMin)
+	AggMax                 = int(C.AggMax)
+	AggCount               = int(C.AggCount)
+	AggCountDistinct       = int(C.AggCountDistinct)
+	AggCountDistinctApprox = int(C.AggCountDistinctApprox)
 
 	CollateNone    = int(C.CollateNone)
 	CollateASCII   = int(C.CollateASCII)
@@ -63,8 +70,11 @@ const (
 	QueryReqTotal       = int(C.QueryReqTotal)
 	QuerySelectFilter   = int(C.QuerySelectFilter)
 	QuerySelectFunction = int(C.QuerySelectFunction)
+	QueryCacheResults   = int(C.QueryCacheResults)
 	QueryAggregation    = int(C.QueryAggregation)
 
+	QueryApproxAggregations = int(C.QueryApproxAggregations)
+
 	LeftJoin    = int(C.LeftJoin)
 	InnerJoin   = int(C.InnerJoin)
 	OrInnerJoin = int(C.OrInnerJoin)
@@ -90,6 +100,7 @@ const (
 	ModeNoCalc        = int(C.ModeNoTotal)
 	ModeCachedTotal   = int(C.ModeCachedTotal)
 	ModeAccurateTotal = int(C.ModeAccurateTotal)
+	ModeApproxTotal   = int(C.ModeApproxTotal)
 
 	ResultsPure             = int(C.kResultsPure)
 	ResultsWithPtrs         = int(C.kResultsWithPtrs)
@@ -101,6 +112,7 @@ const (
 	IndexOptArray      = uint8(C.kIndexOptArray)
 	IndexOptDense      = uint8(C.kIndexOptDense)
 	IndexOptAppendable = uint8(C.kIndexOptAppendable)
+	IndexOptSparse     = uint8(C.kIndexOptSparse)
 
 	StorageOptEnabled               = uint8(C.kStorageOptEnabled)
 	StorageOptDropOnFileFormatError = uint8(C.kStorageOptDropOnFileFormatError)
@@ -153,6 +165,15 @@ func (indexOpts *IndexOptions) Appendable(value bool) *IndexOptions {
 	return indexOpts
 }
 
+func (indexOpts *IndexOptions) Sparse(value bool) *IndexOptions {
+	if value {
+		*indexOpts |= IndexOptions(IndexOptSparse)
+	} else {
+		*indexOpts &= ^IndexOptions(IndexOptSparse)
+	}
+	return indexOpts
+}
+
 func (indexOpts *IndexOptions) IsPK() bool {
 	return uint8(*indexOpts)&IndexOptPK != 0
 }
@@ -169,6 +190,10 @@ func (indexOpts *IndexOptions) IsAppendable() bool {
 	return uint8(*indexOpts)&IndexOptAppendable != 0
 }
 
+func (indexOpts *IndexOptions) IsSparse() bool {
+	return uint8(*indexOpts)&IndexOptSparse != 0
+}
+
 type StorageOptions uint8
 
 func (so *StorageOptions) Enabled(value bool) *StorageOptions {
@@ -250,6 +275,7 @@ type RawBinding interface {
 	ConfigureIndex(namespace, index, config string) error
 	PutMeta(namespace, key, data string) error
 	GetMeta(namespace, key string) (RawBuffer, error)
+	GetMemStat(namespace string) (RawBuffer, error)
 	ModifyItem(data []byte, mode int) (RawBuffer, error)
 	Select(query string, withItems bool, ptVersions []int32, fetchCount int) (RawBuffer, error)
 	SelectQuery(rawQuery []byte, withItems bool, ptVersions []int32, fetchCount int) (RawBuffer, error)
@@ -72,6 +72,7 @@ Error DBManager::loadOrCreateDatabase(const string &dbName) {
 
 	logPrintf(LogInfo, "Loading database %s", dbName.c_str());
 	auto db = std::make_shared<reindexer::Reindexer>();
+	db->ConfigureSlowQueryLog(slowQueryThreshold_, slowQueryLogSize_);
 	auto status = db->EnableStorage(storagePath);
 	if (!status.ok()) {
 		return status;
@@ -121,6 +122,11 @@ vector<string> DBManager::EnumDatabases() {
 	return dbs;
 }
 
+vector<std::pair<string, shared_ptr<Reindexer>>> DBManager::GetDatabases() {
+	shared_lock<shared_timed_mutex> lck(mtx_);
+	return vector<std::pair<string, shared_ptr<Reindexer>>>(dbs_.begin(), dbs_.end());
+}
+
 Error DBManager::Login(const string &dbName, AuthContext &auth) {
 	if (IsNoSecurity()) {
 		auth.role_ = kRoleOwner;
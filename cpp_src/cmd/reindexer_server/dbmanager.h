@@ -113,6 +113,16 @@ public:
 	/// Enum list of available databases
 	/// @return names of available databases
 	vector<string> EnumDatabases();
+	/// Get all loaded databases, bypassing user's roles checks. Intended for internal use, e.g. for metrics collection
+	/// @return pairs of database name and database object
+	vector<std::pair<string, shared_ptr<Reindexer>>> GetDatabases();
+	/// Set slow queries log parameters of databases. Must be called before Init
+	/// @param thresholdUs - min duration of logged query in microseconds. 0 - log is disabled
+	/// @param maxEntries - max count of queries in log of each database
+	void SetSlowQueryLog(uint64_t thresholdUs, size_t maxEntries) {
+		slowQueryThreshold_ = thresholdUs;
+		slowQueryLogSize_ = maxEntries;
+	}
 
 private:
 	Error readUsers();
@@ -123,6 +133,8 @@ private:
 	string dbpath_;
 	shared_timed_mutex mtx_;
 	bool noSecurity_;
+	uint64_t slowQueryThreshold_ = 0;
+	size_t slowQueryLogSize_ = 100;
 };
 
 }  // namespace reindexer_server
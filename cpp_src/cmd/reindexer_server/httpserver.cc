@@ -3,11 +3,13 @@
 #include <unistd.h>
 #include <sstream>
 #include "base64/base64.h"
+#include "core/lrucache.h"
 #include "core/type_consts.h"
 #include "gason/gason.h"
 #include "loggerwrapper.h"
 #include "net/http/connection.h"
 #include "net/listener.h"
+#include "rpcserver.h"
 #include "tools/fsops.h"
 #include "tools/serializer.h"
 #include "tools/stringstools.h"
@@ -462,6 +464,176 @@ int HTTPServer::DeleteIndex(http::Context &ctx) {
 	return jsonStatus(ctx);
 }
 
+int HTTPServer::GetCacheStats(http::Context &ctx) {
+	shared_ptr<Reindexer> db = getDB(ctx, kRoleDataRead);
+
+	vector<reindexer::NamespaceCacheStats> stats;
+	auto status = db->GetCacheStats(stats);
+	if (!status.ok()) {
+		return jsonStatus(ctx, false, http::StatusInternalServerError, status.what());
+	}
+
+	ctx.writer->SetHeader(http::Header{"Content-Type", "application/json; charset=utf-8"});
+	ctx.writer->SetRespCode(http::StatusOK);
+
+	auto &budget = reindexer::CacheMemoryBudget::Instance();
+	reindexer::WrSerializer wrSer(true);
+	wrSer.Printf("{\"memory_limit\":%zu,\"memory_used\":%zu,", budget.Limit(), budget.Used());
+	wrSer.PutChars("\"items\":[");
+	for (size_t i = 0; i < stats.size(); i++) {
+		if (i != 0) wrSer.PutChar(',');
+		stats[i].GetJSON(wrSer);
+	}
+	wrSer.Printf("],\"total_items\":%zu}", stats.size());
+	ctx.writer->Write(wrSer.Buf(), wrSer.Len());
+
+	return 0;
+}
+
+int HTTPServer::GetMemStat(http::Context &ctx) {
+	shared_ptr<Reindexer> db = getDB(ctx, kRoleDataRead);
+
+	const char *nsName = ctx.request->urlParams[1];
+
+	if (!*nsName) {
+		return jsonStatus(ctx, false, http::StatusBadRequest, "Namespace is not specified");
+	}
+
+	reindexer::NamespaceMemStat stat;
+	auto status = db->GetMemStat(nsName, stat);
+	if (!status.ok()) {
+		return jsonStatus(ctx, false, http::StatusNotFound, status.what());
+	}
+
+	ctx.writer->SetHeader(http::Header{"Content-Type", "application/json; charset=utf-8"});
+	ctx.writer->SetRespCode(http::StatusOK);
+
+	reindexer::WrSerializer wrSer(true);
+	stat.GetJSON(wrSer);
+	ctx.writer->Write(wrSer.Buf(), wrSer.Len());
+
+	return 0;
+}
+
+int HTTPServer::GetPerfStats(http::Context &ctx) {
+	shared_ptr<Reindexer> db = getDB(ctx, kRoleDataRead);
+
+	bool prometheus = false;
+	for (auto p : ctx.request->params) {
+		if (!strcmp(p.name, "format")) prometheus = !strcmp(p.val, "prometheus");
+	}
+
+	vector<reindexer::NamespacePerfStat> stats;
+	auto status = db->GetPerfStats(stats);
+	if (!status.ok()) {
+		return jsonStatus(ctx, false, http::StatusInternalServerError, status.what());
+	}
+
+	reindexer::WrSerializer wrSer(true);
+	if (prometheus) {
+		ctx.writer->SetHeader(http::Header{"Content-Type", "text/plain; version=0.0.4"});
+		reindexer::NamespacePerfStat::GetPrometheus(wrSer, stats);
+	} else {
+		ctx.writer->SetHeader(http::Header{"Content-Type", "application/json; charset=utf-8"});
+		wrSer.PutChars("{\"items\":[");
+		for (size_t i = 0; i < stats.size(); i++) {
+			if (i != 0) wrSer.PutChar(',');
+			stats[i].GetJSON(wrSer);
+		}
+		wrSer.Printf("],\"total_items\":%zu}", stats.size());
+	}
+	ctx.writer->SetRespCode(http::StatusOK);
+	ctx.writer->Write(wrSer.Buf(), wrSer.Len());
+
+	return 0;
+}
+
+int HTTPServer::GetMetrics(http::Context &ctx) {
+	reindexer::WrSerializer wrSer(true);
+
+	vector<string> labels;
+	auto counters = router_.GetMetrics(labels);
+	RequestMetrics::GetPrometheus(wrSer, "reindexer_http_request", counters, labels);
+	wrSer.PutChars("# TYPE reindexer_http_connections gauge\n");
+	wrSer.Printf("reindexer_http_connections %llu\n", static_cast<unsigned long long>(listener_->ActiveConnections()));
+	wrSer.PutChars("# TYPE reindexer_http_connections_accepted_total counter\n");
+	wrSer.Printf("reindexer_http_connections_accepted_total %llu\n", static_cast<unsigned long long>(listener_->AcceptedConnections()));
+
+	if (rpcServer_) rpcServer_->GetMetrics(wrSer);
+
+	vector<reindexer::NamespacePerfStat> perfStats;
+	vector<string> perfStatsDBs;
+	vector<std::pair<string, reindexer::NamespaceCacheStats>> cacheStats;
+	for (auto &db : dbMgr_.GetDatabases()) {
+		vector<reindexer::NamespacePerfStat> dbPerfStats;
+		auto status = db.second->GetPerfStats(dbPerfStats);
+		if (!status.ok()) return jsonStatus(ctx, false, http::StatusInternalServerError, status.what());
+		for (auto &stat : dbPerfStats) {
+			perfStats.push_back(std::move(stat));
+			perfStatsDBs.push_back(db.first);
+		}
+
+		vector<reindexer::NamespaceCacheStats> dbCacheStats;
+		status = db.second->GetCacheStats(dbCacheStats);
+		if (!status.ok()) return jsonStatus(ctx, false, http::StatusInternalServerError, status.what());
+		for (auto &stat : dbCacheStats) cacheStats.push_back({db.first, std::move(stat)});
+	}
+	reindexer::NamespacePerfStat::GetPrometheus(wrSer, perfStats, perfStatsDBs);
+
+	// Index caches of namespace are summed up, to keep cardinality of metrics low
+	auto cacheMetric = [&](const char *metric, size_t reindexer::LRUCacheStats::*field) {
+		wrSer.Printf("# TYPE %s counter\n", metric);
+		for (auto &stat : cacheStats) {
+			size_t indexesVal = 0;
+			for (auto &idx : stat.second.indexes) indexesVal += idx.cache.*field;
+			const std::pair<const char *, size_t> caches[] = {
+				{"query", stat.second.queryCache.*field}, {"results", stat.second.resultsCache.*field}, {"index", indexesVal}};
+			for (auto &c : caches) {
+				wrSer.Printf("%s{db=\"%s\",ns=\"%s\",cache=\"%s\"} %zu\n", metric, stat.first.c_str(), stat.second.name.c_str(), c.first,
+							 c.second);
+			}
+		}
+	};
+	cacheMetric("reindexer_cache_hits_total", &reindexer::LRUCacheStats::hits);
+	cacheMetric("reindexer_cache_misses_total", &reindexer::LRUCacheStats::misses);
+	cacheMetric("reindexer_cache_evictions_total", &reindexer::LRUCacheStats::evictions);
+
+	auto &budget = reindexer::CacheMemoryBudget::Instance();
+	wrSer.PutChars("# TYPE reindexer_cache_memory_bytes gauge\n");
+	wrSer.Printf("reindexer_cache_memory_bytes %zu\n", budget.Used());
+	wrSer.PutChars("# TYPE reindexer_cache_memory_limit_bytes gauge\n");
+	wrSer.Printf("reindexer_cache_memory_limit_bytes %zu\n", budget.Limit());
+
+	ctx.writer->SetHeader(http::Header{"Content-Type", "text/plain; version=0.0.4"});
+	ctx.writer->SetRespCode(http::StatusOK);
+	ctx.writer->Write(wrSer.Buf(), wrSer.Len());
+	return 0;
+}
+
+int HTTPServer::GetSlowQueries(http::Context &ctx) {
+	shared_ptr<Reindexer> db = getDB(ctx, kRoleDataRead);
+
+	vector<reindexer::SlowQueryEntry> entries;
+	auto status = db->GetSlowQueries(entries);
+	if (!status.ok()) {
+		return jsonStatus(ctx, false, http::StatusInternalServerError, status.what());
+	}
+
+	ctx.writer->SetHeader(http::Header{"Content-Type", "application/json; charset=utf-8"});
+	ctx.writer->SetRespCode(http::StatusOK);
+
+	reindexer::WrSerializer wrSer(true);
+	wrSer.PutChars("{\"items\":[");
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (i != 0) wrSer.PutChar(',');
+		entries[i].GetJSON(wrSer);
+	}
+	wrSer.Printf("],\"total_items\":%zu}", entries.size());
+	ctx.writer->Write(wrSer.Buf(), wrSer.Len());
+
+	return 0;
+}
+
 int HTTPServer::Check(http::Context &ctx) { return ctx.String(http::StatusOK, "Hello world"); }
 int HTTPServer::DocHandler(http::Context &ctx) {
 	string path = ctx.request->path + 1;
@@ -552,6 +724,13 @@ bool HTTPServer::Start(const string &addr, ev::dynamic_loop &loop) {
 	router_.POST<HTTPServer, &HTTPServer::PostIndex>("/api/v1/db/:db/namespaces/:ns/indexes", this);
 	router_.DELETE<HTTPServer, &HTTPServer::DeleteIndex>("/api/v1/db/:db/namespaces/:ns/indexes/:idx", this);
 
+	router_.GET<HTTPServer, &HTTPServer::GetCacheStats>("/api/v1/db/:db/cachestats", this);
+	router_.GET<HTTPServer, &HTTPServer::GetMemStat>("/api/v1/db/:db/namespaces/:ns/memstats", this);
+	router_.GET<HTTPServer, &HTTPServer::GetPerfStats>("/api/v1/db/:db/perfstats", this);
+	router_.GET<HTTPServer, &HTTPServer::GetSlowQueries>("/api/v1/db/:db/slowqueries", this);
+
+	router_.GET<HTTPServer, &HTTPServer::GetMetrics>("/metrics", this);
+
 	router_.Middleware<HTTPServer, &HTTPServer::CheckAuth>(this);
 
 	if (logger_) {
@@ -637,6 +816,33 @@ int HTTPServer::queryResults(http::Context &ctx, reindexer::QueryResults &res, c
 		}
 		ctx.writer->Write("],");
 	}
+	bool haveFacets = false;
+	for (auto &facets : res.aggregationFacets) haveFacets |= !facets.empty();
+	if (haveFacets) {
+		ctx.writer->Write("\"facets\":[");
+		for (unsigned i = 0; i < res.aggregationFacets.size(); i++) {
+			if (i) ctx.writer->Write(",");
+			wrSer.Reset();
+			wrSer.PutChar('[');
+			for (auto &f : res.aggregationFacets[i]) {
+				if (&f != &res.aggregationFacets[i].front()) wrSer.PutChar(',');
+				wrSer.PutChars("{\"value\":");
+				wrSer.PrintJsonString(f.value);
+				wrSer.Printf(",\"count\":%d}", f.count);
+			}
+			wrSer.PutChar(']');
+			ctx.writer->Write(wrSer.Buf(), wrSer.Len());
+		}
+		ctx.writer->Write("],");
+	}
+
+	if (!res.groupedResults.counts.empty()) {
+		ctx.writer->Write("\"groups\":");
+		wrSer.Reset();
+		groupedResultsToJSON(res.groupedResults, wrSer);
+		ctx.writer->Write(wrSer.Buf(), wrSer.Len());
+		ctx.writer->Write(",");
+	}
 
 	ctx.writer->Write("\"");
 	ctx.writer->Write(name, strlen(name));
@@ -651,6 +857,42 @@ int HTTPServer::queryResults(http::Context &ctx, reindexer::QueryResults &res, c
 	return 0;
 }
 
+void HTTPServer::groupedResultsToJSON(const reindexer::GroupedResults &groups, reindexer::WrSerializer &ser) {
+	// Groups are written by columns, like in binary protocol. Aggregations are in order of query's aggregations
+	ser.PutChars("{\"fields\":[");
+	for (size_t f = 0; f < groups.fields.size(); f++) {
+		if (f) ser.PutChar(',');
+		ser.PutChars("{\"name\":");
+		ser.PrintJsonString(groups.fields[f]);
+		ser.PutChars(",\"values\":[");
+		for (size_t g = 0; g < groups.keys[f].size(); g++) {
+			if (g) ser.PutChar(',');
+			auto &key = groups.keys[f][g];
+			if (key.Type() == KeyValueString) {
+				ser.PrintJsonString(key.As<string>());
+			} else {
+				ser.Printf("%s", key.As<string>().c_str());
+			}
+		}
+		ser.PutChars("]}");
+	}
+	ser.PutChars("],\"aggregations\":[");
+	for (size_t a = 0; a < groups.aggTypes.size(); a++) {
+		if (a) ser.PutChar(',');
+		ser.PutChars("{\"field\":");
+		ser.PrintJsonString(groups.aggFields[a]);
+		ser.PutChars(",\"values\":[");
+		for (size_t g = 0; g < groups.values[a].size(); g++) {
+			if (g) ser.PutChar(',');
+			ser.Printf("%s", to_string(groups.values[a][g]).c_str());
+		}
+		ser.PutChars("]}");
+	}
+	ser.PutChars("],\"counts\":[");
+	for (size_t g = 0; g < groups.counts.size(); g++) ser.Printf(g ? ",%d" : "%d", groups.counts[g]);
+	ser.PutChars("]}");
+}
+
 int HTTPServer::jsonStatus(http::Context &ctx, bool isSuccess, int respcode, const string &description) {
 	ctx.writer->SetHeader(http::Header{"Content-Type", "application/json; charset=utf-8"});
 	ctx.writer->SetRespCode(respcode);
@@ -14,6 +14,8 @@ namespace reindexer_server {
 using std::string;
 using namespace reindexer::net;
 
+class RPCServer;
+
 struct HTTPClientData : public http::ClientData {
 	AuthContext auth;
 };
@@ -26,6 +28,8 @@ public:
 
 	bool Start(const string &addr, ev::dynamic_loop &loop);
 	void Stop() { listener_->Stop(); }
+	/// Set RPC server, which metrics are exported by /metrics endpoint together with HTTP metrics
+	void SetRPCServer(RPCServer *rpcServer) { rpcServer_ = rpcServer; }
 
 	int NotFoundHandler(http::Context &ctx);
 	int DocHandler(http::Context &ctx);
@@ -47,11 +51,17 @@ public:
 	int GetIndexes(http::Context &ctx);
 	int PostIndex(http::Context &ctx);
 	int DeleteIndex(http::Context &ctx);
+	int GetCacheStats(http::Context &ctx);
+	int GetMemStat(http::Context &ctx);
+	int GetPerfStats(http::Context &ctx);
+	int GetSlowQueries(http::Context &ctx);
+	int GetMetrics(http::Context &ctx);
 	int CheckAuth(http::Context &ctx);
 	void Logger(http::Context &ctx);
 
 protected:
 	int modifyItem(http::Context &ctx, int mode);
+	void groupedResultsToJSON(const reindexer::GroupedResults &groups, reindexer::WrSerializer &ser);
 	int queryResults(http::Context &ctx, reindexer::QueryResults &res, const char *name);
 	int jsonStatus(http::Context &ctx, bool isSuccess = true, int respcode = http::StatusOK, const string &description = "");
 	shared_ptr<Reindexer> getDB(http::Context &ctx, UserRole role);
@@ -64,6 +74,7 @@ protected:
 
 	http::Router router_;
 	std::unique_ptr<Listener> listener_;
+	RPCServer *rpcServer_ = nullptr;
 
 	LoggerWrapper logger_;
 	bool allocDebug_;
@@ -5,6 +5,7 @@
 #include <csignal>
 #include <thread>
 #include "args/args.hpp"
+#include "core/lrucache.h"
 #include "core/reindexer.h"
 #include "dbmanager.h"
 #include "debug/allocdebug.h"
@@ -35,6 +36,13 @@ struct ServerConfig {
 	string RpcLog = "stdout";
 	bool DebugPprof = false;
 	bool DebugAllocs = false;
+	// Memory limit for all caches in megabytes. 0 - unlimited
+	int64_t CacheMemLimit = 0;
+	// Min duration of query in milliseconds to put it to slow queries log. 0 - log is disabled
+	int64_t SlowQueryThreshold = 0;
+	int64_t SlowQueryLogSize = 100;
+	// Collect wait and hold times of namespaces and caches locks
+	bool LockProfiling = true;
 };
 
 ServerConfig config;
@@ -114,6 +122,10 @@ void parseConfigFile(const string &filePath) {
 		config.DaemonPidFile = root["system"]["pidfile"].As<std::string>(config.DaemonPidFile);
 		config.DebugAllocs = root["debug"]["allocs"].As<bool>(config.DebugAllocs);
 		config.DebugPprof = root["debug"]["allocs"].As<bool>(config.DebugPprof);
+		config.CacheMemLimit = root["cache"]["memlimit"].As<int64_t>(config.CacheMemLimit);
+		config.SlowQueryThreshold = root["perf"]["slowquerythreshold"].As<int64_t>(config.SlowQueryThreshold);
+		config.SlowQueryLogSize = root["perf"]["slowquerylogsize"].As<int64_t>(config.SlowQueryLogSize);
+		config.LockProfiling = root["perf"]["lockprofiling"].As<bool>(config.LockProfiling);
 	} catch (Yaml::Exception ex) {
 		fprintf(stderr, "Error with config file '%s': %s\n", filePath.c_str(), ex.Message());
 		exit(EXIT_FAILURE);
@@ -136,6 +148,10 @@ void parseCmdLine(int argc, char **argv) {
 	args::Group dbGroup(parser, "Database options");
 	args::ValueFlag<string> storageF(dbGroup, "PATH", "path to 'reindexer' storage", {'s', "db"}, config.StoragePath,
 									 args::Options::Single);
+	args::ValueFlag<int64_t> cacheMemLimitF(dbGroup, "MB", "memory limit for all query and index caches (0 - unlimited)", {"cachememlimit"},
+											config.CacheMemLimit, args::Options::Single);
+	args::ValueFlag<int64_t> slowQueryThresholdF(dbGroup, "MS", "log queries, which took longer than threshold (0 - disabled)",
+												 {"slowquerythreshold"}, config.SlowQueryThreshold, args::Options::Single);
 
 	args::Group netGroup(parser, "Network options");
 	args::ValueFlag<string> httpAddrF(netGroup, "PORT", "http listen host:port", {'p', "httpaddr"}, config.HTTPAddr, args::Options::Single);
@@ -165,6 +181,8 @@ void parseCmdLine(int argc, char **argv) {
 	}
 
 	if (storageF) config.StoragePath = args::get(storageF);
+	if (cacheMemLimitF) config.CacheMemLimit = args::get(cacheMemLimitF);
+	if (slowQueryThresholdF) config.SlowQueryThreshold = args::get(slowQueryThresholdF);
 	if (logLevelF) config.LogLevel = args::get(logLevelF);
 	if (httpAddrF) config.HTTPAddr = args::get(httpAddrF);
 	if (rpcAddrF) config.RPCAddr = args::get(rpcAddrF);
@@ -276,9 +294,13 @@ int main(int argc, char **argv) {
 	logger = LoggerWrapper("server");
 	coreLogger = LoggerWrapper("core");
 	reindexer::logInstallWriter(logWrite);
+	reindexer::CacheMemoryBudget::Instance().SetLimit(size_t(std::max(config.CacheMemLimit, int64_t(0))) * 1024 * 1024);
+	reindexer::profiled_shared_mutex::enable_profiling(config.LockProfiling);
 
 	try {
 		DBManager dbMgr(config.StoragePath, !config.EnableSecurity);
+		dbMgr.SetSlowQueryLog(uint64_t(std::max(config.SlowQueryThreshold, int64_t(0))) * 1000,
+							  size_t(std::max(config.SlowQueryLogSize, int64_t(1))));
 		auto status = dbMgr.Init();
 		if (!status.ok()) {
 			logger.error("Error init database manager: {0}", status.what());
@@ -301,6 +323,7 @@ int main(int argc, char **argv) {
 			logger.error("Can't listen RPC on '{0}'", config.RPCAddr);
 			exit(EXIT_FAILURE);
 		}
+		httpServer.SetRPCServer(&rpcServer);
 
 		bool terminate = false;
 		auto sigCallback = [&](ev::sig &sig) {
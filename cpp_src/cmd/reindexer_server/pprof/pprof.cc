@@ -2,7 +2,9 @@
 #include <stdlib.h>
 #include <thread>
 #include "debug/backtrace.h"
+#include "estl/shared_mutex.h"
 #include "tools/fsops.h"
+#include "tools/serializer.h"
 
 #if REINDEX_WITH_GPERFTOOLS
 #include <gperftools/heap-profiler.h>
@@ -35,6 +37,8 @@ void Pprof::Attach(http::Router &router) {
 	router.POST<Pprof, &Pprof::Symbol>("/debug/pprof/symbol", this);
 	router.GET<Pprof, &Pprof::Symbol>("/pprof/symbol", this);
 	router.POST<Pprof, &Pprof::Symbol>("/pprof/symbol", this);
+
+	router.GET<Pprof, &Pprof::Locks>("/debug/locks", this);
 }
 
 int Pprof::Profile(http::Context &ctx) {
@@ -115,6 +119,32 @@ int Pprof::Symbol(http::Context &ctx) {
 	return 0;
 }
 
+int Pprof::Locks(http::Context &ctx) {
+	auto stats = reindexer::profiled_shared_mutex::get_stats();
+
+	reindexer::WrSerializer wrSer(true);
+	wrSer.Printf("{\"enabled\":%s,\"items\":[", reindexer::profiled_shared_mutex::profiling_enabled() ? "true" : "false");
+	for (size_t i = 0; i < stats.size(); i++) {
+		auto &stat = stats[i];
+		if (i != 0) wrSer.PutChar(',');
+		wrSer.PutChars("{\"name\":");
+		wrSer.PrintJsonString(stat.name);
+		wrSer.Printf(",\"instances\":%zu,", stat.instances);
+		wrSer.Printf("\"acquisitions\":%llu,", static_cast<unsigned long long>(stat.acquisitions));
+		wrSer.Printf("\"shared_acquisitions\":%llu,", static_cast<unsigned long long>(stat.shared_acquisitions));
+		wrSer.Printf("\"contended\":%llu,", static_cast<unsigned long long>(stat.contended));
+		wrSer.Printf("\"shared_contended\":%llu,", static_cast<unsigned long long>(stat.shared_contended));
+		wrSer.Printf("\"wait_time_us\":%llu,", static_cast<unsigned long long>(stat.wait_time / 1000));
+		wrSer.Printf("\"shared_wait_time_us\":%llu,", static_cast<unsigned long long>(stat.shared_wait_time / 1000));
+		wrSer.Printf("\"max_wait_time_us\":%llu,", static_cast<unsigned long long>(stat.max_wait_time / 1000));
+		wrSer.Printf("\"hold_time_us\":%llu,", static_cast<unsigned long long>(stat.hold_time / 1000));
+		wrSer.Printf("\"max_hold_time_us\":%llu}", static_cast<unsigned long long>(stat.max_hold_time / 1000));
+	}
+	wrSer.Printf("],\"total_items\":%zu}", stats.size());
+
+	return ctx.JSON(http::StatusOK, reindexer::Slice(reinterpret_cast<const char *>(wrSer.Buf()), wrSer.Len()));
+}
+
 string Pprof::resolveSymbol(uintptr_t ptr) {
 	char *csym = resolve_symbol(reinterpret_cast<void *>(ptr), true);
 	string symbol = csym, out;
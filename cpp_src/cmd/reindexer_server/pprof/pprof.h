@@ -17,6 +17,7 @@ public:
 	int Growth(http::Context &ctx);
 	int CmdLine(http::Context &ctx);
 	int Symbol(http::Context &ctx);
+	int Locks(http::Context &ctx);
 
 protected:
 	string resolveSymbol(uintptr_t ptr);
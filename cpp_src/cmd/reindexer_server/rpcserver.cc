@@ -374,6 +374,32 @@ Error RPCServer::EnumMeta(cproto::Context &ctx, p_string ns) {
 	return getDB(ctx, kRoleDataWrite)->EnumMeta(ns.toString(), keys);
 }
 
+Error RPCServer::GetMemStat(cproto::Context &ctx, p_string ns) {
+	NamespaceMemStat stat;
+	auto err = getDB(ctx, kRoleDataRead)->GetMemStat(ns.toString(), stat);
+	if (!err.ok()) {
+		return err;
+	}
+
+	WrSerializer wrSer;
+	stat.GetJSON(wrSer);
+	Slice slData(reinterpret_cast<char *>(wrSer.Buf()), wrSer.Len());
+	ctx.Return({cproto::Arg(p_string(&slData))});
+	return 0;
+}
+
+void RPCServer::GetMetrics(WrSerializer &ser) {
+	vector<string> labels;
+	auto counters = dispatcher.GetMetrics(labels);
+	net::RequestMetrics::GetPrometheus(ser, "reindexer_rpc_request", counters, labels);
+	if (listener_) {
+		ser.PutChars("# TYPE reindexer_rpc_connections gauge\n");
+		ser.Printf("reindexer_rpc_connections %llu\n", static_cast<unsigned long long>(listener_->ActiveConnections()));
+		ser.PutChars("# TYPE reindexer_rpc_connections_accepted_total counter\n");
+		ser.Printf("reindexer_rpc_connections_accepted_total %llu\n", static_cast<unsigned long long>(listener_->AcceptedConnections()));
+	}
+}
+
 bool RPCServer::Start(const string &addr, ev::dynamic_loop &loop) {
 	dispatcher.Register(cproto::kCmdPing, this, &RPCServer::Ping);
 	dispatcher.Register(cproto::kCmdLogin, this, &RPCServer::Login);
@@ -400,6 +426,8 @@ bool RPCServer::Start(const string &addr, ev::dynamic_loop &loop) {
 	dispatcher.Register(cproto::kCmdGetMeta, this, &RPCServer::GetMeta);
 	dispatcher.Register(cproto::kCmdPutMeta, this, &RPCServer::PutMeta);
 	dispatcher.Register(cproto::kCmdEnumMeta, this, &RPCServer::EnumMeta);
+
+	dispatcher.Register(cproto::kCmdGetMemStat, this, &RPCServer::GetMemStat);
 	dispatcher.Middleware(this, &RPCServer::CheckAuth);
 	dispatcher.OnClose(this, &RPCServer::OnClose);
 
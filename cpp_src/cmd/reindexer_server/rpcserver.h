@@ -30,6 +30,9 @@ public:
 
 	bool Start(const string &addr, ev::dynamic_loop &loop);
 	void Stop() { listener_->Stop(); }
+	/// Put metrics of RPC calls and connections in prometheus text format
+	/// @param ser - output serializer
+	void GetMetrics(WrSerializer &ser);
 
 	Error Ping(cproto::Context &ctx);
 	Error Login(cproto::Context &ctx, p_string login, p_string password, p_string db);
@@ -59,6 +62,8 @@ public:
 	Error PutMeta(cproto::Context &ctx, p_string ns, p_string key, p_string data);
 	Error EnumMeta(cproto::Context &ctx, p_string ns);
 
+	Error GetMemStat(cproto::Context &ctx, p_string ns);
+
 	Error CheckAuth(cproto::Context &ctx);
 	void Logger(cproto::Context &ctx, const Error &err, const cproto::Args &ret);
 	void OnClose(cproto::Context &ctx, const Error &err);
@@ -1,17 +1,43 @@
 #include "core/aggregator.h"
+#include <algorithm>
+#include <cmath>
 #include "core/payload/payloadiface.h"
 
 namespace reindexer {
 
-Aggregator::Aggregator(KeyValueType type, bool isArray, void *rawData, AggType aggType)
-	: type_(type), isArray_(isArray), rawData_(static_cast<uint8_t *>(rawData)), aggType_(aggType) {}
+Aggregator::Aggregator(KeyValueType type, bool isArray, void *rawData, AggType aggType, unsigned limit)
+	: type_(type), isArray_(isArray), rawData_(static_cast<uint8_t *>(rawData)), aggType_(aggType), limit_(limit) {}
 
 void Aggregator::Bind(PayloadType type, int field) {
 	offset_ = type->Field(field).Offset();
 	sizeof_ = type->Field(field).ElemSizeof();
+	payloadType_ = type;
+	field_ = field;
 }
 
 void Aggregator::Aggregate(const PayloadValue &data, int idx) {
+	if (aggType_ == AggCount) {
+		if (!isArray_) {
+			hitCount_++;
+			return;
+		}
+		hitCount_ += reinterpret_cast<PayloadFieldValue::Array *>(data.Ptr() + offset_)->len;
+		return;
+	}
+
+	if (!IsNumeric(aggType_)) {
+		KeyRefs krefs;
+		ConstPayload(payloadType_, data).Get(field_, krefs);
+		for (auto it = krefs.begin(); it != krefs.end(); ++it) {
+			// Facet counts items, so value repeated in array of the same item is counted once
+			if (aggType_ == AggFacet && std::find_if(krefs.begin(), it, [&it](const KeyRef &kr) { return EqualKeyRef()(kr, *it); }) != it) {
+				continue;
+			}
+			aggregate(*it);
+		}
+		return;
+	}
+
 	if (rawData_) {
 		aggregate(rawData_ + idx * sizeof_);
 		return;
@@ -28,4 +54,160 @@ void Aggregator::Aggregate(const PayloadValue &data, int idx) {
 	for (int i = 0; i < arr->len; i++, ptr += sizeof_) aggregate(ptr);
 }
 
+void Aggregator::AggregateBatch(const IdType *ids, size_t count, const vector<PayloadValue> &items) {
+	if (!count) return;
+	if (aggType_ == AggCount && !isArray_) {
+		hitCount_ += count;
+		return;
+	}
+	if (!IsNumeric(aggType_) || isArray_) {
+		for (size_t i = 0; i < count; ++i) Aggregate(items[ids[i]], ids[i]);
+		return;
+	}
+	switch (type_) {
+		case KeyValueInt:
+			aggregateBatch<int>(ids, count, items);
+			break;
+		case KeyValueInt64:
+			aggregateBatch<int64_t>(ids, count, items);
+			break;
+		case KeyValueDouble:
+			aggregateBatch<double>(ids, count, items);
+			break;
+		default:
+			abort();
+	}
+}
+
+template <typename T>
+void Aggregator::aggregateBatch(const IdType *ids, size_t count, const vector<PayloadValue> &items) {
+	if (rawData_) {
+		const T *column = reinterpret_cast<const T *>(rawData_);
+		aggregateBatch<T>(ids, count, [column](IdType id) { return column[id]; });
+	} else {
+		size_t offset = offset_;
+		aggregateBatch<T>(ids, count, [&items, offset](IdType id) { return *reinterpret_cast<const T *>(items[id].Ptr() + offset); });
+	}
+}
+
+template <typename T, typename Getter>
+void Aggregator::aggregateBatch(const IdType *ids, size_t count, const Getter &get) {
+	switch (aggType_) {
+		case AggSum:
+		case AggAvg:
+			sumBatch(ids, count, get, std::is_integral<T>());
+			break;
+		case AggMin: {
+			T value = get(ids[0]);
+			for (size_t i = 1; i < count; ++i) value = std::min(value, get(ids[i]));
+			if (!hitCount_ || value < result_) result_ = value;
+			break;
+		}
+		case AggMax: {
+			T value = get(ids[0]);
+			for (size_t i = 1; i < count; ++i) value = std::max(value, get(ids[i]));
+			if (!hitCount_ || value > result_) result_ = value;
+			break;
+		}
+		default:
+			abort();
+	}
+	hitCount_ += count;
+}
+
+// Sums are accumulated in 4 independent lanes, so additions of neighbour values don't wait each other
+template <typename Getter>
+void Aggregator::sumBatch(const IdType *ids, size_t count, const Getter &get, std::true_type) {
+	int64_t sum[4] = {0, 0, 0, 0};
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		sum[0] += get(ids[i]);
+		sum[1] += get(ids[i + 1]);
+		sum[2] += get(ids[i + 2]);
+		sum[3] += get(ids[i + 3]);
+	}
+	for (; i < count; ++i) sum[0] += get(ids[i]);
+	intSum_ += sum[0] + sum[1] + sum[2] + sum[3];
+}
+
+template <typename Getter>
+void Aggregator::sumBatch(const IdType *ids, size_t count, const Getter &get, std::false_type) {
+	KahanSum sum[4];
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		sum[0].Add(double(get(ids[i])));
+		sum[1].Add(double(get(ids[i + 1])));
+		sum[2].Add(double(get(ids[i + 2])));
+		sum[3].Add(double(get(ids[i + 3])));
+	}
+	for (; i < count; ++i) sum[0].Add(double(get(ids[i])));
+	for (auto &s : sum) doubleSum_.Add(s);
+}
+
+void Aggregator::aggregate(const KeyRef &kr) {
+	hitCount_++;
+	if (aggType_ == AggCountDistinctApprox) {
+		if (!hll_) hll_ = std::make_shared<HyperLogLog>();
+		hll_->Add(kr.Hash());
+		return;
+	}
+	distinct_[kr]++;
+}
+
+double Aggregator::GetResult() const {
+	switch (aggType_) {
+		case AggAvg:
+			return hitCount_ == 0 ? 0 : ((double(intSum_) + doubleSum_.Result()) / hitCount_);
+		case AggSum:
+			return (double(intSum_) + doubleSum_.Result()) * scale_;
+		case AggMin:
+		case AggMax:
+			return result_;
+		case AggCount:
+			return std::round(hitCount_ * scale_);
+		case AggFacet:
+		case AggCountDistinct:
+			return distinct_.size();
+		case AggCountDistinctApprox:
+			return hll_ ? std::round(hll_->Estimate()) : 0;
+		default:
+			abort();
+	}
+}
+
+double Aggregator::GetMeanResult(size_t count) const {
+	if (aggType_ == AggAvg) return GetResult();
+	return count ? GetResult() / count : 0;
+}
+
+void Aggregator::Merge(const Aggregator &other) {
+	if (other.hitCount_ && (aggType_ == AggMin || aggType_ == AggMax)) {
+		if (!hitCount_ || (aggType_ == AggMin ? other.result_ < result_ : other.result_ > result_)) result_ = other.result_;
+	}
+	intSum_ += other.intSum_;
+	doubleSum_.Add(other.doubleSum_);
+	hitCount_ += other.hitCount_;
+}
+
+vector<FacetResult> Aggregator::GetFacets() const {
+	vector<FacetResult> ret;
+	if (aggType_ != AggFacet) return ret;
+
+	vector<std::pair<KeyRef, int>> facets;
+	facets.reserve(distinct_.size());
+	for (auto it = distinct_.begin(); it != distinct_.end(); ++it) facets.push_back({it.key(), it.value()});
+	auto less = [](const std::pair<KeyRef, int> &lhs, const std::pair<KeyRef, int> &rhs) {
+		return lhs.second == rhs.second ? lhs.first < rhs.first : lhs.second > rhs.second;
+	};
+	if (limit_ < facets.size()) {
+		std::partial_sort(facets.begin(), facets.begin() + limit_, facets.end(), less);
+		facets.resize(limit_);
+	} else {
+		std::sort(facets.begin(), facets.end(), less);
+	}
+	ret.reserve(facets.size());
+	for (auto &f : facets) ret.push_back({f.first.As<string>(), f.second});
+	return ret;
+}
+
 }  // namespace reindexer
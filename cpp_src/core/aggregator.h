@@ -1,55 +1,156 @@
 #pragma once
 
+#include <climits>
+#include <cmath>
+#include <type_traits>
 #include "core/keyvalue/keyvalue.h"
 #include "core/payload/payloadiface.h"
 #include "core/type_consts.h"
+#include "estl/fast_hash_map.h"
+#include "tools/hyperloglog.h"
 
 namespace reindexer {
 
+// Value of field and count of items with it
+struct FacetResult {
+	FacetResult(const string &v, int c) : value(v), count(c) {}
+	string value;
+	int count;
+};
+
+// Results of aggregations by groups in columnar layout: values of group i are i-th elements of all columns
+struct GroupedResults {
+	// Fields of GROUP BY and columns of their values
+	h_vector<string, 1> fields;
+	vector<vector<KeyValue>> keys;
+	// Aggregations and columns of their values
+	vector<AggType> aggTypes;
+	vector<string> aggFields;
+	vector<vector<double>> values;
+	// Column of counts of items in groups
+	vector<int> counts;
+};
+
 class Aggregator {
 public:
-	Aggregator(KeyValueType type, bool isArray, void *rawData, AggType aggType);
+	Aggregator(KeyValueType type, bool isArray, void *rawData, AggType aggType, unsigned limit = UINT_MAX);
 	Aggregator(){};
 	~Aggregator(){};
 	void Aggregate(const PayloadValue &lhs, int idx);
+	// Aggregate items by ids. Numeric aggregations of non array fields are calculated by typed loops over
+	// values of field in column of index or at fixed offset of payloads, without dispatch by type for each value
+	void AggregateBatch(const IdType *ids, size_t count, const vector<PayloadValue> &items);
 	void Bind(PayloadType type, int field);
-	double GetResult() const {
-		switch (aggType_) {
-			case AggAvg:
-				return hitCount_ == 0 ? 0 : (result_ / hitCount_);
-			case AggSum:
-				return result_;
-			default:
-				abort();
-		}
+	// Add count of items with value of FACET, counted without payloads. Key must be valid until GetFacets
+	void AggregateFacet(const KeyRef &key, int count) {
+		hitCount_ += count;
+		distinct_[key] += count;
 	}
+	// Value of aggregation. For FACET it is count of distinct values
+	double GetResult() const;
+	// Values of FACET with biggest counts, ordered by count desc, then by value
+	vector<FacetResult> GetFacets() const;
+
+	// SUM, AVG and COUNT of all items could be estimated by sample of items
+	bool CanExtrapolate() const { return aggType_ == AggSum || aggType_ == AggAvg || aggType_ == AggCount; }
+	// Result per item of sample of count items. Spread of it between samples estimates error of extrapolation
+	double GetMeanResult(size_t count) const;
+	// Add values, aggregated by other aggregator of the same field and type
+	void Merge(const Aggregator &other);
+	// Scale SUM and COUNT of sample to all items
+	void Extrapolate(double factor) { scale_ = factor; }
+
+	// Aggregations, which are calculated over numeric value of field
+	static bool IsNumeric(AggType aggType) { return aggType == AggSum || aggType == AggAvg || aggType == AggMin || aggType == AggMax; }
 
 protected:
+	struct HashKeyRef {
+		size_t operator()(const KeyRef &kr) const { return kr.Hash(); }
+	};
+	struct EqualKeyRef {
+		bool operator()(const KeyRef &lhs, const KeyRef &rhs) const { return lhs.Type() == rhs.Type() && lhs == rhs; }
+	};
+
+	// Sum of doubles with Kahan-Neumaier compensation of rounding errors
+	struct KahanSum {
+		void Add(double v) {
+			double t = sum + v;
+			comp += (std::abs(sum) >= std::abs(v)) ? (sum - t) + v : (v - t) + sum;
+			sum = t;
+		}
+		void Add(const KahanSum &other) {
+			Add(other.sum);
+			comp += other.comp;
+		}
+		double Result() const { return sum + comp; }
+		double sum = 0, comp = 0;
+	};
+
 	void aggregate(void *ptr) {
-		hitCount_++;
 		switch (type_) {
 			case KeyValueInt:
-				result_ += *static_cast<int *>(ptr);
+				aggregateValue(*static_cast<int *>(ptr));
 				break;
 			case KeyValueInt64:
-				result_ += *static_cast<int64_t *>(ptr);
+				aggregateValue(*static_cast<int64_t *>(ptr));
 				break;
 			case KeyValueDouble:
-				result_ += *static_cast<double *>(ptr);
+				aggregateValue(*static_cast<double *>(ptr));
 				break;
 			default:
 				abort();
 		}
 	}
+	template <typename T>
+	void aggregateValue(T value) {
+		switch (aggType_) {
+			case AggMin:
+				if (!hitCount_ || value < result_) result_ = value;
+				break;
+			case AggMax:
+				if (!hitCount_ || value > result_) result_ = value;
+				break;
+			default:
+				addToSum(value);
+		}
+		hitCount_++;
+	}
+	void addToSum(int value) { intSum_ += value; }
+	void addToSum(int64_t value) { intSum_ += value; }
+	void addToSum(double value) { doubleSum_.Add(value); }
+
+	template <typename T>
+	void aggregateBatch(const IdType *ids, size_t count, const vector<PayloadValue> &items);
+	template <typename T, typename Getter>
+	void aggregateBatch(const IdType *ids, size_t count, const Getter &get);
+	template <typename Getter>
+	void sumBatch(const IdType *ids, size_t count, const Getter &get, std::true_type isIntegral);
+	template <typename Getter>
+	void sumBatch(const IdType *ids, size_t count, const Getter &get, std::false_type isIntegral);
+	void aggregate(const KeyRef &kr);
 
 	KeyValueType type_ = KeyValueUndefined;
 	size_t offset_ = 0;
 	size_t sizeof_ = 0;
 	bool isArray_ = false;
 	uint8_t *rawData_ = nullptr;
+	// Value of MIN and MAX
 	double result_ = 0;
+	// Exact sum of integer values. Sum of int64 values must fit to int64
+	int64_t intSum_ = 0;
+	KahanSum doubleSum_;
+	// Ratio of count of all items to count of aggregated sample
+	double scale_ = 1.0;
 	int hitCount_ = 0;
 	AggType aggType_;
+	unsigned limit_ = UINT_MAX;
+	// Payload field is needed for non numeric aggregations
+	PayloadType payloadType_;
+	int field_ = -1;
+	// Counts of values for FACET and COUNT DISTINCT. Values reference strings in payloads, so they are valid only under namespace lock
+	fast_hash_map<KeyRef, int, HashKeyRef, EqualKeyRef> distinct_;
+	// Created on first value, so copies of unused aggregator don't share it
+	std::shared_ptr<HyperLogLog> hll_;
 };
 
 }  // namespace reindexer
@@ -0,0 +1,40 @@
+#include "cachestats.h"
+#include "tools/serializer.h"
+
+namespace reindexer {
+
+void LRUCacheStats::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"hits\":%zu,", hits);
+	ser.Printf("\"misses\":%zu,", misses);
+	ser.Printf("\"evictions\":%zu,", evictions);
+	ser.Printf("\"items_count\":%zu,", items);
+	ser.Printf("\"total_size\":%zu", totalSize);
+	ser.PutChar('}');
+}
+
+size_t NamespaceCacheStats::TotalSize() const {
+	size_t size = queryCache.totalSize + resultsCache.totalSize;
+	for (auto &idx : indexes) size += idx.cache.totalSize;
+	return size;
+}
+
+void NamespaceCacheStats::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"name\":\"%s\",", name.c_str());
+	ser.Printf("\"total_size\":%zu,", TotalSize());
+	ser.PutChars("\"query_cache\":");
+	queryCache.GetJSON(ser);
+	ser.PutChars(",\"query_results_cache\":");
+	resultsCache.GetJSON(ser);
+	ser.PutChars(",\"indexes\":[");
+	for (size_t i = 0; i < indexes.size(); i++) {
+		if (i != 0) ser.PutChar(',');
+		ser.Printf("{\"name\":\"%s\",\"cache\":", indexes[i].name.c_str());
+		indexes[i].cache.GetJSON(ser);
+		ser.PutChar('}');
+	}
+	ser.PutChars("]}");
+}
+
+}  // namespace reindexer
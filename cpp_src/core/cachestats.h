@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace reindexer {
+
+class WrSerializer;
+
+struct LRUCacheStats {
+	void GetJSON(WrSerializer &ser) const;
+
+	size_t hits = 0;
+	size_t misses = 0;
+	size_t evictions = 0;
+	size_t items = 0;
+	size_t totalSize = 0;
+};
+
+struct IndexCacheStats {
+	std::string name;
+	LRUCacheStats cache;
+};
+
+// Stats of all caches of namespace
+struct NamespaceCacheStats {
+	void GetJSON(WrSerializer &ser) const;
+	size_t TotalSize() const;
+
+	std::string name;
+	std::vector<IndexCacheStats> indexes;
+	LRUCacheStats queryCache;
+	LRUCacheStats resultsCache;
+};
+
+}  // namespace reindexer
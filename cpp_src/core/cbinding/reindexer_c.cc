@@ -225,6 +225,20 @@ reindexer_ret reindexer_get_meta(reindexer_string ns, reindexer_string key) {
 	return ret2c(res, out);
 }
 
+reindexer_ret reindexer_get_memstat(reindexer_string ns) {
+	reindexer_buffer out{0, 0, nullptr};
+	Error res = err_not_init;
+	if (db) {
+		WrSerializer wrSer(false);
+		NamespaceMemStat stat;
+		res = db->GetMemStat(str2c(ns), stat);
+		if (res.ok()) stat.GetJSON(wrSer);
+		out.len = wrSer.Len();
+		out.data = wrSer.DetachBuffer();
+	}
+	return ret2c(res, out);
+}
+
 reindexer_error reindexer_commit(reindexer_string _namespace) { return error2c(!db ? err_not_init : db->Commit(str2c(_namespace))); }
 
 void reindexer_enable_logger(void (*logWriter)(int, char *)) { logInstallWriter(logWriter); }
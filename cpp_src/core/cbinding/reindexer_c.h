@@ -37,6 +37,7 @@ reindexer_error reindexer_commit(reindexer_string _namespace);
 
 reindexer_error reindexer_put_meta(reindexer_string ns, reindexer_string key, reindexer_string data);
 reindexer_ret reindexer_get_meta(reindexer_string ns, reindexer_string key);
+reindexer_ret reindexer_get_memstat(reindexer_string ns);
 
 reindexer_error reindexer_reset_stats();
 reindexer_stat reindexer_get_stats();
@@ -52,13 +52,28 @@ void ResultSerializer::putQueryParams(const QueryResults* results) {
 void ResultSerializer::putAggregationParams(const QueryResults* results) {
 	PutVarUint(results->aggregationResults.size());
 	for (auto ar : results->aggregationResults) PutDouble(ar);
+	if (opts_.flags & kResultsWithGroups) putGroupedResults(results);
 }
 
-void ResultSerializer::putItemParams(const QueryResults* result, int idx, bool useOffset) {
-	int ridx = idx + (useOffset ? opts_.fetchOffset : 0);
-
-	auto& it = result->at(ridx);
+void ResultSerializer::putGroupedResults(const QueryResults* results) {
+	// Groups are serialized by columns: keys of each field, then values of each aggregation, then counts
+	auto& groups = results->groupedResults;
+	PutVarUint(groups.counts.size());
+	PutVarUint(groups.fields.size());
+	for (size_t f = 0; f < groups.fields.size(); ++f) {
+		PutVString(groups.fields[f]);
+		for (auto& key : groups.keys[f]) PutValue(key);
+	}
+	PutVarUint(groups.aggTypes.size());
+	for (size_t a = 0; a < groups.aggTypes.size(); ++a) {
+		PutVarUint(groups.aggTypes[a]);
+		PutVString(groups.aggFields[a]);
+		for (auto v : groups.values[a]) PutDouble(v);
+	}
+	for (auto c : groups.counts) PutVarUint(c);
+}
 
+void ResultSerializer::putItemParams(const QueryResults* result, const ItemRef& it, int idx) {
 	PutVarUint(it.id);
 	PutVarUint(it.version);
 	PutVarUint(it.nsid);
@@ -73,10 +88,10 @@ void ResultSerializer::putItemParams(const QueryResults* result, int idx, bool u
 
 	switch (format) {
 		case kResultsWithJson:
-			result->GetJSON(ridx, *this);
+			result->GetJSON(it, *this);
 			break;
 		case kResultsWithCJson:
-			result->GetCJSON(ridx, *this);
+			result->GetCJSON(it, *this);
 			break;
 		case kResultsWithPtrs:
 			PutUInt64(uintptr_t(it.value.Ptr()));
@@ -121,26 +136,22 @@ bool ResultSerializer::PutResults(const QueryResults* result) {
 	putQueryParams(result);
 
 	for (unsigned i = 0; i < opts_.fetchLimit; i++) {
+		auto& it = result->at(i + opts_.fetchOffset);
 		// Put Item ID and version
-		putItemParams(result, i, true);
+		putItemParams(result, it, i);
 
-		if (!result->joined_ || (opts_.flags & 0x3) == kResultsWithJson) {
-			PutVarUint(0);
-			continue;
-		}
-		auto& it = result->at(i + opts_.fetchOffset);
-		auto jres = result->joined_->find(it.id);
-		if (jres == result->joined_->end()) {
+		if (!result->joined_ || (opts_.flags & 0x3) == kResultsWithJson || !result->joined_->Has(it.id)) {
 			PutVarUint(0);
 			continue;
 		}
 		// Put count of joined subqueires for item ID
-		PutVarUint(jres->second.size());
-		for (auto& jfres : jres->second) {
+		PutVarUint(result->joined_->JoinedQueries());
+		for (int jq = 0; jq < result->joined_->JoinedQueries(); jq++) {
+			auto jres = result->joined_->Get(it.id, jq);
 			// Put count of returned items from joined namespace
-			PutVarUint(jfres.size());
-			for (unsigned j = 0; j < jfres.size(); j++) {
-				putItemParams(&jfres, j, false);
+			PutVarUint(jres.size());
+			for (unsigned j = 0; j < jres.size(); j++) {
+				putItemParams(result, jres[j], j);
 			}
 		}
 	}
@@ -3,6 +3,7 @@
 namespace reindexer {
 
 class QueryResults;
+struct ItemRef;
 
 struct ResultFetchOpts {
 	int flags;
@@ -20,8 +21,9 @@ public:
 
 private:
 	void putQueryParams(const QueryResults* query);
-	void putItemParams(const QueryResults* result, int idx, bool useOffset);
+	void putItemParams(const QueryResults* result, const ItemRef& it, int idx);
 	void putAggregationParams(const QueryResults* query);
+	void putGroupedResults(const QueryResults* results);
 	void putPayloadType(const QueryResults* results, int nsId);
 	ResultFetchOpts opts_;
 };
@@ -18,8 +18,13 @@ Comparator::Comparator(CondType cond, KeyValueType type, const KeyValues &values
 	  cmpComposite(payloadType_, fields_) {
 	if (type == KeyValueComposite) {
 		assert(fields_.size() > 0);
+		for (auto field : fields_) compositeArrays_ = compositeArrays_ || payloadType_->Field(field).IsArray();
 	}
 	setValues(values);
+	if (cond == CondDWithin || cond == CondBox) {
+		if (type != KeyValueDouble || !isArray) throw Error(errQueryExec, "Geo conditions can be applied only to point fields");
+		geoArea_ = GeoArea(cond, cmpDouble.values_.data(), cmpDouble.values_.size());
+	}
 }
 
 void Comparator::setValues(const KeyValues &values) {
@@ -55,7 +60,13 @@ bool Comparator::Compare(const PayloadValue &data, int idx) {
 	if (rawData_) return compare(rawData_ + idx * sizeof_);
 
 	if (type_ == KeyValueComposite) {
-		return compare(&const_cast<PayloadValue &>(data));
+		if (!compositeArrays_) return compare(&const_cast<PayloadValue &>(data));
+		// Item with arrays matches, if any of it's composite keys matches
+		h_vector<PayloadValue, 1> keys;
+		ConstPayload(payloadType_, data).GetCompositeKeys(fields_, keys);
+		for (auto &key : keys)
+			if (compare(&key)) return true;
+		return false;
 	}
 
 	if (!isArray_) {
@@ -66,6 +77,11 @@ bool Comparator::Compare(const PayloadValue &data, int idx) {
 
 	if (cond_ == CondEmpty) return arr->len == 0;
 	if (cond_ == CondAny) return arr->len != 0;
+	if (cond_ == CondDWithin || cond_ == CondBox) {
+		if (arr->len != 2) return false;
+		const double *coords = reinterpret_cast<const double *>(data.Ptr() + arr->offset);
+		return geoArea_.Contains(GeoPoint{coords[0], coords[1]});
+	}
 
 	uint8_t *ptr = data.Ptr() + arr->offset;
 	for (int i = 0; i < arr->len; i++, ptr += sizeof_)
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <unordered_set>
+#include "core/geopoint.h"
 #include "core/index/payload_map.h"
 #include "core/indexopts.h"
 #include "core/keyvalue/keyvalue.h"
@@ -172,12 +173,15 @@ protected:
 	ComparatorImpl<int64_t> cmpInt64;
 	ComparatorImpl<double> cmpDouble;
 	ComparatorImpl<p_string> cmpString;
+	GeoArea geoArea_;
 
 	CondType cond_ = CondEq;
 	KeyValueType type_ = KeyValueUndefined;
 	size_t offset_ = 0;
 	size_t sizeof_ = 0;
 	bool isArray_ = false;
+	// Composite index contains array fields
+	bool compositeArrays_ = false;
 	uint8_t *rawData_ = nullptr;
 	CollateOpts collateOpts_;
 
@@ -7,12 +7,14 @@ namespace reindexer {
 struct FtIdSetCacheVal {
 	FtIdSetCacheVal() : ids(std::make_shared<IdSet>()) {}
 	FtIdSetCacheVal(const IdSet::Ptr &i) : ids(i) {}
-	FtIdSetCacheVal(const IdSet::Ptr &i, FtCtx::Data::Ptr c) : ids(i), ctx(c) {}
+	FtIdSetCacheVal(const IdSet::Ptr &i, FtCtx::Data::Ptr c, uint64_t gen = 0) : ids(i), ctx(c), generation(gen) {}
 
 	size_t Size() const { return ids->size() * sizeof(IdSet::value_type); }
 
 	IdSet::Ptr ids;
 	FtCtx::Data::Ptr ctx;
+	// Generation of index data, results were built for
+	uint64_t generation = 0;
 };
 
 class FtIdSetCache : public LRUCache<IdSetCacheKey, FtIdSetCacheVal, hash_idset_cache_key, equal_idset_cache_key> {};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+namespace reindexer {
+
+// Source of generations of data, which caches depend on. Generations grow monotonically within one counter.
+// Each counter, and each copy of it, takes unique epoch once from global counter, and then generations are
+// changed without shared atomic, so writes to different indexes and namespaces do not contend on common cache line.
+// Epochs are spaced by 2^32, so generations of different counters don't intersect until 2^32 changes of one counter.
+// Counter is changed under lock of owner's data, like the data itself.
+class GenerationCounter {
+public:
+	GenerationCounter() : last_(newEpoch()) {}
+	GenerationCounter(const GenerationCounter &) : last_(newEpoch()) {}
+	GenerationCounter &operator=(const GenerationCounter &) {
+		last_ = newEpoch();
+		return *this;
+	}
+
+	uint64_t Next() { return ++last_; }
+
+protected:
+	static uint64_t newEpoch() {
+		static std::atomic<uint64_t> lastEpoch(0);
+		return (lastEpoch.fetch_add(1, std::memory_order_relaxed) + 1) << 32;
+	}
+
+	uint64_t last_;
+};
+
+}  // namespace reindexer
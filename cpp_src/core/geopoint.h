@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include "core/type_consts.h"
+#include "tools/errors.h"
+
+namespace reindexer {
+
+// Point on the plane. Stored in payload as array of 2 double coordinates
+struct GeoPoint {
+	double x, y;
+};
+
+inline double GeoDistance(const GeoPoint &a, const GeoPoint &b) { return std::hypot(a.x - b.x, a.y - b.y); }
+
+// Area of the plane, described by arguments of geo condition:
+// CondDWithin - (x, y, distance): all points within distance from (x, y)
+// CondBox - (x1, y1, x2, y2): all points inside bounding box with corners (x1, y1) and (x2, y2)
+class GeoArea {
+public:
+	GeoArea() = default;
+	GeoArea(CondType cond, const double *args, size_t argsCount) : cond_(cond) {
+		switch (cond) {
+			case CondDWithin:
+				if (argsCount != 3)
+					throw Error(errParams, "Condition DWITHIN requires 3 arguments (x, y, distance), but %d provided", int(argsCount));
+				center_ = {args[0], args[1]};
+				radius_ = args[2];
+				min_ = {center_.x - radius_, center_.y - radius_};
+				max_ = {center_.x + radius_, center_.y + radius_};
+				break;
+			case CondBox:
+				if (argsCount != 4)
+					throw Error(errParams, "Condition BOX requires 4 arguments (x1, y1, x2, y2), but %d provided", int(argsCount));
+				min_ = {std::min(args[0], args[2]), std::min(args[1], args[3])};
+				max_ = {std::max(args[0], args[2]), std::max(args[1], args[3])};
+				break;
+			default:
+				throw Error(errParams, "Condition %d is not a geo condition", cond);
+		}
+	}
+
+	// Bounding box of area
+	const GeoPoint &Min() const { return min_; }
+	const GeoPoint &Max() const { return max_; }
+
+	bool Contains(const GeoPoint &p) const {
+		if (p.x < min_.x || p.x > max_.x || p.y < min_.y || p.y > max_.y) return false;
+		return cond_ == CondBox || GeoDistance(p, center_) <= radius_;
+	}
+
+	// Check if rectangle (lo, hi) is entirely inside area
+	bool Covers(const GeoPoint &lo, const GeoPoint &hi) const {
+		return Contains(lo) && Contains(hi) && Contains(GeoPoint{lo.x, hi.y}) && Contains(GeoPoint{hi.x, lo.y});
+	}
+
+protected:
+	CondType cond_ = CondBox;
+	GeoPoint min_{0, 0}, max_{0, 0};
+	GeoPoint center_{0, 0};
+	double radius_ = 0;
+};
+
+}  // namespace reindexer
@@ -68,6 +68,8 @@ public:
 	}
 	void Commit(const CommitContext &ctx);
 	bool IsCommited() { return true; }
+	size_t heap_size() const { return base_idset::heap_size(); }
+	size_t btree_size() const { return 0; }
 	string Dump();
 };
 
@@ -141,6 +143,7 @@ public:
 	}
 	void Commit(const CommitContext &ctx);
 	bool IsCommited() { return (!set_ || !set_->size() || size()) && std::is_sorted(begin(), end()); }
+	size_t btree_size() const { return set_ ? set_->bytes_used() : 0; }
 
 protected:
 	std::unique_ptr<base_idsetset> set_;
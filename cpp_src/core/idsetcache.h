@@ -25,10 +25,12 @@ struct IdSetCacheKey {
 
 struct IdSetCacheVal {
 	IdSetCacheVal() : ids(nullptr) {}
-	IdSetCacheVal(const IdSet::Ptr &i) : ids(i) {}
+	IdSetCacheVal(const IdSet::Ptr &i, uint64_t gen = 0) : ids(i), generation(gen) {}
 	size_t Size() const { return ids ? ids->size() * sizeof(IdSet::value_type) : 0; }
 
 	IdSet::Ptr ids;
+	// Generation of index data, idset was built for
+	uint64_t generation = 0;
 };
 
 struct equal_idset_cache_key {
@@ -1,6 +1,7 @@
 #include "index.h"
 #include "core/namespacedef.h"
 #include "indexordered.h"
+#include "indexgeo.h"
 #include "indextext/fastindextext.h"
 #include "indextext/fuzzyindextext.h"
 #include "tools/logger.h"
@@ -8,15 +9,41 @@
 namespace reindexer {
 
 Index::Index(IndexType type, const string& name, const IndexOpts& opts, const PayloadType payloadType, const FieldsSet& fields)
-	: type_(type), name_(name), opts_(opts), payloadType_(payloadType), fields_(fields) {
+	: type_(type),
+	  name_(name),
+	  opts_(opts),
+	  payloadType_(payloadType),
+	  fields_(fields),
+	  generation_(nextGeneration()),
+	  sortedGeneration_(generation_) {
 	IndexDef def;
 	def.FromType(type);
-	logPrintf(LogTrace, "Index::Index (%s,%s,%s)  %s%s%s", def.indexType.c_str(), def.fieldType.c_str(), name.c_str(),
-			  opts.IsPK() ? ",pk" : "", opts.IsDense() ? ",dense" : "", opts.IsArray() ? ",array" : "");
+	logPrintf(LogTrace, "Index::Index (%s,%s,%s)  %s%s%s%s", def.indexType.c_str(), def.fieldType.c_str(), name.c_str(),
+			  opts.IsPK() ? ",pk" : "", opts.IsDense() ? ",dense" : "", opts.IsArray() ? ",array" : "", opts.IsSparse() ? ",sparse" : "");
 }
 
 Index::~Index() {}
 
+void Index::UpsertKeys(KeyRefs& result, const KeyRefs& keys, IdType id) {
+	result.resize(0);
+	for (auto key : keys) result.push_back(Upsert(key, id));
+	// If no keys upsert empty value to index
+	if (keys.empty()) Upsert(KeyRef(), id);
+}
+
+void Index::DeleteKeys(const KeyRefs& keys, IdType id) {
+	for (auto key : keys) Delete(key, id);
+	// If no keys delete empty value from index
+	if (keys.empty()) Delete(KeyRef(), id);
+}
+
+IndexMemStat Index::MemStat() const {
+	IndexMemStat stat;
+	stat.name = name_;
+	stat.sortOrdersSize = sortOrders_.capacity() * sizeof(IdType);
+	return stat;
+}
+
 Index* Index::New(IndexType type, const string& name, const IndexOpts& opts, const PayloadType payloadType, const FieldsSet& fields) {
 	switch (type) {
 		case IndexStrBTree:
@@ -42,6 +69,8 @@ Index* Index::New(IndexType type, const string& name, const IndexOpts& opts, con
 		case IndexFuzzyFT:
 		case IndexCompositeFuzzyFT:
 			return FuzzyIndexText_New(type, name, opts, payloadType, fields);
+		case IndexPointGrid:
+			return IndexGeo_New(type, name, opts, payloadType, fields);
 		default:
 			throw Error(errParams, "Ivalid index type %d for index '%s'", type, name.c_str());
 	}
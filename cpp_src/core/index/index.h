@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <vector>
+#include "core/generation.h"
 #include "core/idset.h"
 #include "core/index/keyentry.h"
 #include "core/indexopts.h"
 #include "core/keyvalue/keyvalue.h"
+#include "core/lrucache.h"
+#include "core/memstat.h"
 #include "core/payload/payloadiface.h"
 #include "core/selectfunc/ctx/basefunctionctx.h"
 #include "core/selectkeyresult.h"
@@ -30,19 +35,32 @@ public:
 	virtual ~Index();
 	virtual KeyRef Upsert(const KeyRef& key, IdType id) = 0;
 	virtual void Delete(const KeyRef& key, IdType id) = 0;
+	// Upsert all keys of item's field to index. Keys, which should be stored in payload, are returned in result
+	virtual void UpsertKeys(KeyRefs& result, const KeyRefs& keys, IdType id);
+	// Delete all keys of item's field from index
+	virtual void DeleteKeys(const KeyRefs& keys, IdType id);
 	virtual void DumpKeys() = 0;
 	virtual IdSetRef Find(const KeyRef& key) = 0;
 
 	virtual SelectKeyResults SelectKey(const KeyValues& keys, CondType condition, SortType stype, ResultType res_type,
 									   BaseFunctionCtx::Ptr ctx) = 0;
 	virtual void Commit(const CommitContext& ctx) = 0;
+	// Call visit(key, ids) for each key of index with idset of items, which have this key.
+	// Returns false, if keys of index are not values of field, or index has no idsets by keys
+	virtual bool ForEachKey(const std::function<void(const KeyRef&, IdSetRef)>& /*visit*/) { return false; }
 	virtual void MakeSortOrders(UpdateSortedContext&) {}
+	// Contiguous column of field's values, indexed by item id. nullptr, if index doesn't store values by ids
+	virtual void* ColumnData() { return nullptr; }
 
 	virtual void UpdateSortedIds(const UpdateSortedContext& ctx) = 0;
 	virtual size_t Size() const { return 0; }
 	virtual Index* Clone() = 0;
 	virtual void Configure(const string&) {}
 	virtual bool IsOrdered() const { return false; }
+	// Statistics of index's selection results caches
+	virtual LRUCacheStats GetCacheStats() const { return LRUCacheStats(); }
+	// Memory, used by index data
+	virtual IndexMemStat MemStat() const;
 	void UpdatePayloadType(const PayloadType payloadType) { payloadType_ = payloadType; }
 
 	static Index* New(IndexType type, const string& name, const IndexOpts& opts, const PayloadType payloadType, const FieldsSet& fields_);
@@ -55,8 +73,16 @@ public:
 	const IndexOpts& Opts() const { return opts_; }
 	void SetOpts(const IndexOpts& opts) { opts_ = opts; }
 	SortType SortId() const { return sortId_; }
+	// Generation of index data. Changed on each modification of index, so caches can check, if data they depend on was changed
+	uint64_t Generation() const { return generation_; }
+	// Generation of sorted ids in index's idsets. Changed on each rebuild of sort orders
+	uint64_t SortedGeneration() const { return sortedGeneration_; }
 
 protected:
+	// Generations are taken from counter with unique epoch, so generation of new, recreated or cloned index never repeats previous ones
+	uint64_t nextGeneration() { return generations_.Next(); }
+	void bumpGeneration() { generation_ = nextGeneration(); }
+
 	// Index type. Can be one of enum IndexType
 	IndexType type_;
 	// Name of index (usualy name of field).
@@ -71,6 +97,9 @@ protected:
 	mutable PayloadType payloadType_;
 	// Fields in index. Valid only for composite indexes
 	FieldsSet fields_;
+	GenerationCounter generations_;
+	uint64_t generation_;
+	uint64_t sortedGeneration_;
 };
 
 }  // namespace reindexer
@@ -0,0 +1,148 @@
+#include "indexgeo.h"
+#include <climits>
+#include "tools/errors.h"
+#include "tools/jsontools.h"
+
+namespace reindexer {
+
+bool IndexGeo::fromKeys(const KeyRefs &keys, GeoPoint &p) const {
+	if (keys.size() != 2 || keys[0].Type() != KeyValueDouble || keys[1].Type() != KeyValueDouble) return false;
+	p = {static_cast<double>(keys[0]), static_cast<double>(keys[1])};
+	return !std::isnan(p.x) && !std::isnan(p.y);
+}
+
+int32_t IndexGeo::cellCoord(double v) const {
+	double c = std::floor(v / cellSize_);
+	return int32_t(std::max(std::min(c, double(INT_MAX)), double(INT_MIN)));
+}
+
+void IndexGeo::UpsertKeys(KeyRefs &result, const KeyRefs &keys, IdType id) {
+	result = keys;
+	if (id >= IdType(points_.size())) points_.resize(id + 1, GeoPoint{NAN, NAN});
+
+	GeoPoint p;
+	// Field without point or with wrong number of coordinates is indexed as empty
+	if (!fromKeys(keys, p)) {
+		points_[id] = {NAN, NAN};
+		Base::Upsert(KeyRef(), id);
+		return;
+	}
+	points_[id] = p;
+	Base::Upsert(KeyRef(cellKey(p)), id);
+}
+
+void IndexGeo::DeleteKeys(const KeyRefs &keys, IdType id) {
+	GeoPoint p;
+	if (!fromKeys(keys, p)) {
+		Base::Delete(KeyRef(), id);
+	} else {
+		Base::Delete(KeyRef(cellKey(p)), id);
+	}
+	if (id < IdType(points_.size())) points_[id] = {NAN, NAN};
+}
+
+void IndexGeo::selectCell(const GeoArea &area, int32_t cx, int32_t cy, const Index::KeyEntry &cell, SelectKeyResult &res,
+						  vector<IdType> &border) const {
+	GeoPoint lo{cx * cellSize_, cy * cellSize_}, hi{(cx + 1) * cellSize_, (cy + 1) * cellSize_};
+	// Whole cell is inside area - all it's points are matched
+	if (area.Covers(lo, hi)) {
+		res.push_back(SingleSelectKeyResult(cell.Sorted(0)));
+		return;
+	}
+	for (auto id : cell.Sorted(0)) {
+		if (area.Contains(points_[id])) border.push_back(id);
+	}
+}
+
+SelectKeyResults IndexGeo::SelectKey(const KeyValues &keys, CondType condition, SortType sortId, Index::ResultType res_type,
+									 BaseFunctionCtx::Ptr ctx) {
+	if (condition == CondAny || condition == CondEmpty) return Base::SelectKey(keys, condition, sortId, res_type, ctx);
+	if (condition != CondDWithin && condition != CondBox) {
+		throw Error(errQueryExec, "Condition %d is not supported by point index '%s'", condition, name_.c_str());
+	}
+
+	h_vector<double, 4> args;
+	for (auto key : keys) {
+		key.convert(KeyValueDouble);
+		args.push_back(static_cast<double>(key));
+	}
+	GeoArea area(condition, args.data(), args.size());
+
+	SelectKeyResult res;
+	// Points in cells are ordered by id. If another order is requested, just check coordinates of each item
+	if (res_type == Index::ForceComparator || (sortId && res_type != Index::ForceIdset)) {
+		res.comparators_.push_back(Comparator(condition, KeyValueDouble, keys, true, payloadType_, fields_));
+		return SelectKeyResults(res);
+	}
+	if (sortId) throw Error(errQueryExec, "Can't return sorted idset from point index '%s'", name_.c_str());
+
+	int32_t cx1 = cellCoord(area.Min().x), cx2 = cellCoord(area.Max().x);
+	int32_t cy1 = cellCoord(area.Min().y), cy2 = cellCoord(area.Max().y);
+	vector<IdType> border;
+
+	// Lookup each cell of area, or scan all non empty cells, if area is too large
+	double cellsCount = (double(cx2) - cx1 + 1) * (double(cy2) - cy1 + 1);
+	if (cellsCount <= idx_map.size()) {
+		for (int64_t cx = cx1; cx <= cx2; cx++) {
+			for (int64_t cy = cy1; cy <= cy2; cy++) {
+				auto it = idx_map.find(cellKey(int32_t(cx), int32_t(cy)));
+				if (it != idx_map.end()) selectCell(area, int32_t(cx), int32_t(cy), it->second, res, border);
+			}
+		}
+	} else {
+		for (auto &cell : idx_map) {
+			int32_t cx = int32_t(uint32_t(uint64_t(cell.first) >> 32)), cy = int32_t(uint32_t(cell.first));
+			if (cx >= cx1 && cx <= cx2 && cy >= cy1 && cy <= cy2) selectCell(area, cx, cy, cell.second, res, border);
+		}
+	}
+
+	if (!border.empty()) {
+		std::sort(border.begin(), border.end());
+		auto ids = std::make_shared<IdSet>();
+		ids->Append(border.begin(), border.end(), IdSet::Unordered);
+		res.push_back(SingleSelectKeyResult(ids));
+	}
+	return SelectKeyResults(res);
+}
+
+void IndexGeo::Configure(const string &config) {
+	string json = config;
+	JsonAllocator jalloc;
+	JsonValue jvalue;
+	char *endp;
+
+	if (jsonParse(&json[0], &endp, &jvalue, jalloc) != JSON_OK) {
+		throw Error(errParseJson, "Malformed JSON with config of point index '%s'", name_.c_str());
+	}
+
+	double cellSize = cellSize_;
+	for (auto elem : jvalue) {
+		if (elem->value.getTag() == JSON_NULL) continue;
+		parseJsonField("cell_size", cellSize, elem, 1e-9, 1e9);
+	}
+	if (cellSize == cellSize_) return;
+
+	// Rebuild cells with new size
+	cellSize_ = cellSize;
+	idx_map.clear();
+	for (IdType id = 0; id < IdType(points_.size()); id++) {
+		if (!std::isnan(points_[id].x)) idx_map[cellKey(points_[id])].Unsorted().Add(id, IdSet::Auto);
+	}
+	tracker_.completeUpdated_ = true;
+	tracker_.updated_.clear();
+}
+
+Index *IndexGeo::Clone() { return new IndexGeo(*this); }
+
+IndexMemStat IndexGeo::MemStat() const {
+	IndexMemStat stat = Base::MemStat();
+	stat.dataSize += points_.capacity() * sizeof(GeoPoint);
+	return stat;
+}
+
+Index *IndexGeo_New(IndexType type, const string &name, const IndexOpts &opts, const PayloadType /*payloadType*/,
+					const FieldsSet & /*fields*/) {
+	return new IndexGeo(type, name, opts);
+}
+
+}  // namespace reindexer
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "core/geopoint.h"
+#include "core/index/indexunordered.h"
+
+namespace reindexer {
+
+// Default size of grid cell
+const double kDefaultGridCellSize = 0.01;
+
+// Spatial index over point fields. The plane is split into square cells of equal size,
+// each cell keeps idset of points, which are inside it. Selects by DWITHIN and BOX
+// conditions scan cells, intersecting with requested area, and check exact coordinates
+// of points in cells on area's border.
+class IndexGeo : public IndexUnordered<unordered_map<int64_t, Index::KeyEntry>> {
+public:
+	using Base = IndexUnordered<unordered_map<int64_t, Index::KeyEntry>>;
+
+	IndexGeo(IndexType type, const string &name, const IndexOpts &opts) : Base(type, name, opts) {}
+
+	void UpsertKeys(KeyRefs &result, const KeyRefs &keys, IdType id) override;
+	void DeleteKeys(const KeyRefs &keys, IdType id) override;
+	SelectKeyResults SelectKey(const KeyValues &keys, CondType condition, SortType stype, Index::ResultType res_type,
+							   BaseFunctionCtx::Ptr ctx) override;
+	void Configure(const string &config) override;
+	// Keys of index are grid cells, not values of field
+	bool ForEachKey(const std::function<void(const KeyRef &, IdSetRef)> &) override { return false; }
+	Index *Clone() override;
+	IndexMemStat MemStat() const override;
+	KeyValueType KeyType() override { return KeyValueDouble; }
+
+protected:
+	int32_t cellCoord(double v) const;
+	int64_t cellKey(int32_t cx, int32_t cy) const { return int64_t((uint64_t(uint32_t(cx)) << 32) | uint32_t(cy)); }
+	int64_t cellKey(const GeoPoint &p) const { return cellKey(cellCoord(p.x), cellCoord(p.y)); }
+	bool fromKeys(const KeyRefs &keys, GeoPoint &p) const;
+	void selectCell(const GeoArea &area, int32_t cx, int32_t cy, const Index::KeyEntry &cell, SelectKeyResult &res,
+					vector<IdType> &border) const;
+
+	// Coordinates of points by item id. NaN for items without point
+	vector<GeoPoint> points_;
+	double cellSize_ = kDefaultGridCellSize;
+};
+
+Index *IndexGeo_New(IndexType type, const string &_name, const IndexOpts &opts, const PayloadType payloadType,
+					const FieldsSet &fields_);
+
+}  // namespace reindexer
@@ -7,8 +7,9 @@ namespace reindexer {
 
 template <typename T>
 KeyRef IndexOrdered<T>::Upsert(const KeyRef &key, IdType id) {
+	this->bumpGeneration();
 	if (key.Type() == KeyValueEmpty) {
-		this->empty_ids_.Unsorted().Add(id, IdSet::Auto);
+		if (!this->opts_.IsSparse()) this->empty_ids_.Unsorted().Add(id, IdSet::Auto);
 		// Return invalid ref
 		return KeyRef();
 	}
@@ -21,6 +21,7 @@ unordered_str_map<int>::iterator IndexStore<T>::find(const KeyRef & /*key*/) {
 
 template <>
 void IndexStore<key_string>::Delete(const KeyRef &key, IdType id) {
+	bumpGeneration();
 	if (key.Type() == KeyValueEmpty) return;
 	auto keyIt = find(key);
 	assertf(keyIt != str_map.end(), "Delete unexists key from index '%s' id=%d", name_.c_str(), id);
@@ -28,10 +29,13 @@ void IndexStore<key_string>::Delete(const KeyRef &key, IdType id) {
 	(void)id;
 }
 template <typename T>
-void IndexStore<T>::Delete(const KeyRef & /*key*/, IdType /* id */) {}
+void IndexStore<T>::Delete(const KeyRef & /*key*/, IdType /* id */) {
+	bumpGeneration();
+}
 
 template <>
 KeyRef IndexStore<key_string>::Upsert(const KeyRef &key, IdType /*id*/) {
+	bumpGeneration();
 	if (key.Type() == KeyValueEmpty) return KeyRef();
 
 	auto keyIt = find(key);
@@ -43,12 +47,15 @@ KeyRef IndexStore<key_string>::Upsert(const KeyRef &key, IdType /*id*/) {
 
 template <>
 KeyRef IndexStore<PayloadValue>::Upsert(const KeyRef &key, IdType /*id*/) {
+	bumpGeneration();
 	return KeyRef(key);
 }
 
 template <typename T>
 KeyRef IndexStore<T>::Upsert(const KeyRef &key, IdType id) {
-	if (!opts_.IsArray() && !opts_.IsDense()) {
+	bumpGeneration();
+	// Values of sparse index are mostly empty, so don't duplicate payload column. Comparator will read values from payload
+	if (!opts_.IsArray() && !opts_.IsDense() && !opts_.IsSparse()) {
 		idx_data.resize(std::max(id + 1, int(idx_data.size())));
 		idx_data[id] = static_cast<T>(key);
 	}
@@ -78,10 +85,19 @@ SelectKeyResults IndexStore<T>::SelectKey(const KeyValues &keys, CondType condit
 	}
 	SelectKeyResult res;
 	res.comparators_.push_back(Comparator(condition, KeyType(), keys, opts_.IsArray(), payloadType_, fields_,
-										  idx_data.size() ? idx_data.data() : nullptr, opts_.collateOpts_));
+										  ColumnData(), opts_.collateOpts_));
 	return SelectKeyResults(res);
 }
 
+template <typename T>
+IndexMemStat IndexStore<T>::MemStat() const {
+	IndexMemStat stat = Index::MemStat();
+	stat.uniqKeysCount = str_map.size();
+	stat.dataSize = mapHeapSize(str_map) + idx_data.capacity() * sizeof(T);
+	for (auto &keyIt : str_map) stat.dataSize += keyHeapSize(keyIt.first);
+	return stat;
+}
+
 template <typename T>
 Index *IndexStore<T>::Clone() {
 	return new IndexStore<T>(*this);
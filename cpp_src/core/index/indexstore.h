@@ -5,6 +5,28 @@
 
 namespace reindexer {
 
+// Heap memory, owned by key of index
+inline size_t keyHeapSize(const key_string &key) {
+	// Short strings are stored inside string object
+	const char *data = key->data(), *obj = reinterpret_cast<const char *>(key.get());
+	bool inplace = data >= obj && data < obj + sizeof(*key);
+	return sizeof(*key) + (inplace ? 0 : key->capacity() + 1);
+}
+template <typename T>
+inline size_t keyHeapSize(const T &) {
+	return 0;
+}
+
+// Heap memory of map's nodes and buckets, without memory owned by keys and values
+template <typename K, typename V, typename H, typename E, typename A>
+size_t mapHeapSize(const unordered_map<K, V, H, E, A> &m) {
+	return m.size() * (sizeof(typename unordered_map<K, V, H, E, A>::value_type) + 2 * sizeof(void *)) + m.bucket_count() * sizeof(void *);
+}
+template <typename K, typename V, typename C, typename A, int N>
+size_t mapHeapSize(const btree::btree_map<K, V, C, A, N> &m) {
+	return m.bytes_used();
+}
+
 template <typename T>
 class IndexStore : public Index {
 public:
@@ -18,10 +40,12 @@ public:
 	void Commit(const CommitContext &) override;
 	void UpdateSortedIds(const UpdateSortedContext & /*ctx*/) override {}
 	Index *Clone() override;
+	IndexMemStat MemStat() const override;
+	void *ColumnData() override { return idx_data.size() ? idx_data.data() : nullptr; }
 	IdSetRef Find(const KeyRef & /*key*/) override {
 		throw Error(errLogic, "IndexStore::Find of '%s' is not implemented. Do not use '-' index as pk?", this->name_.c_str());
 	}
-	KeyValueType KeyType() override final {
+	KeyValueType KeyType() override {
 		static T a;
 		return KeyRef(a).Type();
 	}
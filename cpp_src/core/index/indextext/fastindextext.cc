@@ -553,6 +553,15 @@ Index *FastIndexText<T>::Clone() {
 	return new FastIndexText<T>(*this);
 }
 
+template <typename T>
+IndexMemStat FastIndexText<T>::MemStat() const {
+	IndexMemStat stat = IndexText<T>::MemStat();
+	stat.fulltextSize += words_.capacity() * sizeof(PackedWordEntry) + typos_.heap_size() + suffixes_.heap_size() +
+						 avgWordsCount_.capacity() * sizeof(double);
+	for (auto &word : words_) stat.fulltextSize += word.vids_.heap_size();
+	return stat;
+}
+
 template <typename T>
 void FastIndexText<T>::Commit() {
 	words_.clear();
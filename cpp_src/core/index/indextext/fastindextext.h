@@ -22,6 +22,7 @@ public:
 		CreateConfig();
 	}
 	Index* Clone() override;
+	IndexMemStat MemStat() const override;
 	IdSet::Ptr Select(FtCtx::Ptr fctx, FtDSLQuery& dsl) override final;
 	void Commit() override final;
 
@@ -29,6 +29,14 @@ IndexText<T>::IndexText(const IndexText<T> &other) : IndexUnordered<T>(other), c
 	initSearchers();
 }
 
+template <typename T>
+IndexMemStat IndexText<T>::MemStat() const {
+	IndexMemStat stat = IndexUnordered<T>::MemStat();
+	stat.fulltextSize += vdocs_.capacity() * sizeof(VDocEntry);
+	for (auto &vdoc : vdocs_) stat.fulltextSize += vdoc.wordsCount.heap_size() + vdoc.mostFreqWordCount.heap_size();
+	return stat;
+}
+
 template <typename T>
 void IndexText<T>::initSearchers() {
 	searchers_.clear();
@@ -48,7 +56,8 @@ void IndexText<T>::initSearchers() {
 
 template <typename T>
 void IndexText<T>::Commit(const CommitContext &ctx) {
-	cache_ft_.reset(new FtIdSetCache());
+	// Cached results are not dropped on commit: they are checked against index generation on lookup
+	if (!cache_ft_) cache_ft_.reset(new FtIdSetCache());
 
 	IndexUnordered<T>::Commit(ctx);
 
@@ -104,10 +113,12 @@ SelectKeyResults IndexText<T>::SelectKey(const KeyValues &keys, CondType conditi
 	ftctx->PrepareAreas(ftFields_, this->name_);
 
 	bool need_put = false;
-	auto cache_ft = cache_ft_->Get(IdSetCacheKey{keys, condition, 0});
+	IdSetCacheKey ckey{keys, condition, 0};
+	auto cache_ft = cache_ft_->Get(ckey);
 	SelectKeyResult res;
 	if (cache_ft.key) {
-		if (!cache_ft.val.ids->size() || (ftctx->NeedArea() && !cache_ft.val.ctx->need_area_)) {
+		if (!cache_ft.val.ids->size() || cache_ft.val.generation != this->generation_ ||
+			(ftctx->NeedArea() && !cache_ft.val.ctx->need_area_)) {
 			need_put = true;
 		} else {
 			logPrintf(LogInfo, "Get search results for '%s' in '%s' from cache", keys[0].As<string>().c_str(),
@@ -130,7 +141,7 @@ SelectKeyResults IndexText<T>::SelectKey(const KeyValues &keys, CondType conditi
 	dsl.parse(keys[0].As<string>());
 	auto mergedIds = Select(ftctx, dsl);
 
-	if (need_put && mergedIds->size()) cache_ft_->Put(*cache_ft.key, FtIdSetCacheVal{mergedIds, ftctx->GetData()});
+	if (need_put && mergedIds->size()) cache_ft_->Put(ckey, FtIdSetCacheVal{mergedIds, ftctx->GetData(), this->generation_});
 
 	res.push_back(SingleSelectKeyResult(mergedIds));
 	SelectKeyResults r(res);
@@ -141,6 +152,8 @@ template <typename T>
 void IndexText<T>::Configure(const string &config) {
 	string config_nc = config;
 	cfg_->parse(&config_nc[0]);
+	// Search results depend on config
+	this->bumpGeneration();
 };
 
 template class IndexText<unordered_str_map<Index::KeyEntryPlain>>;
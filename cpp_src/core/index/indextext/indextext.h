@@ -44,8 +44,11 @@ public:
 	SelectKeyResults SelectKey(const KeyValues& keys, CondType condition, SortType stype, Index::ResultType res_type,
 							   BaseFunctionCtx::Ptr ctx) override final;
 	void Commit(const CommitContext& ctx) override final;
+	bool ForEachKey(const std::function<void(const KeyRef&, IdSetRef)>&) override final { return false; }
 	void UpdateSortedIds(const UpdateSortedContext&) override {}
 	void Configure(const string& config) override;
+	LRUCacheStats GetCacheStats() const override { return cache_ft_ ? cache_ft_->GetStats() : LRUCacheStats(); }
+	IndexMemStat MemStat() const override;
 	virtual IdSet::Ptr Select(FtCtx::Ptr fctx, FtDSLQuery& dsl) = 0;
 	virtual void Commit() = 0;
 
@@ -7,8 +7,10 @@ namespace reindexer {
 
 template <typename T>
 KeyRef IndexUnordered<T>::Upsert(const KeyRef &key, IdType id) {
+	this->bumpGeneration();
 	if (key.Type() == KeyValueEmpty) {
-		this->empty_ids_.Unsorted().Add(id, IdSet::Auto);
+		// Sparse index doesn't track empty values
+		if (!this->opts_.IsSparse()) this->empty_ids_.Unsorted().Add(id, IdSet::Auto);
 		// Return invalid ref
 		return KeyRef();
 	}
@@ -28,8 +30,10 @@ KeyRef IndexUnordered<T>::Upsert(const KeyRef &key, IdType id) {
 
 template <typename T>
 void IndexUnordered<T>::Delete(const KeyRef &key, IdType id) {
+	this->bumpGeneration();
 	int delcnt = 0;
 	if (key.Type() == KeyValueEmpty) {
+		if (this->opts_.IsSparse()) return;
 		delcnt = this->empty_ids_.Unsorted().Erase(id);
 		assert(delcnt);
 		return;
@@ -80,12 +84,15 @@ void IndexUnordered<T>::tryIdsetCache(const KeyValues &keys, CondType condition,
 		return;
 	}
 
-	auto cached = cache_->Get(IdSetCacheKey{keys, condition, sortId});
+	// Merged idset depends on index keys, and on sort orders, if it's sorted
+	uint64_t generation = sortId ? std::max(this->generation_, this->sortedGeneration_) : this->generation_;
+	IdSetCacheKey ckey{keys, condition, sortId};
+	auto cached = cache_->Get(ckey);
 
 	if (cached.key) {
-		if (!cached.val.ids) {
+		if (!cached.val.ids || cached.val.generation != generation) {
 			selector(res);
-			cache_->Put(*cached.key, res.mergeIdsets());
+			cache_->Put(ckey, IdSetCacheVal(res.mergeIdsets(), generation));
 		} else
 			res.push_back(SingleSelectKeyResult(cached.val.ids));
 	} else
@@ -103,6 +110,9 @@ SelectKeyResults IndexUnordered<T>::SelectKey(const KeyValues &keys, CondType co
 
 	switch (condition) {
 		case CondEmpty:
+			// Sparse index has no empty ids, so check arrays length by comparator
+			if (this->opts_.IsSparse() && this->opts_.IsArray())
+				return IndexStore<typename T::key_type>::SelectKey(keys, condition, sortId, res_type, ctx);
 			res.push_back(SingleSelectKeyResult(this->empty_ids_.Sorted(sortId)));
 			break;
 		case CondAny:
@@ -187,8 +197,8 @@ void IndexUnordered<T>::DumpKeys() {
 template <typename T>
 void IndexUnordered<T>::Commit(const CommitContext &ctx) {
 	if (ctx.phases() & CommitContext::MakeIdsets) {
-		// reset cache
-		if (!cache_ || !cache_->Empty()) cache_.reset(new IdSetCache());
+		// Cached idsets are not dropped on commit: they are checked against index generation on lookup
+		if (!cache_) cache_.reset(new IdSetCache());
 
 		logPrintf(LogTrace, "IndexUnordered::Commit (%s) %d uniq keys, %d empty, %s", this->name_.c_str(), this->idx_map.size(),
 				  this->empty_ids_.Unsorted().size(), tracker_.completeUpdated_ ? "complete" : "partial");
@@ -215,6 +225,8 @@ template <typename T>
 void IndexUnordered<T>::UpdateSortedIds(const UpdateSortedContext &ctx) {
 	logPrintf(LogTrace, "IndexUnordered::UpdateSortedIds (%s) %d uniq keys, %d empty", this->name_.c_str(), this->idx_map.size(),
 			  this->empty_ids_.Unsorted().size());
+	// Cached idsets, sorted by previous sort orders became invalid
+	this->sortedGeneration_ = this->nextGeneration();
 	// For all keys in index
 	for (auto &keyIt : this->idx_map) {
 		keyIt.second.UpdateSortedIds(ctx);
@@ -223,6 +235,31 @@ void IndexUnordered<T>::UpdateSortedIds(const UpdateSortedContext &ctx) {
 	this->empty_ids_.UpdateSortedIds(ctx);
 }
 
+template <typename T>
+bool IndexUnordered<T>::ForEachKey(const std::function<void(const KeyRef &, IdSetRef)> &visit) {
+	// Key of collated index joins different values of field
+	if (this->KeyType() == KeyValueString && this->opts_.GetCollateMode() != CollateNone) return false;
+
+	for (auto &keyIt : idx_map) visit(KeyRef(keyIt.first), IdSetRef(&keyIt.second.Unsorted()));
+	return true;
+}
+
+template <typename T>
+IndexMemStat IndexUnordered<T>::MemStat() const {
+	IndexMemStat stat = IndexStore<typename T::key_type>::MemStat();
+	stat.uniqKeysCount = idx_map.size();
+	stat.dataSize += mapHeapSize(idx_map);
+	for (auto &keyIt : idx_map) {
+		stat.dataSize += keyHeapSize(keyIt.first);
+		stat.idsetPlainSize += keyIt.second.ids_.heap_size();
+		stat.idsetBTreeSize += keyIt.second.ids_.btree_size();
+	}
+	stat.idsetPlainSize += empty_ids_.ids_.heap_size();
+	stat.idsetBTreeSize += empty_ids_.ids_.btree_size();
+	stat.idsetCache = GetCacheStats();
+	return stat;
+}
+
 template <typename T>
 Index *IndexUnordered<T>::Clone() {
 	return new IndexUnordered<T>(*this);
@@ -261,5 +298,6 @@ template class IndexUnordered<btree_map<int64_t, Index::KeyEntry>>;
 template class IndexUnordered<btree_map<double, Index::KeyEntry>>;
 template class IndexUnordered<str_map<Index::KeyEntry>>;
 template class IndexUnordered<payload_map<Index::KeyEntry>>;
+template class IndexUnordered<unordered_map<int64_t, Index::KeyEntry>>;
 
 }  // namespace reindexer
@@ -52,10 +52,13 @@ public:
 	SelectKeyResults SelectKey(const KeyValues &keys, CondType condition, SortType stype, Index::ResultType res_type,
 							   BaseFunctionCtx::Ptr ctx) override;
 	void Commit(const CommitContext &ctx) override;
+	bool ForEachKey(const std::function<void(const KeyRef &, IdSetRef)> &visit) override;
 	void UpdateSortedIds(const UpdateSortedContext &) override;
 	Index *Clone() override;
 	size_t Size() const override final { return idx_map.size(); }
 	IdSetRef Find(const KeyRef &key) override final;
+	LRUCacheStats GetCacheStats() const override { return cache_ ? cache_->GetStats() : LRUCacheStats(); }
+	IndexMemStat MemStat() const override;
 
 protected:
 	void tryIdsetCache(const KeyValues &keys, CondType condition, SortType sortId, std::function<void(SelectKeyResult &)> selector,
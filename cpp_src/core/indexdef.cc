@@ -17,6 +17,7 @@ struct IndexInfo {
 const vector<string> condsUsual = {"SET", "EQ", "ANY", "EMPTY", "LT", "LE", "GT", "GE", "RANGE"};
 const vector<string> condsText = {"MATCH"};
 const vector<string> condsBool = {"SET", "EQ", "ANY", "EMPTY"};
+const vector<string> condsGeo = {"DWITHIN", "BOX", "ANY", "EMPTY"};
 
 // clang-format off
 std::unordered_map<IndexType, IndexInfo,std::hash<int>,std::equal_to<int> > availableIndexes = {
@@ -39,6 +40,7 @@ std::unordered_map<IndexType, IndexInfo,std::hash<int>,std::equal_to<int> > avai
 	{IndexCompositeFuzzyFT, {"composite", "fuzzytext",condsText, CapComposite|CapFullText}},
 	{IndexFastFT,           {"string",    "text",    condsText, CapFullText}},
 	{IndexFuzzyFT,          {"string",    "fuzzytext", condsText, CapFullText}},
+	{IndexPointGrid,        {"point",     "grid",    condsGeo,  CapSortable}},
 };
 
 std::unordered_map<CollateMode, const string, std::hash<int>, std::equal_to<int> > availableCollates = {
@@ -57,6 +59,7 @@ IndexType IndexDef::Type() const {
 		if (fieldType == "double") iType = "tree";
 		if (fieldType != "double") iType = "hash";
 		if (fieldType == "bool") iType = "-";
+		if (fieldType == "point") iType = "grid";
 	}
 	for (auto &it : availableIndexes) {
 		if (fieldType == it.second.fieldType && iType == it.second.indexType) return it.first;
@@ -94,7 +97,7 @@ Error IndexDef::FromJSON(char *json) {
 Error IndexDef::FromJSON(JsonValue &jvalue) {
 	try {
 		CollateMode collateValue = CollateNone;
-		bool isPk = false, isArray = false, isDense = false, isAppendable = false;
+		bool isPk = false, isArray = false, isDense = false, isAppendable = false, isSparse = false;
 		for (auto elem : jvalue) {
 			parseJsonField("name", name, elem);
 			parseJsonField("json_path", jsonPath, elem);
@@ -104,6 +107,7 @@ Error IndexDef::FromJSON(JsonValue &jvalue) {
 			parseJsonField("is_array", isArray, elem);
 			parseJsonField("is_dense", isDense, elem);
 			parseJsonField("is_appendable", isAppendable, elem);
+			parseJsonField("is_sparse", isSparse, elem);
 
 			string collateStr;
 			parseJsonField("collate_mode", collateStr, elem);
@@ -129,7 +133,7 @@ Error IndexDef::FromJSON(JsonValue &jvalue) {
 				}
 			}
 		}
-		opts.PK(isPk).Array(isArray).Dense(isDense).Appendable(isAppendable);
+		opts.PK(isPk).Array(isArray).Dense(isDense).Appendable(isAppendable).Sparse(isSparse);
 	} catch (const Error &err) {
 		return err;
 	}
@@ -147,6 +151,7 @@ void IndexDef::GetJSON(WrSerializer &ser) {
 	ser.Printf("\"is_array\":%s,", opts.IsArray() ? "true" : "false");
 	ser.Printf("\"is_dense\":%s,", opts.IsDense() ? "true" : "false");
 	ser.Printf("\"is_appendable\":%s,", opts.IsAppendable() ? "true" : "false");
+	ser.Printf("\"is_sparse\":%s,", opts.IsSparse() ? "true" : "false");
 	ser.Printf("\"collate_mode\":\"%s\",", getCollateMode().c_str());
 	ser.Printf("\"sort_order_letters\":\"%s\"", opts.collateOpts_.sortOrderTable.GetSortOrderCharacters().c_str());
 	ser.PutChars("}");
@@ -18,6 +18,7 @@ bool IndexOpts::IsPK() const { return options & kIndexOptPK; }
 bool IndexOpts::IsArray() const { return options & kIndexOptArray; }
 bool IndexOpts::IsDense() const { return options & kIndexOptDense; }
 bool IndexOpts::IsAppendable() const { return options & kIndexOptAppendable; }
+bool IndexOpts::IsSparse() const { return options & kIndexOptSparse; }
 CollateMode IndexOpts::GetCollateMode() const { return static_cast<CollateMode>(collateOpts_.mode); }
 
 IndexOpts& IndexOpts::PK(bool value) {
@@ -40,6 +41,11 @@ IndexOpts& IndexOpts::Appendable(bool value) {
 	return *this;
 }
 
+IndexOpts& IndexOpts::Sparse(bool value) {
+	options = value ? options | kIndexOptSparse : options & ~(kIndexOptSparse);
+	return *this;
+}
+
 IndexOpts& IndexOpts::SetCollateMode(CollateMode mode) {
 	collateOpts_.mode = mode;
 	return *this;
@@ -23,11 +23,13 @@ struct IndexOpts {
 	bool IsArray() const;
 	bool IsDense() const;
 	bool IsAppendable() const;
+	bool IsSparse() const;
 
 	IndexOpts& PK(bool value = true);
 	IndexOpts& Array(bool value = true);
 	IndexOpts& Dense(bool value = true);
 	IndexOpts& Appendable(bool value = true);
+	IndexOpts& Sparse(bool value = true);
 	IndexOpts& SetCollateMode(CollateMode mode);
 	CollateMode GetCollateMode() const;
 
@@ -1,85 +1,243 @@
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <tuple>
 #include "core/ft/ftsetcashe.h"
 #include "core/idset.h"
 #include "core/idsetcache.h"
 #include "core/keyvalue/keyvalue.h"
 #include "core/query/querycache.h"
-#include "tools/logger.h"
 
 namespace reindexer {
 
 const size_t kElemSizeOverhead = 256;
 
+static int64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+CacheMemoryBudget &CacheMemoryBudget::Instance() {
+	// Never destroyed: caches can outlive static objects
+	static CacheMemoryBudget *budget = new CacheMemoryBudget;
+	return *budget;
+}
+
+void CacheMemoryBudget::SetLimit(size_t limit) {
+	limit_.store(limit, std::memory_order_relaxed);
+	Enforce();
+}
+
+void CacheMemoryBudget::Register(Client *client) {
+	std::lock_guard<mutex> lk(mtx_);
+	clients_.push_back(client);
+}
+
+void CacheMemoryBudget::Unregister(Client *client) {
+	std::lock_guard<mutex> lk(mtx_);
+	clients_.erase(std::remove(clients_.begin(), clients_.end(), client), clients_.end());
+}
+
+void CacheMemoryBudget::Enforce() {
+	size_t limit = Limit();
+	if (!limit || Used() <= limit) return;
+
+	// Only one thread evicts at time, others do not wait for it
+	std::unique_lock<mutex> lk(mtx_, std::try_to_lock);
+	if (!lk.owns_lock()) return;
+
+	// Free a bit more, than required, to not call eviction on each admission
+	size_t target = limit - limit / 16;
+	for (int pass = 0; pass < 4; pass++) {
+		size_t used = Used();
+		if (used <= target) break;
+		size_t excess = used - target, freed = 0;
+		for (auto client : clients_) {
+			size_t size = client->MemSize();
+			if (size) freed += client->Reclaim(std::max(size_t(1), size_t(double(excess) * size / used)));
+		}
+		if (!freed) break;
+	}
+}
+
 template <typename K, typename V, typename hash, typename equal>
-typename LRUCache<K, V, hash, equal>::Iterator LRUCache<K, V, hash, equal>::Get(const K &key) {
-	if (cacheSizeLimit_ == 0) return Iterator();
+LRUCache<K, V, hash, equal>::LRUCache(size_t sizeLimit, int hitCount) : cacheSizeLimit_(sizeLimit), hitCountToCache_(hitCount) {
+	for (auto &shard : shards_) shard.lock.set_name("lrucache");
+	CacheMemoryBudget::Instance().Register(this);
+}
 
-	std::lock_guard<mutex> lk(lock_);
+template <typename K, typename V, typename hash, typename equal>
+LRUCache<K, V, hash, equal>::~LRUCache() {
+	CacheMemoryBudget::Instance().Unregister(this);
+	CacheMemoryBudget::Instance().Charge(-int64_t(MemSize()));
+}
 
-	auto it = items_.find(key);
+template <typename K, typename V, typename hash, typename equal>
+int LRUCache<K, V, hash, equal>::FrequencySketch::Increment(size_t h) {
+	if (counters_.empty()) counters_.resize(kSketchWidth * kSketchRows, 0);
+	if (++additions_ >= 10 * kSketchWidth) {
+		for (auto &c : counters_) c >>= 1;
+		additions_ = 0;
+	}
+	int freq = std::numeric_limits<uint8_t>::max();
+	for (int row = 0; row < kSketchRows; row++, h = (h >> 13) | (h << (sizeof(h) * 8 - 13))) {
+		uint8_t &c = counters_[row * kSketchWidth + (h + row * 0x9E3779B9) % kSketchWidth];
+		if (c < std::numeric_limits<uint8_t>::max()) c++;
+		freq = std::min(freq, int(c));
+	}
+	return freq;
+}
 
-	if (it == items_.end()) {
-		it = items_.emplace(key, Entry{}).first;
-		totalCacheSize_ += kElemSizeOverhead;
-		it->second.lruPos = lru_.insert(lru_.end(), &it->first);
-	} else if (std::next(it->second.lruPos) != lru_.end()) {
-		lru_.splice(lru_.end(), lru_, it->second.lruPos, std::next(it->second.lruPos));
-		it->second.lruPos = std::prev(lru_.end());
+template <typename K, typename V, typename hash, typename equal>
+typename LRUCache<K, V, hash, equal>::Iterator LRUCache<K, V, hash, equal>::Get(const K &key) {
+	if (cacheSizeLimit_ == 0) return Iterator();
+
+	size_t h = hash()(key);
+	Shard &shard = shardOf(h);
+	{
+		shared_lock<profiled_shared_mutex> lk(shard.lock);
+		auto it = shard.items.find(key);
+		if (it != shard.items.end()) {
+			it->second.credit.store(it->second.weight, std::memory_order_relaxed);
+			it->second.lastAccess.store(nowNs(), std::memory_order_relaxed);
+			shard.hits.fetch_add(1, std::memory_order_relaxed);
+			return Iterator(&it->first, it->second.val);
+		}
 	}
-	if (++it->second.hitCount < hitCountToCache_) {
-		return Iterator();
+
+	shard.misses.fetch_add(1, std::memory_order_relaxed);
+	Iterator ret;
+	{
+		std::lock_guard<profiled_shared_mutex> lk(shard.lock);
+		auto it = shard.items.find(key);
+		if (it != shard.items.end()) return Iterator(&it->first, it->second.val);
+
+		if (shard.sketch.Increment(h) < hitCountToCache_) return Iterator();
+
+		// Key is requested often enough: admit it to cache. Room is made before insertion,
+		// so CLOCK hand can't pick the new entry, and returned key stays valid
+		size_t size = kElemSizeOverhead + V().Size(), limit = cacheSizeLimit_ / kShards;
+		evict(shard, limit > size ? limit - size : 0);
+		it = shard.items.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first;
+		it->second.lastAccess.store(nowNs(), std::memory_order_relaxed);
+		shard.ring.push_back(&*it);
+		shard.totalSize += size;
+		CacheMemoryBudget::Instance().Charge(size);
+		shard.count.fetch_add(1, std::memory_order_relaxed);
+		ret = Iterator(&it->first);
 	}
-	++getCount_;
+	CacheMemoryBudget::Instance().Enforce();
 
-	// logPrintf(LogInfo, "Cache::Get (cond=%d,sortId=%d,keys=%d), total in cache items=%d,size=%d", key.cond, key.sort,
-	// 		  (int)key.keys.size(), items_.size(), totalCacheSize_);
-	return Iterator(&it->first, it->second.val);
+	return ret;
 }
 
 template <typename K, typename V, typename hash, typename equal>
 void LRUCache<K, V, hash, equal>::Put(const K &key, const V &v) {
 	if (cacheSizeLimit_ == 0) return;
 
-	std::lock_guard<mutex> lk(lock_);
-	auto it = items_.find(key);
-	assert(it != items_.end());
-
-	totalCacheSize_ += v.Size() - it->second.val.Size();
-	it->second.val = v;
+	Shard &shard = shardOf(hash()(key));
+	{
+		std::lock_guard<profiled_shared_mutex> lk(shard.lock);
+		auto it = shard.items.find(key);
+		// Entry can be evicted by concurrent request after Get
+		if (it == shard.items.end()) return;
+
+		int64_t delta = int64_t(v.Size()) - int64_t(it->second.val.Size());
+		shard.totalSize += delta;
+		CacheMemoryBudget::Instance().Charge(delta);
+		it->second.val = v;
+		it->second.weight = weightOf(shard, it->second);
+		it->second.credit.store(it->second.weight, std::memory_order_relaxed);
+
+		evict(shard, cacheSizeLimit_ / kShards);
+	}
+	CacheMemoryBudget::Instance().Enforce();
+}
 
-	// logPrintf(LogInfo, "IdSetCache::Put () add %d,left %d,fwdCnt=%d,sz=%d", endIt - begIt, left, it->second.fwdCount,
-	// 		  it->second.ids->size());
-	++putCount_;
+template <typename K, typename V, typename hash, typename equal>
+uint8_t LRUCache<K, V, hash, equal>::weightOf(Shard &shard, const Entry &entry) {
+	// Value is calculated between Get and Put, so time since last access is cost of it's calculation
+	double cost = double(std::max(nowNs() - entry.lastAccess.load(std::memory_order_relaxed), int64_t(0))) /
+				  (kElemSizeOverhead + entry.val.Size());
+	if (shard.avgCost == 0) shard.avgCost = cost;
+	uint8_t weight = 2;
+	if (cost > 4 * shard.avgCost) {
+		weight = kMaxCredit;
+	} else if (cost * 4 < shard.avgCost) {
+		weight = 1;
+	}
+	shard.avgCost = shard.avgCost * 0.875 + cost * 0.125;
+	return weight;
+}
 
-	eraseLRU();
+template <typename K, typename V, typename hash, typename equal>
+size_t LRUCache<K, V, hash, equal>::evict(Shard &shard, size_t limit) {
+	size_t freed = 0;
+	while (shard.totalSize > limit && !shard.ring.empty()) {
+		if (shard.hand >= shard.ring.size()) shard.hand = 0;
+		auto *item = shard.ring[shard.hand];
+		// Give recently used entry another chance. Expensive entries have more chances
+		uint8_t credit = item->second.credit.load(std::memory_order_relaxed);
+		if (credit) {
+			item->second.credit.store(credit - 1, std::memory_order_relaxed);
+			shard.hand++;
+			continue;
+		}
+		size_t size = kElemSizeOverhead + item->second.val.Size();
+		shard.totalSize -= size;
+		freed += size;
+		shard.ring[shard.hand] = shard.ring.back();
+		shard.ring.pop_back();
+		shard.items.erase(item->first);
+		shard.count.fetch_sub(1, std::memory_order_relaxed);
+		shard.evictions.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (freed) CacheMemoryBudget::Instance().Charge(-int64_t(freed));
+	return freed;
 }
 
 template <typename K, typename V, typename hash, typename equal>
-void LRUCache<K, V, hash, equal>::eraseLRU() {
-	typename LRUList::iterator it = lru_.begin();
-
-	while (totalCacheSize_ > cacheSizeLimit_) {
-		assert(it != lru_.end());
-		auto mIt = items_.find(**it);
-		assert(mIt != items_.end());
-		totalCacheSize_ -= kElemSizeOverhead + mIt->second.val.Size();
-		items_.erase(mIt);
-		it = lru_.erase(it);
-		++eraseCount_;
+size_t LRUCache<K, V, hash, equal>::Reclaim(size_t bytes) {
+	size_t freed = 0, share = bytes / kShards + 1;
+	for (auto &shard : shards_) {
+		if (freed >= bytes) break;
+		std::lock_guard<profiled_shared_mutex> lk(shard.lock);
+		size_t size = shard.totalSize.load(std::memory_order_relaxed);
+		freed += evict(shard, size > share ? size - share : 0);
 	}
+	return freed;
+}
+
+template <typename K, typename V, typename hash, typename equal>
+size_t LRUCache<K, V, hash, equal>::MemSize() const {
+	size_t size = 0;
+	for (auto &shard : shards_) size += shard.totalSize.load(std::memory_order_relaxed);
+	return size;
+}
 
-	if (eraseCount_ && putCount_ * 16 > getCount_) {
-		logPrintf(LogWarning, "IdSetCache::eraseLRU () cache invalidates too fast eraseCount=%d,putCount=%d,getCount=%d", eraseCount_,
-				  putCount_, eraseCount_);
-		eraseCount_ = 0;
-		hitCountToCache_ *= 2;
-		putCount_ = 0;
-		getCount_ = 0;
+template <typename K, typename V, typename hash, typename equal>
+bool LRUCache<K, V, hash, equal>::Empty() const {
+	for (auto &shard : shards_)
+		if (shard.count.load(std::memory_order_relaxed)) return false;
+	return true;
+}
+
+template <typename K, typename V, typename hash, typename equal>
+LRUCacheStats LRUCache<K, V, hash, equal>::GetStats() const {
+	LRUCacheStats stats;
+	for (auto &shard : shards_) {
+		stats.hits += shard.hits.load(std::memory_order_relaxed);
+		stats.misses += shard.misses.load(std::memory_order_relaxed);
+		stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+		stats.items += shard.count.load(std::memory_order_relaxed);
+		stats.totalSize += shard.totalSize.load(std::memory_order_relaxed);
 	}
+	return stats;
 }
 
 template class LRUCache<IdSetCacheKey, IdSetCacheVal, hash_idset_cache_key, equal_idset_cache_key>;
 template class LRUCache<IdSetCacheKey, FtIdSetCacheVal, hash_idset_cache_key, equal_idset_cache_key>;
 template class LRUCache<QueryCacheKey, QueryCacheVal, HashQueryCacheKey, EqQueryCacheKey>;
+template class LRUCache<QueryCacheKey, QueryResultsCacheVal, HashQueryCacheKey, EqQueryCacheKey>;
 
 }  // namespace reindexer
@@ -1,53 +1,126 @@
 #pragma once
 
-#include <list>
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
+#include "core/cachestats.h"
+#include "estl/shared_mutex.h"
 
 namespace reindexer {
-using std::list;
+using std::atomic;
 using std::mutex;
 using std::unordered_map;
+using std::vector;
 
 const size_t kDefaultCacheSizeLimit = 1024 * 1024 * 128;
 const int kDefaultHitCountToCache = 2;
 
+// Process wide memory budget, shared by all cache instances.
+// Each cache charges budget for memory of it's entries. When total memory of all caches exceeds limit,
+// entries are evicted from all registered caches proportionally to their sizes.
+class CacheMemoryBudget {
+public:
+	class Client {
+	public:
+		virtual ~Client() = default;
+		// Evict entries to free at least 'bytes' of memory. Returns count of freed bytes
+		virtual size_t Reclaim(size_t bytes) = 0;
+		virtual size_t MemSize() const = 0;
+	};
+
+	static CacheMemoryBudget &Instance();
+
+	// Set limit of memory for all caches. 0 - unlimited
+	void SetLimit(size_t limit);
+	size_t Limit() const { return limit_.load(std::memory_order_relaxed); }
+	size_t Used() const { return used_.load(std::memory_order_relaxed); }
+
+	void Register(Client *client);
+	void Unregister(Client *client);
+	void Charge(int64_t delta) { used_.fetch_add(delta, std::memory_order_relaxed); }
+	// Evict entries from caches, if budget is exceeded. Must not be called under lock of any cache
+	void Enforce();
+
+protected:
+	atomic<size_t> limit_{0}, used_{0};
+	mutex mtx_;
+	vector<Client *> clients_;
+};
+
+// Sharded cache with cost aware CLOCK eviction and frequency based admission.
+// Each shard has it's own rw lock. Cache hit takes only shared lock and marks entry as recently used,
+// so concurrent lookups of the same keys does not serialize on cache.
+// Missed keys are not stored, until they were requested at least hitCount times (estimated by frequency sketch).
+// Entries, which took long time to calculate relative to their size, survive more passes of CLOCK hand.
 template <typename K, typename V, typename hash, typename equal>
-class LRUCache {
+class LRUCache : public CacheMemoryBudget::Client {
 public:
-	LRUCache(size_t sizeLimit = kDefaultCacheSizeLimit, int hitCount = kDefaultHitCountToCache)
-		: totalCacheSize_(0), cacheSizeLimit_(sizeLimit), hitCountToCache_(hitCount) {}
+	LRUCache(size_t sizeLimit = kDefaultCacheSizeLimit, int hitCount = kDefaultHitCountToCache);
+	~LRUCache();
+	LRUCache(const LRUCache &) = delete;
+	LRUCache &operator=(const LRUCache &) = delete;
 	struct Iterator {
 		Iterator(const K *k = nullptr, const V &v = V()) : key(k), val(v) {}
+		// Pointer to cached key, or nullptr if value must not be put to cache
 		const K *key;
 		V val;
 	};
-	// Get cached val. Create new entry in cache if unexists
+	// Get cached val. If returned key is not null, and val is empty, value should be calculated and put to cache.
 	Iterator Get(const K &k);
 	// Put cached val
 	void Put(const K &k, const V &v);
 
-	bool Empty() const { return items_.empty(); }
+	bool Empty() const;
+	LRUCacheStats GetStats() const;
 
-protected:
-	void eraseLRU();
+	size_t Reclaim(size_t bytes) override;
+	size_t MemSize() const override;
 
-	typedef list<const K *> LRUList;
+protected:
+	enum { kShards = 16, kSketchWidth = 256, kSketchRows = 4, kMaxCredit = 3 };
 
 	struct Entry {
+		Entry() : credit(1), weight(1), lastAccess(0) {}
 		V val;
-		typename LRUList::iterator lruPos;
-		int hitCount = 0;
+		// Count of CLOCK hand passes, entry will survive. Restored to weight on each hit
+		atomic<uint8_t> credit;
+		uint8_t weight;
+		// Time of last lookup, used to estimate cost of value calculation
+		atomic<int64_t> lastAccess;
+	};
+	typedef unordered_map<K, Entry, hash, equal> Map;
+
+	// Count-min sketch with 8 bit counters. Counters are halved periodically, so estimation reflects recent frequency
+	class FrequencySketch {
+	public:
+		int Increment(size_t h);
+
+	protected:
+		vector<uint8_t> counters_;
+		size_t additions_ = 0;
 	};
 
-	unordered_map<K, Entry, hash, equal> items_;
-	LRUList lru_;
-	mutex lock_;
-	size_t totalCacheSize_;
+	struct Shard {
+		Map items;
+		// CLOCK ring over items
+		vector<typename Map::value_type *> ring;
+		size_t hand = 0;
+		// Moving average of calculation time per byte of entries
+		double avgCost = 0;
+		FrequencySketch sketch;
+		profiled_shared_mutex lock;
+		atomic<size_t> hits{0}, misses{0}, evictions{0}, count{0}, totalSize{0};
+	};
+
+	Shard &shardOf(size_t h) { return shards_[(h ^ (h >> 16)) % kShards]; }
+	// Evict entries, until shard size is less than limit. Returns count of freed bytes
+	size_t evict(Shard &shard, size_t limit);
+	uint8_t weightOf(Shard &shard, const Entry &entry);
+
+	Shard shards_[kShards];
 	size_t cacheSizeLimit_;
 	int hitCountToCache_;
-
-	int getCount_ = 0, putCount_ = 0, eraseCount_ = 0;
 };
 
 }  // namespace reindexer
@@ -0,0 +1,47 @@
+#include "memstat.h"
+#include "tools/serializer.h"
+
+namespace reindexer {
+
+void IndexMemStat::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"name\":\"%s\",", name.c_str());
+	ser.Printf("\"uniq_keys_count\":%zu,", uniqKeysCount);
+	ser.Printf("\"data_size\":%zu,", dataSize);
+	ser.Printf("\"idset_plain_size\":%zu,", idsetPlainSize);
+	ser.Printf("\"idset_btree_size\":%zu,", idsetBTreeSize);
+	ser.Printf("\"sort_orders_size\":%zu,", sortOrdersSize);
+	ser.Printf("\"fulltext_size\":%zu,", fulltextSize);
+	ser.Printf("\"total_size\":%zu,", Total());
+	ser.PutChars("\"idset_cache\":");
+	idsetCache.GetJSON(ser);
+	ser.PutChar('}');
+}
+
+size_t NamespaceMemStat::Total() const {
+	size_t size = dataSize + pkFilterSize + queryCache.totalSize + resultsCache.totalSize;
+	for (auto &idx : indexes) size += idx.Total();
+	return size;
+}
+
+void NamespaceMemStat::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"name\":\"%s\",", name.c_str());
+	ser.Printf("\"items_count\":%zu,", itemsCount);
+	ser.Printf("\"empty_items_count\":%zu,", emptyItemsCount);
+	ser.Printf("\"data_size\":%zu,", dataSize);
+	ser.Printf("\"pk_filter_size\":%zu,", pkFilterSize);
+	ser.Printf("\"total_size\":%zu,", Total());
+	ser.PutChars("\"query_cache\":");
+	queryCache.GetJSON(ser);
+	ser.PutChars(",\"query_results_cache\":");
+	resultsCache.GetJSON(ser);
+	ser.PutChars(",\"indexes\":[");
+	for (size_t i = 0; i < indexes.size(); i++) {
+		if (i != 0) ser.PutChar(',');
+		indexes[i].GetJSON(ser);
+	}
+	ser.PutChars("]}");
+}
+
+}  // namespace reindexer
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/cachestats.h"
+
+namespace reindexer {
+
+// Memory, used by index. All sizes are in bytes
+struct IndexMemStat {
+	void GetJSON(WrSerializer &ser) const;
+	size_t Total() const { return dataSize + idsetPlainSize + idsetBTreeSize + sortOrdersSize + fulltextSize + idsetCache.totalSize; }
+
+	std::string name;
+	size_t uniqKeysCount = 0;
+	// Keys of index: map nodes, strings and column of stored values
+	size_t dataSize = 0;
+	// Plain idsets of keys, including copies of ids, sorted by other indexes
+	size_t idsetPlainSize = 0;
+	// BTree idsets of keys with many ids
+	size_t idsetBTreeSize = 0;
+	// Ids of items, sorted by ordered index
+	size_t sortOrdersSize = 0;
+	// Fulltext structures: words with their documents, typos and suffixes
+	size_t fulltextSize = 0;
+	LRUCacheStats idsetCache;
+};
+
+// Memory, used by namespace and it's indexes. All sizes are in bytes
+struct NamespaceMemStat {
+	void GetJSON(WrSerializer &ser) const;
+	size_t Total() const;
+
+	std::string name;
+	size_t itemsCount = 0;
+	// Count of free slots in items array, left after deletes
+	size_t emptyItemsCount = 0;
+	// Payloads of items. Strings of payloads are accounted in indexes
+	size_t dataSize = 0;
+	size_t pkFilterSize = 0;
+	LRUCacheStats queryCache;
+	LRUCacheStats resultsCache;
+	std::vector<IndexMemStat> indexes;
+};
+
+}  // namespace reindexer
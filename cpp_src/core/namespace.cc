@@ -12,6 +12,7 @@
 #include "storage/storagefactory.h"
 #include "tools/errors.h"
 #include "tools/fsops.h"
+#include "tools/jsontools.h"
 #include "tools/logger.h"
 #include "tools/slice.h"
 #include "tools/stringstools.h"
@@ -56,8 +57,16 @@ Namespace::Namespace(const Namespace &src)
 	  pkFields_(src.pkFields_),
 	  meta_(src.meta_),
 	  dbpath_(src.dbpath_),
-	  queryCache_(src.queryCache_) {
+	  queryCache_(src.queryCache_),
+	  resultsCache_(make_shared<QueryResultsCache>()),
+	  itemsGenerations_(src.itemsGenerations_),
+	  itemsGeneration_(src.itemsGeneration_),
+	  perfCounters_(src.perfCounters_),
+	  pkFilter_(src.pkFilter_),
+	  pkFilterEnabled_(src.pkFilterEnabled_),
+	  pkFilterStale_(src.pkFilterStale_) {
 	for (auto &idxIt : src.indexes_) indexes_.push_back(unique_ptr<Index>(idxIt->Clone()));
+	mtx_.set_name("ns:" + name_);
 	logPrintf(LogTrace, "Namespace::Namespace (clone %s)", name_.c_str());
 }
 
@@ -67,8 +76,14 @@ Namespace::Namespace(const string &name)
 	  tagsMatcher_(payloadType_),
 	  unflushedCount_(0),
 	  sortOrdersBuilt_(false),
-	  queryCache_(make_shared<QueryCache>()) {
+	  queryCache_(make_shared<QueryCache>()),
+	  resultsCache_(make_shared<QueryResultsCache>()),
+	  itemsGeneration_(itemsGenerations_.Next()),
+	  perfCounters_(make_shared<NamespacePerfCounters>()),
+	  pkFilterEnabled_(false),
+	  pkFilterStale_(0) {
 	logPrintf(LogTrace, "Namespace::Namespace (%s)", name_.c_str());
+	mtx_.set_name("ns:" + name_);
 	items_.reserve(10000);
 
 	// Add index and payload field for tuple of non indexed fields
@@ -87,7 +102,7 @@ void Namespace::recreateCompositeIndexes(int startIdx) {
 			index.reset(Index::New(index->Type(), index->Name(), index->Opts(), payloadType_, index->Fields()));
 			for (IdType rowId = 0; rowId < static_cast<int>(items_.size()); ++rowId) {
 				if (!items_[rowId].IsFree()) {
-					indexes_[i]->Upsert(KeyRef(items_[rowId]), rowId);
+					upsertComposite(*indexes_[i], payloadType_, items_[rowId], rowId);
 				}
 			}
 		}
@@ -124,7 +139,7 @@ void Namespace::updateItems(PayloadType oldPlType, const FieldsSet &changedField
 		Payload newValue(payloadType_, plNew);
 
 		for (int fieldIdx = compositeStartIdx; fieldIdx < int(indexes_.size()); ++fieldIdx) {
-			indexes_[fieldIdx]->Delete(KeyRef(plCurr), rowId);
+			deleteComposite(*indexes_[fieldIdx], oldPlType, plCurr, rowId);
 		}
 
 		for (auto fieldIdx : changedFields) {
@@ -132,8 +147,7 @@ void Namespace::updateItems(PayloadType oldPlType, const FieldsSet &changedField
 
 			if ((fieldIdx == 0) || deltaFields <= 0) {
 				oldValue.Get(fieldIdx, krefs);
-				for (auto key : krefs) index.Delete(key, rowId);
-				if (krefs.empty()) index.Delete(KeyRef(), rowId);
+				index.DeleteKeys(krefs, rowId);
 			}
 
 			if ((fieldIdx == 0) || deltaFields >= 0) {
@@ -142,16 +156,13 @@ void Namespace::updateItems(PayloadType oldPlType, const FieldsSet &changedField
 				} else {
 					newValue.Get(fieldIdx, krefs);
 				}
-				skrefs.resize(0);
-				for (auto key : krefs) skrefs.push_back(index.Upsert(key, rowId));
-
+				index.UpsertKeys(skrefs, krefs, rowId);
 				newValue.Set(fieldIdx, skrefs);
-				if (skrefs.empty()) index.Upsert(KeyRef(), rowId);
 			}
 		}
 
 		for (int fieldIdx = compositeStartIdx; fieldIdx < int(indexes_.size()); ++fieldIdx) {
-			indexes_[fieldIdx]->Upsert(KeyRef(plNew), rowId);
+			upsertComposite(*indexes_[fieldIdx], payloadType_, plNew, rowId);
 		}
 
 		plCurr = std::move(plNew);
@@ -163,6 +174,8 @@ void Namespace::AddIndex(const string &index, const string &jsonPath, IndexType
 	WLock wlock(mtx_);
 	if (addIndex(index, jsonPath, type, opts)) {
 		saveIndexesToStorage();
+		// PK fields or payload layout could be changed
+		if (pkFilterEnabled_) rebuildPKFilter();
 	}
 }
 
@@ -170,6 +183,7 @@ bool Namespace::DropIndex(const string &index) {
 	WLock wlock(mtx_);
 	if (dropIndex(index)) {
 		saveIndexesToStorage();
+		if (pkFilterEnabled_) rebuildPKFilter();
 		return true;
 	}
 	return false;
@@ -231,6 +245,8 @@ bool Namespace::dropIndex(const string &index) {
 
 	indexes_.erase(indexes_.begin() + fieldIdx);
 	indexesNames_.erase(itIdxName);
+	// Numbers of following indexes are shifted, so their commit state is not valid anymore
+	markUpdated();
 	return true;
 }
 
@@ -252,6 +268,9 @@ bool Namespace::addIndex(const string &index, const string &jsonPath, IndexType
 						index.c_str());
 		}
 
+		// Point is stored in payload as array of coordinates
+		if (type == IndexPointGrid) opts.Array(true);
+
 		insertIndex(Index::New(type, index, opts, PayloadType(), FieldsSet()), idxNo, index);
 
 		PayloadType oldPlType = payloadType_;
@@ -319,10 +338,6 @@ bool Namespace::AddCompositeIndex(const string &index, IndexType type, IndexOpts
 			throw Error(errParams, "Subindex '%s' not found for composite index '%s'", subIdx.c_str(), index.c_str());
 		}
 
-		if (indexes_[idxNameIt->second]->Opts().IsArray() && (type == IndexCompositeBTree || type == IndexCompositeHash)) {
-			throw Error(errParams, "Can't add array subindex '%s' to composite index '%s'", subIdx.c_str(), index.c_str());
-		}
-
 		fields.push_back(idxNameIt->second);
 		if (!indexes_[idxNameIt->second]->Opts().IsPK()) {
 			eachSubIdxPK = false;
@@ -352,7 +367,7 @@ bool Namespace::AddCompositeIndex(const string &index, IndexType type, IndexOpts
 
 		for (IdType rowId = 0; rowId < int(items_.size()); rowId++) {
 			if (!items_[rowId].IsFree()) {
-				indexes_[idxPos]->Upsert(KeyRef(items_[rowId]), rowId);
+				upsertComposite(*indexes_[idxPos], payloadType_, items_[rowId], rowId);
 			}
 		}
 
@@ -375,6 +390,16 @@ void Namespace::insertIndex(Index *newIndex, int idxNo, const string &realName)
 	if (newIndex->Opts().IsPK() && newIndex->Opts().IsArray()) {
 		throw Error(errParams, "Can't add index '%s' in namespace '%s'. PK field can't be array", newIndex->Name().c_str(), name_.c_str());
 	}
+	if (newIndex->Opts().IsPK() && newIndex->Opts().IsSparse()) {
+		throw Error(errParams, "Can't add index '%s' in namespace '%s'. PK field can't be sparse", newIndex->Name().c_str(), name_.c_str());
+	}
+	// Absent scalar field is indexed as default value, so only arrays and '-' indexes could skip empty values
+	IndexType type = newIndex->Type();
+	bool store = type == IndexIntStore || type == IndexInt64Store || type == IndexStrStore || type == IndexDoubleStore;
+	if (newIndex->Opts().IsSparse() && !newIndex->Opts().IsArray() && !store) {
+		throw Error(errParams, "Can't add index '%s' in namespace '%s'. Only array and '-' indexes can be sparse", newIndex->Name().c_str(),
+					name_.c_str());
+	}
 
 	indexes_.insert(indexes_.begin() + idxNo, unique_ptr<Index>(newIndex));
 
@@ -385,6 +410,8 @@ void Namespace::insertIndex(Index *newIndex, int idxNo, const string &realName)
 	}
 
 	indexesNames_.insert({realName, idxNo});
+	// Numbers of following indexes are shifted, so their commit state is not valid anymore
+	markUpdated();
 
 	if (newIndex->Opts().IsPK()) {
 		if (newIndex->KeyType() == KeyValueComposite) {
@@ -402,7 +429,15 @@ int Namespace::getIndexByName(const string &index) const {
 
 	return idxIt->second;
 }
-void Namespace::ConfigureIndex(const string &index, const string &config) { indexes_[getIndexByName(index)]->Configure(config); }
+void Namespace::ConfigureIndex(const string &index, const string &config) {
+	WLock wlock(mtx_);
+	auto &idx = indexes_[getIndexByName(index)];
+	// PK filter is namespace wide option, but it's configured via any of PK indexes
+	if (idx->Opts().IsPK()) configurePKFilter(config);
+	idx->Configure(config);
+	// Index can rebuild it's internal structures on configure, so commit is required
+	markUpdated();
+}
 
 void Namespace::Insert(Item &item, bool store) { upsertInternal(item, store, INSERT_MODE); }
 
@@ -444,21 +479,23 @@ void Namespace::_delete(IdType id) {
 	KeyRefs skrefs;
 	int field;
 	// erase from composite indexes
-	for (field = pl.NumFields(); field < int(indexes_.size()); ++field) indexes_[field]->Delete(KeyRef(items_[id]), id);
+	for (field = pl.NumFields(); field < int(indexes_.size()); ++field) deleteComposite(*indexes_[field], payloadType_, items_[id], id);
 
 	for (field = 0; field < pl.NumFields(); ++field) {
 		auto &index = *indexes_[field];
 		pl.Get(field, skrefs);
 		// Delete value from index
-		for (auto key : skrefs) index.Delete(key, id);
-		// If no krefs delete empty value from index
-		if (!skrefs.size()) index.Delete(KeyRef(), id);
+		index.DeleteKeys(skrefs, id);
 	}
 
 	// free PayloadValue
 	items_[id].Free();
+	itemsGeneration_ = itemsGenerations_.Next();
 	markUpdated();
 	free_.emplace(id);
+
+	// Filter can't remove keys, so rebuild it, when too many of them are stale
+	if (pkFilterEnabled_ && ++pkFilterStale_ > pkFilter_.size() / 2) rebuildPKFilter();
 }
 
 void Namespace::Delete(const Query &q, QueryResults &result) {
@@ -487,41 +524,73 @@ void Namespace::upsert(ItemImpl *ritem, IdType id, bool doUpdate) {
 	if (doUpdate) {
 		plData.AllocOrClone(pl.RealSize());
 	}
-	markUpdated();
 
 	KeyRefs krefs, skrefs;
 
-	// Delete from composite indexes first
+	// On update, indexes of unchanged fields are not touched, so their caches stay valid
+	FieldsSet changedIndexes;
 	int field = 0;
+	for (field = 0; field < plNew.NumFields(); ++field) {
+		if (doUpdate) {
+			getIndexKeys(plNew, field, skrefs);
+			pl.Get(field, krefs);
+			if (krefs == skrefs) continue;
+		}
+		changedIndexes.push_back(field);
+	}
+	for (field = plNew.NumFields(); field < int(indexes_.size()); ++field) {
+		for (int f : indexes_[field]->Fields()) {
+			if (changedIndexes.contains(f)) {
+				changedIndexes.push_back(field);
+				break;
+			}
+		}
+	}
+	markUpdated(changedIndexes);
+
+	// Delete from composite indexes first
 	for (field = plNew.NumFields(); field < int(indexes_.size()); ++field)
-		if (doUpdate) indexes_[field]->Delete(KeyRef(plData), id);
+		if (doUpdate && changedIndexes.contains(field)) deleteComposite(*indexes_[field], payloadType_, plData, id);
 
 	// Upsert fields to regular indexes
 	for (field = 0; field < plNew.NumFields(); ++field) {
+		if (!changedIndexes.contains(field)) continue;
 		auto &index = *indexes_[field];
 
-		plNew.Get(field, skrefs);
-
-		if (index.Opts().GetCollateMode() == CollateUTF8)
-			for (auto &key : skrefs) key.EnsureUTF8();
+		getIndexKeys(plNew, field, skrefs);
 
 		// Check for update
 		if (doUpdate) {
 			pl.Get(field, krefs);
-			for (auto key : krefs) index.Delete(key, id);
-			if (!krefs.size()) index.Delete(KeyRef(), id);
+			index.DeleteKeys(krefs, id);
 		}
 		// Put value to index
-		krefs.resize(0);
-		for (auto key : skrefs) krefs.push_back(index.Upsert(key, id));
+		index.UpsertKeys(krefs, skrefs, id);
 
 		// Put value to payload
 		pl.Set(field, krefs);
-		// If no krefs upsert empty value to index
-		if (!skrefs.size()) index.Upsert(KeyRef(), id);
 	}
 	// Upsert to composite indexes
-	for (; field < int(indexes_.size()); ++field) indexes_[field]->Upsert(KeyRef(plData), id);
+	for (; field < int(indexes_.size()); ++field)
+		if (changedIndexes.contains(field)) upsertComposite(*indexes_[field], payloadType_, plData, id);
+}
+
+void Namespace::getIndexKeys(Payload &pl, int field, KeyRefs &keys) {
+	pl.Get(field, keys);
+	if (indexes_[field]->Opts().GetCollateMode() == CollateUTF8)
+		for (auto &key : keys) key.EnsureUTF8();
+}
+
+void Namespace::upsertComposite(Index &index, const PayloadType &type, const PayloadValue &pv, IdType id) {
+	h_vector<PayloadValue, 1> keys;
+	ConstPayload(type, pv).GetCompositeKeys(index.Fields(), keys);
+	for (auto &key : keys) index.Upsert(KeyRef(key), id);
+}
+
+void Namespace::deleteComposite(Index &index, const PayloadType &type, const PayloadValue &pv, IdType id) {
+	h_vector<PayloadValue, 1> keys;
+	ConstPayload(type, pv).GetCompositeKeys(index.Fields(), keys);
+	for (auto &key : keys) index.Delete(KeyRef(key), id);
 }
 
 void Namespace::updateTagsMatcherFromItem(ItemImpl *ritem, string &jsonSliceBuf) {
@@ -593,6 +662,9 @@ void Namespace::upsertInternal(Item &item, bool store, uint8_t mode) {
 	upsert(itemImpl, id, exists);
 	item.setID(id, items_[id].GetVersion());
 
+	// Precepts can change PK values of existing item
+	if (pkFilterEnabled_ && (!exists || !itemImpl->GetPrecepts().empty())) addToPKFilter(id);
+
 	if (storage_ && store) {
 		char pk[512];
 		auto prefLen = strlen(kStorageItemPrefix);
@@ -614,6 +686,9 @@ pair<IdType, bool> Namespace::findByPK(ItemImpl *ritem) {
 	}
 
 	Payload pl = ritem->GetPayload();
+	// Definitely new item, there is no need to search it in indexes
+	if (pkFilterEnabled_ && !pkFilter_.may_contain(pl.GetHash(pkFields_))) return {-1, false};
+
 	// It's faster equalent of "select ID from namespace where pk1 = 'item.pk1' and pk2 = 'item.pk2' "
 	// Get pkey values from pk fields
 	for (int field = 0; field < int(indexes_.size()); ++field)
@@ -653,6 +728,71 @@ pair<IdType, bool> Namespace::findByPK(ItemImpl *ritem) {
 	return {-1, false};
 }
 
+void Namespace::configurePKFilter(const string &config) {
+	string json = config;
+	JsonAllocator jalloc;
+	JsonValue jvalue;
+	char *endp;
+
+	if (jsonParse(&json[0], &endp, &jvalue, jalloc) != JSON_OK) {
+		throw Error(errParseJson, "Malformed JSON with config of PK index in namespace '%s'", name_.c_str());
+	}
+
+	bool enable = pkFilterEnabled_;
+	for (auto elem : jvalue) {
+		if (elem->value.getTag() == JSON_NULL) continue;
+		parseJsonField("pk_filter", enable, elem);
+	}
+	if (enable == pkFilterEnabled_) return;
+
+	if (enable) {
+		// Hashes of PK values must be equal for equal keys, but collate modes consider different strings as equal
+		for (auto &idx : indexes_) {
+			if (idx->Opts().IsPK() && idx->Opts().GetCollateMode() != CollateNone) {
+				throw Error(errParams, "Can't enable PK filter in namespace '%s': PK index '%s' has collate mode", name_.c_str(),
+							idx->Name().c_str());
+			}
+		}
+		pkFilterEnabled_ = true;
+		rebuildPKFilter();
+	} else {
+		pkFilterEnabled_ = false;
+		pkFilter_ = blocked_bloom_filter();
+	}
+}
+
+void Namespace::rebuildPKFilter() {
+	const size_t kMinPKFilterCapacity = 1024;
+
+	for (auto &idx : indexes_) {
+		if (idx->Opts().IsPK() && idx->Opts().GetCollateMode() != CollateNone) {
+			logPrintf(LogWarning, "PK filter of namespace '%s' is disabled: PK index '%s' has collate mode", name_.c_str(),
+					  idx->Name().c_str());
+			pkFilterEnabled_ = false;
+			pkFilter_ = blocked_bloom_filter();
+			return;
+		}
+	}
+
+	// Reserve space for growth, to avoid rebuild on each insert
+	pkFilter_ = blocked_bloom_filter(std::max(2 * (items_.size() - free_.size()), kMinPKFilterCapacity));
+	pkFilterStale_ = 0;
+	for (IdType id = 0; id < IdType(items_.size()); ++id) {
+		if (!items_[id].IsFree()) pkFilter_.add(ConstPayload(payloadType_, items_[id]).GetHash(pkFields_));
+	}
+	logPrintf(LogTrace, "PK filter of namespace '%s' rebuilt: %d keys, %d bytes", name_.c_str(), int(pkFilter_.size()),
+			  int(pkFilter_.heap_size()));
+}
+
+void Namespace::addToPKFilter(IdType id) {
+	if (pkFilter_.size() >= pkFilter_.capacity()) {
+		// Filter is full and false positive rate will grow. Item is already in namespace, so it will be added on rebuild
+		rebuildPKFilter();
+		return;
+	}
+	pkFilter_.add(ConstPayload(payloadType_, items_[id]).GetHash(pkFields_));
+}
+
 void Namespace::commit(const NSCommitContext &ctx, SelectLockUpgrader *lockUpgrader) {
 	bool needCommit = (!sortOrdersBuilt_ && (ctx.phases() & CommitContext::MakeSortOrders));
 
@@ -664,6 +804,7 @@ void Namespace::commit(const NSCommitContext &ctx, SelectLockUpgrader *lockUpgra
 	}
 
 	if (lockUpgrader) lockUpgrader->Upgrade();
+	auto tmStart = high_resolution_clock::now();
 
 	// Commit changes
 	if ((ctx.phases() & CommitContext::MakeIdsets) && !commitedIndexes_.containsAll(indexes_.size())) {
@@ -718,13 +859,22 @@ void Namespace::commit(const NSCommitContext &ctx, SelectLockUpgrader *lockUpgra
 				preparedIndexes_.push_back(idxNo);
 			}
 	}
+	perfCounters_->RecordCommit(duration_cast<microseconds>(high_resolution_clock::now() - tmStart).count());
 }
 
 void Namespace::markUpdated() {
 	sortOrdersBuilt_ = false;
 	preparedIndexes_.clear();
 	commitedIndexes_.clear();
-	invalidateQueryCache();
+}
+
+void Namespace::markUpdated(const FieldsSet &changedIndexes) {
+	for (int idx : changedIndexes) {
+		// Sort orders are built from idsets of all indexes, except tuple
+		if (idx != 0) sortOrdersBuilt_ = false;
+		preparedIndexes_.erase(idx);
+		commitedIndexes_.erase(idx);
+	}
 }
 
 void Namespace::Select(QueryResults &result, SelectCtx &params) {
@@ -737,6 +887,40 @@ void Namespace::Describe(QueryResults &result) {
 	describer(result);
 }
 
+NamespaceCacheStats Namespace::GetCacheStats() {
+	RLock rlock(mtx_);
+	NamespaceCacheStats stats;
+	stats.name = name_;
+	for (size_t idx = 1; idx < indexes_.size(); idx++) stats.indexes.push_back({indexes_[idx]->Name(), indexes_[idx]->GetCacheStats()});
+	stats.queryCache = queryCache_->GetStats();
+	stats.resultsCache = resultsCache_->GetStats();
+	return stats;
+}
+
+NamespacePerfStat Namespace::GetPerfStat() {
+	NamespacePerfStat stat = perfCounters_->GetStat(name_);
+	RLock rlock(mtx_);
+	stat.itemsCount = items_.size() - free_.size();
+	return stat;
+}
+
+NamespaceMemStat Namespace::GetMemStat() {
+	RLock rlock(mtx_);
+	NamespaceMemStat stat;
+	stat.name = name_;
+	stat.itemsCount = items_.size() - free_.size();
+	stat.emptyItemsCount = free_.size();
+	stat.dataSize = items_.capacity() * sizeof(PayloadValue) + free_.bucket_count() * sizeof(IdType);
+	for (auto &item : items_) {
+		if (!item.IsFree()) stat.dataSize += sizeof(PayloadValue::dataHeader) + item.GetCapacity();
+	}
+	stat.pkFilterSize = pkFilter_.heap_size();
+	stat.queryCache = queryCache_->GetStats();
+	stat.resultsCache = resultsCache_->GetStats();
+	for (auto &index : indexes_) stat.indexes.push_back(index->MemStat());
+	return stat;
+}
+
 NamespaceDef Namespace::GetDefinition() {
 	RLock rlock(mtx_);
 	auto pt = this->payloadType_;
@@ -794,7 +978,10 @@ bool Namespace::loadIndexesFromStorage() {
 			IndexOpts opts;
 			opts.Array(ser.GetVarUint());
 			opts.PK(ser.GetVarUint());
-			opts.Dense(ser.GetVarUint());
+			// Dense and sparse flags share one field to keep storage format compatible
+			int denseSparse = ser.GetVarUint();
+			opts.Dense(denseSparse & 1);
+			opts.Sparse(denseSparse & 2);
 			opts.Appendable(ser.GetVarUint());
 			opts.SetCollateMode(static_cast<CollateMode>(ser.GetVarUint()));
 			for (auto &jsonPath : jsonPaths) {
@@ -840,7 +1027,7 @@ void Namespace::saveIndexesToStorage() {
 		ser.PutVarUint(indexes_[f]->Type());
 		ser.PutVarUint(indexes_[f]->Opts().IsArray());
 		ser.PutVarUint(indexes_[f]->Opts().IsPK());
-		ser.PutVarUint(indexes_[f]->Opts().IsDense());
+		ser.PutVarUint(int(indexes_[f]->Opts().IsDense()) | (int(indexes_[f]->Opts().IsSparse()) << 1));
 		ser.PutVarUint(indexes_[f]->Opts().IsAppendable());
 		ser.PutVarUint(indexes_[f]->Opts().GetCollateMode());
 	}
@@ -913,6 +1100,7 @@ void Namespace::LoadFromStorage() {
 	}
 	logPrintf(LogInfo, "[%s] Done loading storage. %d items loaded, total size=%dM", name_.c_str(), int(items_.size()),
 			  int(ldcount / (1024 * 1024)));
+	if (pkFilterEnabled_) rebuildPKFilter();
 }
 
 void Namespace::FlushStorage() {
@@ -929,10 +1117,12 @@ void Namespace::FlushStorage() {
 		}
 
 		if (unflushedCount_) {
+			auto tmStart = high_resolution_clock::now();
 			Error status = storage_->Write(StorageOpts().FillCache(), *(updates_.get()));
 			if (!status.ok()) throw Error(errLogic, "Error write ns '%s' to storage:", name_.c_str(), status.what().c_str());
 			updates_->Clear();
 			unflushedCount_ = 0;
+			perfCounters_->RecordFlush(duration_cast<microseconds>(high_resolution_clock::now() - tmStart).count());
 		}
 	}
 }
@@ -1038,16 +1228,10 @@ IdType Namespace::createItem(size_t realSize) {
 		id = items_.size();
 		items_.emplace_back(PayloadValue(realSize));
 	}
+	itemsGeneration_ = itemsGenerations_.Next();
 	return id;
 }
 
-void Namespace::invalidateQueryCache() {
-	if (!queryCache_->Empty()) {
-		logPrintf(LogTrace, "[*] invalidate query cache. namespace: %s\n", name_.c_str());
-		queryCache_.reset(new QueryCache);
-	}
-}
-
 void Namespace::setFieldsBasedOnPrecepts(ItemImpl *ritem) {
 	for (auto &precept : ritem->GetPrecepts()) {
 		SelectFuncParser sqlFunc;
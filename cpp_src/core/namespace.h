@@ -4,8 +4,12 @@
 #include <mutex>
 #include <vector>
 #include "core/cjson/tagsmatcher.h"
+#include "core/generation.h"
 #include "core/item.h"
+#include "core/memstat.h"
+#include "core/perfstat.h"
 #include "core/selectfunc/selectfunc.h"
+#include "estl/bloom_filter.h"
 #include "estl/fast_hash_map.h"
 #include "estl/fast_hash_set.h"
 #include "estl/shared_mutex.h"
@@ -100,6 +104,9 @@ public:
 	void Select(QueryResults &result, SelectCtx &params);
 	void Describe(QueryResults &result);
 	NamespaceDef GetDefinition();
+	NamespaceCacheStats GetCacheStats();
+	NamespaceMemStat GetMemStat();
+	NamespacePerfStat GetPerfStat();
 	vector<string> EnumMeta();
 	void Delete(const Query &query, QueryResults &result);
 	void FlushStorage();
@@ -119,7 +126,13 @@ protected:
 	void saveIndexesToStorage();
 	bool loadIndexesFromStorage();
 	void markUpdated();
+	// Mark only changed indexes for commit
+	void markUpdated(const FieldsSet &changedIndexes);
 	void upsert(ItemImpl *ritem, IdType id, bool doUpdate);
+	// Upsert/delete item to composite index. Arrays subfields are expanded to multiple keys
+	void upsertComposite(Index &index, const PayloadType &type, const PayloadValue &pv, IdType id);
+	void getIndexKeys(Payload &pl, int field, KeyRefs &keys);
+	void deleteComposite(Index &index, const PayloadType &type, const PayloadValue &pv, IdType id);
 	void upsertInternal(Item &item, bool store = true, uint8_t mode = (INSERT_MODE | UPDATE_MODE));
 	void updateTagsMatcherFromItem(ItemImpl *ritem, string &jsonSliceBuf);
 	void updateItems(PayloadType oldPlType, const FieldsSet &changedFields, int deltaFields);
@@ -135,6 +148,10 @@ protected:
 
 	pair<IdType, bool> findByPK(ItemImpl *ritem);
 
+	void configurePKFilter(const string &config);
+	void rebuildPKFilter();
+	void addToPKFilter(IdType id);
+
 	int getSortedIdxCount() const;
 
 	void setFieldsBasedOnPrecepts(ItemImpl *ritem);
@@ -158,7 +175,7 @@ protected:
 	datastorage::UpdatesCollection::Ptr updates_;
 	int unflushedCount_;
 
-	shared_timed_mutex mtx_;
+	profiled_shared_mutex mtx_;
 	// Commit phases state
 	bool sortOrdersBuilt_;
 	FieldsSet preparedIndexes_, commitedIndexes_;
@@ -169,21 +186,33 @@ protected:
 	string dbpath_;
 
 	shared_ptr<QueryCache> queryCache_;
+	// Cache of full query results
+	shared_ptr<QueryResultsCache> resultsCache_;
+	// Generation of items set. Changed on insert or delete of items
+	GenerationCounter itemsGenerations_;
+	uint64_t itemsGeneration_;
+	// Latencies of operations. Shared with clones, like query cache
+	shared_ptr<NamespacePerfCounters> perfCounters_;
 
 	// shows if each subindex was PK
 	fast_hash_map<string, bool> compositeIndexesPkState_;
 
+	// Bloom filter over hashes of PK values. Allows findByPK to skip indexes lookup for new items
+	blocked_bloom_filter pkFilter_;
+	bool pkFilterEnabled_;
+	// Count of deleted items, which PK values are still in filter
+	size_t pkFilterStale_;
+
 private:
 	Namespace(const Namespace &src);
 
 private:
-	typedef shared_lock<shared_timed_mutex> RLock;
-	typedef unique_lock<shared_timed_mutex> WLock;
+	typedef shared_lock<profiled_shared_mutex> RLock;
+	typedef unique_lock<profiled_shared_mutex> WLock;
 
 	enum { INSERT_MODE = 0x01, UPDATE_MODE = 0x02 };
 	IdType createItem(size_t realSize);
 
-	void invalidateQueryCache();
 };
 
 }  // namespace reindexer
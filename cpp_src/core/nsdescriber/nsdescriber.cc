@@ -11,6 +11,17 @@ using std::string;
 using std::stringstream;
 
 namespace reindexer {
+
+static void describeCacheStats(stringstream &strStream, const LRUCacheStats &stats) {
+	strStream << "{";
+	strStream << "\"hits\":" << stats.hits << ",";
+	strStream << "\"misses\":" << stats.misses << ",";
+	strStream << "\"evictions\":" << stats.evictions << ",";
+	strStream << "\"items_count\":" << stats.items << ",";
+	strStream << "\"total_size\":" << stats.totalSize;
+	strStream << "}";
+}
+
 void NsDescriber::operator()(QueryResults &result) {
 	PayloadType payloadType;
 	TagsMatcher tagsMatcher;
@@ -47,6 +58,8 @@ void NsDescriber::operator()(QueryResults &result) {
 	strStream << "\"indexes\":[";
 	strStream << std::boolalpha;
 
+	size_t cacheTotalSize = 0;
+
 	for (unsigned i = 0; i < nsDef.indexes.size(); i++) {
 		auto &index = nsDef.indexes[i];
 		assert(i + 1 < ns_->indexes_.size());
@@ -64,6 +77,11 @@ void NsDescriber::operator()(QueryResults &result) {
 		strStream << "\"pk\":" << index.opts.IsPK() << ",";
 		strStream << "\"fulltext\":" << isFullText(type) << ",";
 		strStream << "\"collate_mode\":\"" << index.getCollateMode() << "\",";
+		strStream << "\"cache\":";
+		auto cacheStats = idx->GetCacheStats();
+		cacheTotalSize += cacheStats.totalSize;
+		describeCacheStats(strStream, cacheStats);
+		strStream << ",";
 
 		strStream << "\"conditions\": [";
 		auto conds = index.Conditions();
@@ -77,6 +95,17 @@ void NsDescriber::operator()(QueryResults &result) {
 	strStream << "\"storage_enabled\":" << nsDef.storage.IsEnabled() << ",";
 	strStream << "\"storage_ok\":" << bool(ns_->storage_ != nullptr) << ",";
 	strStream << "\"storage_path\":\"" << ns_->dbpath_ << "\",";
+	strStream << "\"pk_filter_enabled\":" << ns_->pkFilterEnabled_ << ",";
+	strStream << "\"pk_filter_mem_size\":" << ns_->pkFilter_.heap_size() << ",";
+	auto queryCacheStats = ns_->queryCache_->GetStats(), resultsCacheStats = ns_->resultsCache_->GetStats();
+	cacheTotalSize += queryCacheStats.totalSize + resultsCacheStats.totalSize;
+	strStream << "\"query_cache\":";
+	describeCacheStats(strStream, queryCacheStats);
+	strStream << ",";
+	strStream << "\"query_results_cache\":";
+	describeCacheStats(strStream, resultsCacheStats);
+	strStream << ",";
+	strStream << "\"cache_total_size\":" << cacheTotalSize << ",";
 	strStream << "\"items_count\":" << ns_->items_.size() - ns_->free_.size();
 	strStream << "}";
 
@@ -0,0 +1,81 @@
+#include "core/nsselecter/groupby.h"
+
+namespace reindexer {
+
+GroupBy::GroupBy(PayloadType payloadType, const h_vector<int, 1> &fields, const h_vector<Aggregator, 4> &aggregators)
+	: payloadType_(payloadType), fields_(fields), prototypes_(aggregators) {}
+
+size_t GroupBy::group(const Key &key) {
+	auto it = groups_.find(key);
+	if (it != groups_.end()) return it->second;
+
+	size_t idx = keys_.size();
+	groups_.emplace(key, idx);
+	keys_.push_back(key);
+	aggregators_.insert(aggregators_.end(), prototypes_.begin(), prototypes_.end());
+	counts_.push_back(0);
+	return idx;
+}
+
+void GroupBy::Add(const PayloadValue &pv, IdType id) {
+	Key key;
+	KeyRefs krefs;
+	ConstPayload pl(payloadType_, pv);
+	for (auto field : fields_) {
+		pl.Get(field, krefs);
+		key.push_back(krefs.empty() ? KeyRef() : krefs[0]);
+	}
+
+	size_t idx = group(key);
+	counts_[idx]++;
+	for (size_t i = 0; i < prototypes_.size(); ++i) aggregators_[idx * prototypes_.size() + i].Aggregate(pv, id);
+}
+
+void GroupBy::AddGroup(const KeyRef &key, IdSetRef ids, const vector<uint64_t> *filter, const vector<PayloadValue> &items) {
+	Key groupKey;
+	groupKey.push_back(key);
+	const uint64_t *bits = filter ? filter->data() : nullptr;
+
+	if (prototypes_.empty()) {
+		int count = ids.size();
+		if (bits) {
+			// Only count is needed, so bits are tested without branches
+			count = 0;
+			for (auto id : ids) count += (bits[id >> 6] >> (id & 63)) & 1;
+		}
+		if (count) counts_[group(groupKey)] += count;
+		return;
+	}
+
+	// Group is created on first matched item, so groups without matched items are not returned
+	int count = 0;
+	size_t idx = 0;
+	Aggregator *aggregators = nullptr;
+	for (auto id : ids) {
+		if (bits && !((bits[id >> 6] >> (id & 63)) & 1)) continue;
+		if (!count++) {
+			idx = group(groupKey);
+			aggregators = aggregators_.data() + idx * prototypes_.size();
+		}
+		for (size_t i = 0; i < prototypes_.size(); ++i) aggregators[i].Aggregate(items[id], id);
+	}
+	if (count) counts_[idx] += count;
+}
+
+void GroupBy::GetResults(GroupedResults &res) const {
+	res.keys.assign(fields_.size(), vector<KeyValue>());
+	for (auto &column : res.keys) column.reserve(keys_.size());
+	for (auto &key : keys_) {
+		for (size_t f = 0; f < key.size(); ++f) res.keys[f].push_back(KeyValue(key[f]));
+	}
+
+	res.values.assign(prototypes_.size(), vector<double>());
+	for (size_t i = 0; i < prototypes_.size(); ++i) {
+		auto &column = res.values[i];
+		column.reserve(keys_.size());
+		for (size_t g = 0; g < keys_.size(); ++g) column.push_back(aggregators_[g * prototypes_.size() + i].GetResult());
+	}
+	res.counts = counts_;
+}
+
+}  // namespace reindexer
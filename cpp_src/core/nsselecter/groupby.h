@@ -0,0 +1,54 @@
+#pragma once
+
+#include "core/aggregator.h"
+#include "core/idset.h"
+#include "estl/fast_hash_map.h"
+
+namespace reindexer {
+
+// Aggregation of items by groups with equal values of fields. Each group has it's own copies of aggregators
+class GroupBy {
+public:
+	// fields - payload fields to group by, aggregators - prototypes of aggregators of group
+	GroupBy(PayloadType payloadType, const h_vector<int, 1> &fields, const h_vector<Aggregator, 4> &aggregators);
+
+	// Add item to group by values of it's fields
+	void Add(const PayloadValue &pv, IdType id);
+	// Add items with ids to group with key. Used to group by one indexed field, iterating idsets of index keys,
+	// instead of reading key from each item. If filter is set, only items with ids marked in filter bitmap are added
+	void AddGroup(const KeyRef &key, IdSetRef ids, const vector<uint64_t> *filter, const vector<PayloadValue> &items);
+	// Get keys, values of aggregations and counts of groups
+	void GetResults(GroupedResults &res) const;
+
+protected:
+	using Key = h_vector<KeyRef, 2>;
+	struct HashKey {
+		size_t operator()(const Key &key) const {
+			size_t h = 0;
+			for (auto &v : key) h = (h * 127) ^ v.Hash();
+			return h;
+		}
+	};
+	struct EqualKey {
+		bool operator()(const Key &lhs, const Key &rhs) const {
+			for (size_t i = 0; i < lhs.size(); ++i)
+				if (lhs[i].Type() != rhs[i].Type() || lhs[i] != rhs[i]) return false;
+			return true;
+		}
+	};
+
+	// Index of group with key. Group is created, if it doesn't exist
+	size_t group(const Key &key);
+
+	PayloadType payloadType_;
+	h_vector<int, 1> fields_;
+	h_vector<Aggregator, 4> prototypes_;
+	fast_hash_map<Key, size_t, HashKey, EqualKey> groups_;
+	// Keys reference strings in payloads, so they are valid only under namespace lock
+	vector<Key> keys_;
+	// Aggregators of group i are at [i * prototypes_.size(), (i + 1) * prototypes_.size())
+	vector<Aggregator> aggregators_;
+	vector<int> counts_;
+};
+
+}  // namespace reindexer
@@ -0,0 +1,36 @@
+#include "joinhashtable.h"
+
+namespace reindexer {
+
+void JoinHashTable::Build(QueryResults &&items, const PayloadType &rightType) {
+	items_ = std::move(items);
+	table_.clear();
+	table_.reserve(items_.size());
+
+	KeyRefs vals;
+	for (size_t i = 0; i < items_.size(); ++i) {
+		ConstPayload pl(rightType, items_[i].value);
+		Key key;
+		for (int field : rightFields_) {
+			pl.Get(field, vals);
+			// Fields are scalar, so exactly one value is expected
+			if (vals.size() != 1) break;
+			key.push_back(vals[0]);
+		}
+		if (key.size() == rightFields_.size()) table_[key].push_back(int(i));
+	}
+}
+
+const h_vector<int, 1> *JoinHashTable::Find(const ConstPayload &left) const {
+	Key key;
+	KeyRefs vals;
+	for (int field : leftFields_) {
+		left.Get(field, vals);
+		if (vals.size() != 1) return nullptr;
+		key.push_back(vals[0]);
+	}
+	auto it = table_.find(key);
+	return it != table_.end() ? &it->second : nullptr;
+}
+
+}  // namespace reindexer
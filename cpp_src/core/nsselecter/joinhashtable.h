@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "core/keyvalue/keyref.h"
+#include "core/payload/payloadiface.h"
+#include "core/query/queryresults.h"
+#include "estl/h_vector.h"
+
+namespace reindexer {
+
+// Hash table over items of joined namespace, which match where conditions of join query.
+// Items are grouped by values of right side fields of join conditions, and keep the order, in which they were selected,
+// so probe returns the same items in the same order, as the nested select by join conditions would return.
+// Applicable only for joins with AND equality conditions on scalar fields.
+class JoinHashTable {
+public:
+	typedef std::shared_ptr<JoinHashTable> Ptr;
+	typedef h_vector<KeyRef, 2> Key;
+
+	// leftFields - payload fields of main namespace, rightFields - corresponding payload fields of joined namespace
+	JoinHashTable(const h_vector<int, 2> &leftFields, const h_vector<int, 2> &rightFields)
+		: leftFields_(leftFields), rightFields_(rightFields) {}
+
+	// Build table from items of joined namespace
+	void Build(QueryResults &&items, const PayloadType &rightType);
+	// Find items of joined namespace, which join key is equal to join key of item of main namespace.
+	// Returns positions of found items in Items() or nullptr, if nothing was found
+	const h_vector<int, 1> *Find(const ConstPayload &left) const;
+	const QueryResults &Items() const { return items_; }
+	size_t Size() const { return items_.size(); }
+
+	struct hash_key {
+		size_t operator()(const Key &key) const {
+			size_t h = 0;
+			for (auto &v : key) h = (h * 127) ^ v.Hash();
+			return h;
+		}
+	};
+	struct equal_key {
+		bool operator()(const Key &lhs, const Key &rhs) const {
+			if (lhs.size() != rhs.size()) return false;
+			for (size_t i = 0; i < lhs.size(); ++i)
+				if (lhs[i] != rhs[i]) return false;
+			return true;
+		}
+	};
+
+protected:
+	h_vector<int, 2> leftFields_, rightFields_;
+	// Keys refer to payloads of items_, so they must live together
+	QueryResults items_;
+	std::unordered_map<Key, h_vector<int, 1>, hash_key, equal_key> table_;
+};
+
+}  // namespace reindexer
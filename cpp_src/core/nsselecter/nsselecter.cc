@@ -1,8 +1,12 @@
+#include <cmath>
+#include <limits>
+#include <random>
 #include <sstream>
 
 #include "core/cjson/jsonencoder.h"
 #include "core/index/index.h"
 #include "core/namespace.h"
+#include "core/nsselecter/groupby.h"
 #include "nsselecter.h"
 #include "tools/logger.h"
 #include "tools/stringstools.h"
@@ -16,6 +20,16 @@ using std::string;
 using std::stringstream;
 
 namespace reindexer {
+
+// Count of items of main namespace, which are joined by one batched select of joined namespace
+const size_t kJoinBatchSize = 512;
+// Cost of counting facet of item by it's payload relative to test of one id of index's idset
+const size_t kFacetRowScanCost = 16;
+// Count of matched items, which are aggregated by one pass of aggregator
+const size_t kAggregationBatchSize = 1024;
+// Count of loop iterations after requested items are selected, by which selectivity of conditions is sampled for approximate total
+const int kApproxTotalSampleSize = 4096;
+
 #define TIMEPOINT(n)                                  \
 	std::chrono::high_resolution_clock::time_point n; \
 	if (enableTiming) n = high_resolution_clock::now()
@@ -23,18 +37,22 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 	CollateOpts collateOpts;
 	Index *sortIndex = nullptr;
 	bool unorderedIndexSort = false;
+	bool distanceSort = false;
 	bool forcedSort = !ctx.query.forcedSortOrder.empty();
 
-	bool enableTiming = ctx.query.debugLevel >= LogInfo;
+	bool enableTiming = ctx.query.debugLevel >= LogInfo || ctx.explain;
 
 	TIMEPOINT(tmStart);
 
-	bool needCalcTotal = ctx.query.calcTotal == ModeAccurateTotal;
+	bool needCalcTotal = ctx.query.calcTotal == ModeAccurateTotal || ctx.query.calcTotal == ModeApproxTotal;
 	bool needPutCachedTotal = false;
 
+	uint64_t queryGeneration = 0;
+	if (ctx.query.calcTotal == ModeCachedTotal || ctx.query.cacheResults) queryGeneration = getQueryGeneration(ctx.query);
+
 	if (ctx.query.calcTotal == ModeCachedTotal) {
 		auto cached = ns_->queryCache_->Get({ctx.query});
-		if (cached.key && cached.val.total_count >= 0) {
+		if (cached.key && cached.val.total_count >= 0 && cached.val.generation == queryGeneration) {
 			result.totalCount = cached.val.total_count;
 			logPrintf(LogTrace, "[*] using value from cache: %d\t namespace: %s\n", result.totalCount, ns_->name_.c_str());
 		} else {
@@ -50,9 +68,38 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 		whereEntries = &tmpWhereEntries;
 	}
 	bool containsFullText = containsFullTextIndexes(*whereEntries);
+	string compositeSortBy;
+
+	QueryCacheKey resultsCacheKey;
+	bool needPutCachedResults = false;
+	if (!containsFullText && isResultsCacheable(ctx, result)) {
+		WrSerializer ser;
+		ctx.query.Serialize(ser);
+		resultsCacheKey = QueryCacheKey(ser);
+		auto cached = ns_->resultsCache_->Get(resultsCacheKey);
+		if (cached.key && cached.val.items && cached.val.generation == queryGeneration) {
+			logPrintf(LogTrace, "[*] using results from cache: %d items\t namespace: %s\n", int(cached.val.items->size()),
+					  ns_->name_.c_str());
+			result.addNSContext(ns_->payloadType_, ns_->tagsMatcher_, JsonPrintFilter(ns_->tagsMatcher_, ctx.query.selectFilter_));
+			// Items could be updated without changing of queried indexes, so take their actual versions
+			for (auto &it : *cached.val.items) {
+				auto &pv = ns_->items_[it.id];
+				result.Add({it.id, pv.GetVersion(), pv, it.proc, it.nsid});
+			}
+			result.totalCount = cached.val.totalCount;
+			result.aggregationResults = cached.val.aggregationResults;
+			result.aggregationFacets = cached.val.aggregationFacets;
+			result.groupedResults = cached.val.groupedResults;
+			return;
+		}
+		needPutCachedResults = (cached.key != nullptr);
+	}
 
 	if (!ctx.skipIndexesLookup) {
-		if (!containsFullText) substituteCompositeIndexes(tmpWhereEntries);
+		if (!containsFullText) {
+			substituteCompositeIndexes(tmpWhereEntries);
+			compositeSortBy = substituteCompositeRanges(tmpWhereEntries, ctx.query.sortBy);
+		}
 		updateCompositeIndexesValues(tmpWhereEntries);
 	} else {
 		// TODO refactor const cast!
@@ -64,9 +111,15 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 	// DO NOT use deducted sort order in the following cases:
 	// - query contains explicity specified sort order
 	// - query contains FullText query.
-	bool disableOptimizeSortOrder = !ctx.query.sortBy.empty() || ctx.preResult;
+	// - query requests approximate total, which is sampled in order of ids.
+	bool disableOptimizeSortOrder =
+		!ctx.query.sortBy.empty() || ctx.preResult || ctx.selectInIdsOrder || ctx.query.calcTotal == ModeApproxTotal;
 
 	auto sortBy = (containsFullText || disableOptimizeSortOrder) ? ctx.query.sortBy : getOptimalSortOrder(*whereEntries);
+	// Sort by last field of composite index, with equal prefix fields, is the same as sort by composite index itself
+	if (!compositeSortBy.empty() && !forcedSort && !ctx.preResult && !ctx.selectInIdsOrder && sortBy == ctx.query.sortBy) {
+		sortBy = compositeSortBy;
+	}
 
 	if (ctx.preResult) {
 		switch (ctx.preResult->mode) {
@@ -83,9 +136,12 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 	}
 
 	// Check if commit needed
-	if (!whereEntries->empty() || !sortBy.empty()) {
+	if (!whereEntries->empty() || !sortBy.empty() || !ctx.query.aggregations_.empty() || !ctx.query.groupBy_.empty()) {
 		FieldsSet prepareIndexes;
 		for (auto &entry : *whereEntries) prepareIndexes.push_back(entry.idxNo);
+		// Facets and groups are counted by idsets of indexes
+		for (auto &ag : ctx.query.aggregations_) prepareIndexes.push_back(ns_->getIndexByName(ag.index_));
+		for (auto &field : ctx.query.groupBy_) prepareIndexes.push_back(ns_->getIndexByName(field));
 		ns_->commit(Namespace::NSCommitContext(*ns_, CommitContext::MakeIdsets | (sortBy.length() ? CommitContext::MakeSortOrders : 0),
 											   &prepareIndexes),
 					ctx.lockUpgrader);
@@ -97,6 +153,8 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 		if ((sortIndex && !sortIndex->IsOrdered()) || containsFullText) {
 			ctx.isForceAll = true;
 			unorderedIndexSort = true;
+			// Sort by point index means sort by distance to point from forcedSortOrder
+			distanceSort = sortIndex->Type() == IndexPointGrid;
 			collateOpts = sortIndex->Opts().collateOpts_;
 			sortIndex = nullptr;
 		}
@@ -217,6 +275,21 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 
 	TIMEPOINT(tm4);
 
+	if (ctx.explain) {
+		auto &explain = *ctx.explain;
+		explain.ns = ns_->name_;
+		explain.prepareTime = duration_cast<microseconds>(tm1 - tmStart).count();
+		explain.selectTime = duration_cast<microseconds>(tm2 - tm1).count();
+		explain.postprocessTime = duration_cast<microseconds>(tm3 - tm2).count();
+		explain.loopTime = duration_cast<microseconds>(tm4 - tm3).count();
+		explain.itemsCount = result.size();
+		explain.sortIndex = sortIndex ? sortIndex->Name() : "";
+		explain.iterators.clear();
+		for (auto &r : qres) {
+			explain.iterators.push_back({r.name, int(r.size()), int(r.comparators_.size()), r.GetMatchedCount(), r.Cost(iters)});
+		}
+	}
+
 	if (ctx.query.debugLevel >= LogInfo) {
 		int count = (ctx.preResult && ctx.preResult->mode == SelectCtx::PreResult::ModeBuild) ? ctx.preResult->ids.size() : result.size();
 		logPrintf(LogInfo, ctx.query.Dump().c_str());
@@ -245,11 +318,13 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 		}
 	}
 
-	if (unorderedIndexSort) {
+	if (distanceSort) {
+		applyDistanceSort(result, ctx);
+	} else if (unorderedIndexSort) {
 		applyGeneralSort(result, ctx, collateOpts);
 	}
 
-	if (!ctx.query.forcedSortOrder.empty()) {
+	if (!ctx.query.forcedSortOrder.empty() && !distanceSort) {
 		applyCustomSort(result, ctx);
 	}
 
@@ -259,7 +334,10 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 
 	if (needPutCachedTotal) {
 		logPrintf(LogTrace, "[*] put totalCount value into query cache: %d\t namespace: %s\n", result.totalCount, ns_->name_.c_str());
-		ns_->queryCache_->Put({ctx.query}, {static_cast<size_t>(result.totalCount)});
+		ns_->queryCache_->Put({ctx.query}, {static_cast<size_t>(result.totalCount), queryGeneration});
+	}
+	if (needPutCachedResults) {
+		ns_->resultsCache_->Put(resultsCacheKey, QueryResultsCacheVal(result, queryGeneration));
 	}
 	if (ctx.preResult && ctx.preResult->mode == SelectCtx::PreResult::ModeBuild) {
 		ctx.preResult->mode = SelectCtx::PreResult::ModeIdSet;
@@ -368,6 +446,46 @@ void NsSelecter::applyGeneralSort(QueryResults &queryResult, const SelectCtx &ct
 					  });
 }
 
+void NsSelecter::applyDistanceSort(QueryResults &queryResult, const SelectCtx &ctx) {
+	if (ctx.query.mergeQueries_.size() > 1) throw Error(errLogic, "Sorting cannot be applied to merged queries.");
+
+	const string &fieldName = ctx.query.sortBy;
+	if (ctx.query.forcedSortOrder.size() != 2) {
+		throw Error(errQueryExec, "Sorting by point field '%s' requires coordinates (x, y) of point to calculate distance",
+					fieldName.c_str());
+	}
+	double coords[2];
+	for (int i = 0; i < 2; i++) {
+		KeyValue v = ctx.query.forcedSortOrder[i];
+		v.convert(KeyValueDouble);
+		coords[i] = static_cast<double>(v);
+	}
+	GeoPoint point{coords[0], coords[1]};
+
+	auto &payloadType = ns_->payloadType_;
+	int fieldIdx = ns_->getIndexByName(fieldName);
+	bool sortAsc = !ctx.query.sortDirDesc;
+
+	// Calculate distance once per item. Items without point go to the end of results
+	vector<pair<double, ItemRef>> items;
+	items.reserve(queryResult.size());
+	KeyRefs krefs;
+	for (auto &it : queryResult) {
+		ConstPayload(payloadType, it.value).Get(fieldIdx, krefs);
+		double key = std::numeric_limits<double>::infinity();
+		if (krefs.size() == 2) {
+			double dist = GeoDistance(point, GeoPoint{static_cast<double>(krefs[0]), static_cast<double>(krefs[1])});
+			key = sortAsc ? dist : -dist;
+		}
+		items.push_back({key, it});
+	}
+
+	int limit = std::min(ctx.query.count + ctx.query.start, queryResult.size());
+	std::partial_sort(items.begin(), items.begin() + limit, items.end(),
+					  [](const pair<double, ItemRef> &lhs, const pair<double, ItemRef> &rhs) { return lhs.first < rhs.first; });
+	for (size_t i = 0; i < items.size(); i++) queryResult[i] = items[i].second;
+}
+
 void NsSelecter::setLimitsAndOffset(QueryResults &queryResult, const SelectCtx &ctx) {
 	unsigned offset = ctx.query.start;
 	unsigned limit = ctx.query.count;
@@ -383,6 +501,29 @@ void NsSelecter::setLimitsAndOffset(QueryResults &queryResult, const SelectCtx &
 	}
 }
 
+uint64_t NsSelecter::getQueryGeneration(const Query &q) {
+	// Generations of items and of indexes are taken from different counters, so they are mixed instead of taking the max of them.
+	// Counters are often changed in lockstep (each upsert changes items and index), so they are combined by multiply-add, not by xor,
+	// which cancels out equal changes of both counters
+	uint64_t generation = ns_->itemsGeneration_;
+	auto indexGeneration = [&](const string &name) {
+		auto it = ns_->indexesNames_.find(name);
+		if (it != ns_->indexesNames_.end()) generation = generation * 1099511628211ULL + ns_->indexes_[it->second]->Generation();
+	};
+	for (auto &qe : q.entries) indexGeneration(qe.index);
+	for (auto &ag : q.aggregations_) indexGeneration(ag.index_);
+	for (auto &field : q.groupBy_) indexGeneration(field);
+	if (!q.sortBy.empty()) indexGeneration(q.sortBy);
+	return generation;
+}
+
+bool NsSelecter::isResultsCacheable(const SelectCtx &ctx, const QueryResults &result) {
+	const Query &q = ctx.query;
+	// Results of joins, merges and select functions depends on other namespaces or are modified after select
+	return q.cacheResults && !ctx.preResult && ctx.nsid == 0 && result.empty() && q.joinQueries_.empty() && q.mergeQueries_.empty() &&
+		   q.selectFunctions_.empty();
+}
+
 bool NsSelecter::containsFullTextIndexes(const QueryEntries &entries) {
 	bool result = false;
 	for (auto &entry : entries) {
@@ -474,8 +615,24 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 		count = sctx.query.count;
 	}
 	auto aggregators = getAggregators(sctx.query);
+	// Facets and groups could be counted by idsets of indexes, so only ids of matched items are needed for them
+	bool grouped = !sctx.query.groupBy_.empty();
+	bool onlyFacets = !aggregators.empty() && !grouped;
+	for (auto &ag : sctx.query.aggregations_) onlyFacets = onlyFacets && ag.type_ == AggFacet;
+	// Sampled aggregations need all matched ids to choose sample from
+	bool sampledAggregations = !onlyFacets && !grouped && sctx.query.aggregationsMaxError > 0;
+	vector<IdType> matchedIds;
+	// Other aggregations are calculated by batches of matched ids
+	auto flushAggregationBatch = [&]() {
+		for (auto &aggregator : aggregators) aggregator.AggregateBatch(matchedIds.data(), matchedIds.size(), ns_->items_);
+		matchedIds.clear();
+	};
 	// do not calc total by loop, if we have only 1 condition with 1 idset
 	bool calcTotal = ctx.calcTotal && (ctx.qres->size() > 1 || haveComparators || (*ctx.qres)[0].size() > 1);
+	// Approximate total is extrapolated by selectivity of conditions on first ids of first iterator, when requested items are selected.
+	// In order of sort index first items are not a fair sample (e.g. all of them match condition by sort field), so total is exact
+	bool approxTotal = calcTotal && sctx.query.calcTotal == ModeApproxTotal && !ctx.ftIndex && !ctx.sortIndex;
+	int iterations = 0, initialTotal = result.totalCount;
 
 	// reserve queryresults, if we have only 1 condition with 1 idset
 	if (ctx.qres->size() == 1 && (*ctx.qres)[0].size() == 1) {
@@ -486,14 +643,24 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 
 	bool finish = (count == 0) && !sctx.reqMatchedOnceFlag && !calcTotal;
 
-	bool haveInnerJoin = false;
+	bool haveInnerJoin = false, haveBatchedJoin = false;
 	if (sctx.joinedSelectors) {
 		for (size_t i = 0; i < sctx.joinedSelectors->size(); i++) {
 			auto &joinedSelector = sctx.joinedSelectors->at(i);
 			haveInnerJoin |= (joinedSelector.type == JoinType::InnerJoin || joinedSelector.type == JoinType::OrInnerJoin);
+			haveBatchedJoin |= bool(joinedSelector.batchFunc);
 		}
 	}
 
+	// Items, matched by query, which are waiting for batched left joins
+	vector<std::pair<IdType, PayloadValue>> joinBatch;
+	auto flushJoinBatch = [&]() {
+		if (joinBatch.empty()) return;
+		for (auto &joinedSelector : *sctx.joinedSelectors)
+			if (joinedSelector.batchFunc) joinedSelector.batchFunc(joinBatch);
+		joinBatch.clear();
+	};
+
 	// TODO: nested conditions support. Like (A  OR B OR C) AND (X OR Z)
 	auto &first = *ctx.qres->begin();
 	IdType val = first.Val();
@@ -502,6 +669,15 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 		val = first.Val();
 		IdType realVal = val;
 
+		if (approxTotal && !start && !count && ++iterations > kApproxTotalSampleSize) {
+			int passed = first.GetPassedIterations(val);
+			if (passed > 0) {
+				double selectivity = double(result.totalCount - initialTotal) / passed;
+				result.totalCount = initialTotal + int(std::round(selectivity * first.GetMaxIterations()));
+				break;
+			}
+		}
+
 		if (haveScan && ns_->items_[realVal].IsFree()) continue;
 		if (haveComparators && ctx.sortIndex) {
 			assert(ctx.sortIndex->SortOrders().size() > static_cast<size_t>(val));
@@ -577,9 +753,14 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 				}
 			}
 			// left join process
-			if (match && found && sctx.joinedSelectors)
+			if (match && found && sctx.joinedSelectors) {
 				for (auto &joinedSelector : *sctx.joinedSelectors)
-					if (joinedSelector.type == JoinType::LeftJoin) joinedSelector.func(realVal, pl, match);
+					if (joinedSelector.type == JoinType::LeftJoin && !joinedSelector.batchFunc) joinedSelector.func(realVal, pl, match);
+				if (haveBatchedJoin) {
+					joinBatch.push_back({realVal, pv});
+					if (joinBatch.size() >= kJoinBatchSize) flushJoinBatch();
+				}
+			}
 		}
 
 		if (found) {
@@ -600,8 +781,11 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 				--count;
 				uint8_t proc = ft_ctx_ ? ft_ctx_->Proc(first.Pos()) : 0;
 
-				if (aggregators.size()) {
-					for (auto &aggregator : aggregators) aggregator.Aggregate(ns_->items_[realVal], realVal);
+				if (onlyFacets || grouped) {
+					matchedIds.push_back(realVal);
+				} else if (aggregators.size()) {
+					matchedIds.push_back(realVal);
+					if (!sampledAggregations && matchedIds.size() >= kAggregationBatchSize) flushAggregationBatch();
 				} else if (sctx.preResult && sctx.preResult->mode == SelectCtx::PreResult::ModeBuild) {
 					sctx.preResult->ids.Add(val, IdSet::Unordered);
 				} else {
@@ -612,8 +796,21 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 			if (calcTotal) result.totalCount++;
 		}
 	}
-	for (auto &aggregator : aggregators) {
-		result.aggregationResults.push_back(aggregator.GetResult());
+	flushJoinBatch();
+	if (grouped) {
+		groupItems(aggregators, matchedIds, sctx.query, result);
+	} else {
+		if (onlyFacets) {
+			countFacets(aggregators, matchedIds, sctx.query);
+		} else if (sampledAggregations) {
+			sampleAggregations(aggregators, matchedIds, sctx.query.aggregationsMaxError);
+		} else {
+			flushAggregationBatch();
+		}
+		for (auto &aggregator : aggregators) {
+			result.aggregationResults.push_back(aggregator.GetResult());
+			result.aggregationFacets.push_back(aggregator.GetFacets());
+		}
 	}
 
 	// Get total count for simple query with 1 condition and 1 idset
@@ -625,13 +822,138 @@ h_vector<Aggregator, 4> NsSelecter::getAggregators(const Query &q) {
 
 	for (auto &ag : q.aggregations_) {
 		int idx = ns_->getIndexByName(ag.index_);
-		ret.push_back(Aggregator(ns_->indexes_[idx]->KeyType(), ns_->indexes_[idx]->Opts().IsArray(), nullptr, ag.type_));
+		if (idx >= ns_->payloadType_->NumFields()) {
+			throw Error(errParams, "Aggregation by composite index '%s' is not supported", ag.index_.c_str());
+		}
+		KeyValueType keyType = ns_->indexes_[idx]->KeyType();
+		if (Aggregator::IsNumeric(ag.type_) && keyType != KeyValueInt && keyType != KeyValueInt64 && keyType != KeyValueDouble) {
+			throw Error(errParams, "Aggregation function of index '%s' requires numeric field", ag.index_.c_str());
+		}
+		auto &index = ns_->indexes_[idx];
+		ret.push_back(Aggregator(index->KeyType(), index->Opts().IsArray(), index->ColumnData(), ag.type_, ag.limit_));
 		ret.back().Bind(ns_->payloadType_, idx);
 	}
 
 	return ret;
 }
 
+void NsSelecter::sampleAggregations(h_vector<Aggregator, 4> &aggregators, vector<IdType> &ids, double maxError) {
+	// Sample is aggregated by chunks, which are distributed between subsamples. Spread of results of subsamples estimates error of result
+	const size_t kChunkSize = 256, kSubsamples = 8;
+	// Student's t for 95% confidence by kSubsamples values
+	const double kT95 = 2.365;
+
+	vector<Aggregator> subsamples;
+	for (auto &aggregator : aggregators) {
+		if (aggregator.CanExtrapolate()) {
+			subsamples.insert(subsamples.end(), kSubsamples, aggregator);
+		} else {
+			aggregator.AggregateBatch(ids.data(), ids.size(), ns_->items_);
+		}
+	}
+	if (subsamples.empty()) return;
+
+	auto withinError = [&](const size_t *counts) {
+		for (size_t i = 0; i < subsamples.size(); i += kSubsamples) {
+			double mean = 0, means[kSubsamples];
+			for (size_t j = 0; j < kSubsamples; ++j) {
+				means[j] = subsamples[i + j].GetMeanResult(counts[j]);
+				mean += means[j] / kSubsamples;
+			}
+			double variance = 0;
+			for (auto m : means) variance += (m - mean) * (m - mean) / (kSubsamples - 1);
+			if (kT95 * std::sqrt(variance / kSubsamples) > maxError * std::abs(mean)) return false;
+		}
+		return true;
+	};
+
+	std::mt19937 rnd(ids.size());
+	size_t counts[kSubsamples] = {0}, sampled = 0;
+	for (size_t chunk = 0; sampled < ids.size(); ++chunk) {
+		size_t n = std::min(kChunkSize, ids.size() - sampled);
+		// Partial Fisher-Yates shuffle: random ids of not sampled yet are moved to chunk
+		for (size_t i = sampled; i < sampled + n; ++i) std::swap(ids[i], ids[i + rnd() % (ids.size() - i)]);
+		size_t sub = chunk % kSubsamples;
+		for (size_t i = sub; i < subsamples.size(); i += kSubsamples) subsamples[i].AggregateBatch(ids.data() + sampled, n, ns_->items_);
+		counts[sub] += n;
+		sampled += n;
+		if (sub == kSubsamples - 1 && withinError(counts)) break;
+	}
+
+	auto subsample = subsamples.begin();
+	for (auto &aggregator : aggregators) {
+		if (!aggregator.CanExtrapolate()) continue;
+		for (size_t j = 0; j < kSubsamples; ++j) aggregator.Merge(*subsample++);
+		aggregator.Extrapolate(double(ids.size()) / sampled);
+	}
+}
+
+void NsSelecter::countFacets(h_vector<Aggregator, 4> &aggregators, const vector<IdType> &ids, const Query &q) {
+	// Idsets of all keys are scanned, so for small results it's cheaper to read values from payloads
+	bool byIdsets = ids.size() * kFacetRowScanCost >= ns_->items_.size();
+	vector<uint64_t> filter;
+	if (byIdsets) filter = idsFilter(ids);
+	const uint64_t *bits = filter.empty() ? nullptr : filter.data();
+
+	for (size_t i = 0; i < aggregators.size(); ++i) {
+		auto &aggregator = aggregators[i];
+		auto &index = ns_->indexes_[ns_->getIndexByName(q.aggregations_[i].index_)];
+		if (byIdsets && index->ForEachKey([&aggregator, bits](const KeyRef &key, IdSetRef keyIds) {
+				int count = keyIds.size();
+				if (bits) {
+					// Branchless test of bits, so loop is not slowed down by mispredictions on random filters
+					count = 0;
+					for (auto id : keyIds) count += (bits[id >> 6] >> (id & 63)) & 1;
+				}
+				if (count) aggregator.AggregateFacet(key, count);
+			})) {
+			continue;
+		}
+		for (auto id : ids) aggregator.Aggregate(ns_->items_[id], id);
+	}
+}
+
+void NsSelecter::groupItems(const h_vector<Aggregator, 4> &aggregators, const vector<IdType> &ids, const Query &q, QueryResults &result) {
+	h_vector<int, 1> fields;
+	for (auto &field : q.groupBy_) {
+		int idx = ns_->getIndexByName(field);
+		// Idsets of sparse index don't contain items without field, so such items would be lost by groups from idsets
+		if (idx >= ns_->payloadType_->NumFields() || ns_->indexes_[idx]->Opts().IsArray() || ns_->indexes_[idx]->Opts().IsSparse()) {
+			throw Error(errParams, "Group by composite, sparse or array index '%s' is not supported", field.c_str());
+		}
+		fields.push_back(idx);
+	}
+
+	GroupBy groupBy(ns_->payloadType_, fields, aggregators);
+	// Items, grouped by one indexed field, are taken from idsets of index keys, so keys of items are not read and hashed
+	bool byIdsets = false;
+	if (fields.size() == 1 && ids.size() * kFacetRowScanCost >= ns_->items_.size()) {
+		vector<uint64_t> filter = idsFilter(ids);
+		byIdsets = ns_->indexes_[fields[0]]->ForEachKey([&](const KeyRef &key, IdSetRef keyIds) {
+			groupBy.AddGroup(key, keyIds, filter.empty() ? nullptr : &filter, ns_->items_);
+		});
+	}
+	if (!byIdsets) {
+		for (auto id : ids) groupBy.Add(ns_->items_[id], id);
+	}
+
+	auto &res = result.groupedResults;
+	res.fields = q.groupBy_;
+	for (auto &ag : q.aggregations_) {
+		res.aggTypes.push_back(ag.type_);
+		res.aggFields.push_back(ag.index_);
+	}
+	groupBy.GetResults(res);
+}
+
+vector<uint64_t> NsSelecter::idsFilter(const vector<IdType> &ids) {
+	vector<uint64_t> filter;
+	if (ids.size() == ns_->items_.size() - ns_->free_.size()) return filter;
+	filter.resize((ns_->items_.size() + 63) / 64);
+	for (auto id : ids) filter[id >> 6] |= uint64_t(1) << (id & 63);
+	return filter;
+}
+
 void NsSelecter::substituteCompositeIndexes(QueryEntries &entries) {
 	FieldsSet fields;
 	for (auto cur = entries.begin(), first = entries.begin(); cur != entries.end(); cur++) {
@@ -665,6 +987,181 @@ void NsSelecter::substituteCompositeIndexes(QueryEntries &entries) {
 	}
 }
 
+// Move bound of range to next/previous value, to make it inclusive
+template <typename T>
+static bool stepRangeBound(T &v, bool up) {
+	if (v == (up ? std::numeric_limits<T>::max() : std::numeric_limits<T>::lowest())) return false;
+	up ? v++ : v--;
+	return true;
+}
+
+static bool stepRangeBound(double &v, bool up) {
+	// There are no values beyond infinities, and step from infinity would not exclude it
+	if (std::isinf(v)) return false;
+	v = std::nextafter(v, up ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity());
+	return true;
+}
+
+// Convert numeric value of condition to type of field. False, if value is not numeric, or it is changed by conversion
+static bool convertToFieldType(const KeyValue &value, KeyValueType type, KeyValue &converted) {
+	KeyValueType t = value.Type();
+	if (t != KeyValueInt && t != KeyValueInt64 && t != KeyValueDouble) return false;
+	converted = value;
+	converted.convert(type);
+	KeyValue back(converted);
+	back.convert(t);
+	return back == value;
+}
+
+// Whole range of type. Range of double includes infinities
+template <typename T>
+static T minRangeBound() {
+	return std::numeric_limits<T>::lowest();
+}
+template <typename T>
+static T maxRangeBound() {
+	return std::numeric_limits<T>::max();
+}
+template <>
+double minRangeBound<double>() {
+	return -std::numeric_limits<double>::infinity();
+}
+template <>
+double maxRangeBound<double>() {
+	return std::numeric_limits<double>::infinity();
+}
+
+// Get inclusive bounds [lo, hi] of condition on field. Absent condition means whole range of type
+template <typename T>
+static bool compositeRangeBounds(const QueryEntry *range, KeyValueType type, KeyRef &lo, KeyRef &hi) {
+	T l = minRangeBound<T>(), h = maxRangeBound<T>();
+	if (range) {
+		KeyValue v[2];
+		for (size_t i = 0; i < range->values.size(); ++i) {
+			if (!convertToFieldType(range->values[i], type, v[i])) return false;
+		}
+		switch (range->condition) {
+			case CondLt:
+				h = T(v[0]);
+				if (!stepRangeBound(h, false)) return false;
+				break;
+			case CondLe:
+				h = T(v[0]);
+				break;
+			case CondGt:
+				l = T(v[0]);
+				if (!stepRangeBound(l, true)) return false;
+				break;
+			case CondGe:
+				l = T(v[0]);
+				break;
+			case CondRange:
+				l = T(v[0]);
+				h = T(v[1]);
+				break;
+			default:
+				return false;
+		}
+	}
+	lo = KeyRef(l);
+	hi = KeyRef(h);
+	return true;
+}
+
+// Replace equal conditions on leading fields of numeric composite btree index, and optional range condition on it's last field
+// with single range condition on composite index. Returns name of composite index, if it can be used instead of sortBy index
+string NsSelecter::substituteCompositeRanges(QueryEntries &entries, const string &sortBy) {
+	string ret;
+	auto findEntry = [&entries](int idxNo, bool eq) -> int {
+		for (size_t i = 0; i < entries.size(); i++) {
+			const QueryEntry &e = entries[i];
+			if (e.idxNo != idxNo || e.op != OpAnd || e.distinct) continue;
+			if (i + 1 < entries.size() && entries[i + 1].op == OpOr) continue;
+			if (eq ? (e.condition == CondEq && e.values.size() == 1)
+				   : ((e.condition == CondRange && e.values.size() == 2) ||
+					  ((e.condition == CondLt || e.condition == CondLe || e.condition == CondGt || e.condition == CondGe) &&
+					   e.values.size() == 1)))
+				return i;
+		}
+		return -1;
+	};
+
+	for (size_t f = ns_->payloadType_->NumFields(); f < ns_->indexes_.size(); f++) {
+		const Index &index = *ns_->indexes_[f];
+		const FieldsSet &fields = index.Fields();
+		if (index.Type() != IndexCompositeBTree || fields.size() < 2) continue;
+
+		// Only numeric fields: string keys in payload does not hold references to query values
+		bool numeric = true;
+		for (int field : fields) {
+			const PayloadFieldType &fieldType = ns_->payloadType_->Field(field);
+			KeyValueType t = fieldType.Type();
+			numeric = numeric && !fieldType.IsArray() && (t == KeyValueInt || t == KeyValueInt64 || t == KeyValueDouble);
+		}
+		if (!numeric) continue;
+
+		h_vector<int, 4> matched;
+		for (size_t i = 0; i + 1 < fields.size(); i++) {
+			int e = findEntry(fields[i], true);
+			if (e < 0) break;
+			matched.push_back(e);
+		}
+		if (matched.size() != fields.size() - 1) continue;
+
+		int last = fields[fields.size() - 1];
+		bool sortMatch = !sortBy.empty() && sortBy == ns_->indexes_[last]->Name();
+		int rangeIdx = findEntry(last, false);
+		if (rangeIdx < 0 && !sortMatch) continue;
+		const QueryEntry *range = (rangeIdx >= 0) ? &entries[rangeIdx] : nullptr;
+
+		KeyRef lo(0), hi(0);
+		bool ok = false;
+		KeyValueType lastType = ns_->payloadType_->Field(last).Type();
+		switch (lastType) {
+			case KeyValueInt:
+				ok = compositeRangeBounds<int>(range, lastType, lo, hi);
+				break;
+			case KeyValueInt64:
+				ok = compositeRangeBounds<int64_t>(range, lastType, lo, hi);
+				break;
+			case KeyValueDouble:
+				ok = compositeRangeBounds<double>(range, lastType, lo, hi);
+				break;
+			default:
+				break;
+		}
+		// Values of equal conditions are set to payload fields, so they must have types of fields
+		h_vector<KeyValue, 4> eqValues;
+		eqValues.resize(matched.size());
+		for (size_t i = 0; i < matched.size() && ok; i++) {
+			ok = convertToFieldType(entries[matched[i]].values[0], ns_->payloadType_->Field(fields[i]).Type(), eqValues[i]);
+		}
+		if (!ok) continue;
+
+		PayloadValue dlo(ns_->payloadType_.TotalSize()), dhi(ns_->payloadType_.TotalSize());
+		Payload plo(ns_->payloadType_, dlo), phi(ns_->payloadType_, dhi);
+		for (size_t i = 0; i < matched.size(); i++) {
+			KeyRefs kr;
+			kr.push_back(KeyRef(eqValues[i]));
+			plo.Set(fields[i], kr);
+			phi.Set(fields[i], kr);
+		}
+		plo.Set(last, KeyRefs{lo});
+		phi.Set(last, KeyRefs{hi});
+
+		if (rangeIdx >= 0) matched.push_back(rangeIdx);
+		std::sort(matched.begin(), matched.end(), std::greater<int>());
+		for (int e : matched) entries.erase(entries.begin() + e);
+
+		QueryEntry ce(OpAnd, CondRange, index.Name(), f);
+		ce.values.push_back(KeyValue(dlo));
+		ce.values.push_back(KeyValue(dhi));
+		entries.push_back(std::move(ce));
+		if (sortMatch && ret.empty()) ret = index.Name();
+	}
+	return ret;
+}
+
 void NsSelecter::updateCompositeIndexesValues(QueryEntries &qentries) {
 	for (QueryEntry &qe : qentries) {
 		if (qe.idxNo >= ns_->payloadType_.NumFields()) {
@@ -2,6 +2,7 @@
 #include <functional>
 #include "core/aggregator.h"
 #include "core/nsselecter/selectiterator.h"
+#include "core/perfstat.h"
 #include "core/query/query.h"
 #include "core/query/queryresults.h"
 #include "core/selectfunc/ctx/basefunctionctx.h"
@@ -19,6 +20,8 @@ struct JoinedSelector {
 	std::function<bool(IdType, ConstPayload, bool)> func;
 	int called, matched;
 	string ns;
+	// Joins batch of items of main namespace at once. Could be set only for left joins, which do not filter items of main namespace
+	std::function<void(const vector<std::pair<IdType, PayloadValue>> &)> batchFunc;
 };
 typedef vector<JoinedSelector> JoinedSelectors;
 
@@ -36,8 +39,12 @@ struct SelectCtx {
 	uint8_t nsid = 0;
 	bool isForceAll = false;
 	bool skipIndexesLookup = false;
+	// Select items in order of ids, without deducted sort order. Used to push down limit of merged queries
+	bool selectInIdsOrder = false;
 	SelectLockUpgrader *lockUpgrader;
 	SelectFunctionsHolder *functions = nullptr;
+	// If set, plan and timings of select are collected to it
+	SelectExplain *explain = nullptr;
 	struct PreResult {
 		enum Mode { ModeBuild, ModeIterators, ModeIdSet };
 
@@ -74,13 +81,26 @@ private:
 	void selectLoop(LoopCtx &ctx, QueryResults &result);
 	void applyCustomSort(QueryResults &result, const SelectCtx &ctx);
 	void applyGeneralSort(QueryResults &result, const SelectCtx &ctx, const CollateOpts &collateOpts);
+	void applyDistanceSort(QueryResults &result, const SelectCtx &ctx);
 
 	bool containsFullTextIndexes(const QueryEntries &entries);
+	// Max generation of items set and indexes, used by query. Cached results of query are valid, while it's not changed
+	uint64_t getQueryGeneration(const Query &q);
+	bool isResultsCacheable(const SelectCtx &ctx, const QueryResults &result);
 	void selectWhere(const QueryEntries &entries, RawQueryResult &result, SortType sortId, bool is_ft);
 	QueryEntries lookupQueryIndexes(const QueryEntries &entries);
 	void substituteCompositeIndexes(QueryEntries &entries);
+	string substituteCompositeRanges(QueryEntries &entries, const string &sortBy);
 	const string &getOptimalSortOrder(const QueryEntries &entries);
 	h_vector<Aggregator, 4> getAggregators(const Query &q);
+	// Calculate SUM, AVG and COUNT by random sample of matched items with maxError relative error, other aggregations by all items
+	void sampleAggregations(h_vector<Aggregator, 4> &aggregators, vector<IdType> &ids, double maxError);
+	// Count facets of matched items by idsets of indexes, or by payloads, if it's cheaper
+	void countFacets(h_vector<Aggregator, 4> &aggregators, const vector<IdType> &ids, const Query &q);
+	// Aggregate matched items by groups of GROUP BY
+	void groupItems(const h_vector<Aggregator, 4> &aggregators, const vector<IdType> &ids, const Query &q, QueryResults &result);
+	// Bitmap of matched items for intersection with idsets of indexes. Empty, if all items are matched
+	vector<uint64_t> idsFilter(const vector<IdType> &ids);
 	int getCompositeIndex(const FieldsSet &fieldsmask);
 	bool mergeQueryEntries(QueryEntry *lhs, QueryEntry *rhs);
 	void setLimitsAndOffset(QueryResults &result, const SelectCtx &ctx);
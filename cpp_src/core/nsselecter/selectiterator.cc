@@ -224,4 +224,19 @@ int SelectIterator::GetMaxIterations() const {
 	return cnt;
 }
 
+int SelectIterator::GetPassedIterations(IdType val) const {
+	int cnt = 0;
+	for (auto &r : *this) {
+		if (r.isRange_) {
+			int passed = reverse_ ? r.rEnd_ - 1 - val : val - r.rBegin_;
+			cnt += std::max(0, std::min(passed, r.rEnd_ - r.rBegin_));
+		} else if (reverse_) {
+			cnt += r.ids_.end() - std::upper_bound(r.ids_.begin(), r.ids_.end(), val);
+		} else {
+			cnt += std::lower_bound(r.ids_.begin(), r.ids_.end(), val) - r.ids_.begin();
+		}
+	}
+	return cnt;
+}
+
 }  // namespace reindexer
@@ -74,6 +74,8 @@ public:
 	void AppendAndBind(SelectKeyResult &other, PayloadType type, int field);
 	double Cost(int totalIds) const;
 	int GetMaxIterations() const;
+	// Count of ids, which are iterated before val in direction of iteration
+	int GetPassedIterations(IdType val) const;
 	void SetExpectMaxIterations(int expectedIterations_);
 
 	OpType op;
@@ -198,6 +198,39 @@ size_t PayloadIface<T>::GetHash(const FieldsSet &fields) const {
 	return ret;
 }
 
+template <typename T>
+void PayloadIface<T>::GetCompositeKeys(const FieldsSet &fields, h_vector<PayloadValue, 1> &keys) const {
+	keys.clear();
+	bool hasArrays = false;
+	for (auto field : fields) hasArrays = hasArrays || t_.Field(field).IsArray();
+	if (!hasArrays) {
+		keys.push_back(*v_);
+		return;
+	}
+
+	h_vector<KeyRefs, 4> values;
+	h_vector<int, 4> pos;
+	size_t count = 1;
+	for (auto field : fields) {
+		KeyRefs krefs;
+		values.push_back(KeyRefs());
+		pos.push_back(0);
+		// Duplicated elements of array would produce duplicated keys
+		for (auto &kref : Get(field, krefs))
+			if (std::find(values.back().begin(), values.back().end(), kref) == values.back().end()) values.back().push_back(kref);
+		count *= values.back().size();
+	}
+
+	for (size_t n = 0; n < count; ++n) {
+		PayloadValue key(t_.TotalSize());
+		PayloadIface<PayloadValue> pl(t_, key);
+		for (size_t i = 0; i < fields.size(); ++i) pl.Set(fields[i], KeyRefs{values[i][pos[i]]});
+		keys.push_back(std::move(key));
+		// Move to next combination
+		for (size_t i = 0; i < fields.size() && ++pos[i] == int(values[i].size()); ++i) pos[i] = 0;
+	}
+}
+
 template <typename T>
 bool PayloadIface<T>::IsEQ(const T &other, const FieldsSet &fields) const {
 	PayloadIface<const T> o(t_, other);
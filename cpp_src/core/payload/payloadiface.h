@@ -61,6 +61,10 @@ public:
 	// Compare is EQ
 	bool IsEQ(const T &other) const;
 
+	// Get keys of composite index by fields. Each combination of array fields elements is a separate key,
+	// array fields of such keys contain single element. Payload without array fields is the only key itself
+	void GetCompositeKeys(const FieldsSet &fields, h_vector<PayloadValue, 1> &keys) const;
+
 	// Compare 2 objects by field mask
 	int Compare(const T &other, const FieldsSet &fields, const CollateOpts &collateOpts = CollateOpts()) const;
 
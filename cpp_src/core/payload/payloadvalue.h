@@ -50,6 +50,7 @@ public:
 	uint8_t *Ptr() const { return p_ + sizeof(dataHeader); }
 	void SetVersion(int version) { header()->version = static_cast<int16_t>(version); }
 	int GetVersion() const { return header()->version; }
+	size_t GetCapacity() const { return header()->cap; }
 	bool IsFree() const { return bool(p_ == nullptr); }
 	void Free() { release(); }
 
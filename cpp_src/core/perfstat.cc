@@ -0,0 +1,255 @@
+#include "perfstat.h"
+#include <algorithm>
+#include "core/query/query.h"
+#include "tools/serializer.h"
+
+namespace reindexer {
+
+static std::string escapePrometheusLabel(const std::string &val) {
+	std::string ret;
+	ret.reserve(val.size());
+	for (char c : val) {
+		switch (c) {
+			case '\\':
+				ret += "\\\\";
+				break;
+			case '"':
+				ret += "\\\"";
+				break;
+			case '\n':
+				ret += "\\n";
+				break;
+			default:
+				ret += c;
+		}
+	}
+	return ret;
+}
+
+void LatencyStat::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"count\":%llu,", static_cast<unsigned long long>(count));
+	ser.Printf("\"total_time_us\":%llu,", static_cast<unsigned long long>(totalTime));
+	ser.Printf("\"avg_time_us\":%llu,", static_cast<unsigned long long>(count ? totalTime / count : 0));
+	ser.Printf("\"max_time_us\":%llu,", static_cast<unsigned long long>(maxTime));
+	ser.Printf("\"p50_us\":%llu,", static_cast<unsigned long long>(p50));
+	ser.Printf("\"p90_us\":%llu,", static_cast<unsigned long long>(p90));
+	ser.Printf("\"p99_us\":%llu,", static_cast<unsigned long long>(p99));
+	ser.Printf("\"p999_us\":%llu", static_cast<unsigned long long>(p999));
+	ser.PutChar('}');
+}
+
+void LatencyStat::GetPrometheus(WrSerializer &ser, const char *metric, const std::string &labels) const {
+	const std::pair<const char *, uint64_t> quantiles[] = {{"0.5", p50}, {"0.9", p90}, {"0.99", p99}, {"0.999", p999}};
+	for (auto &q : quantiles) {
+		ser.Printf("%s{%s,quantile=\"%s\"} %llu\n", metric, labels.c_str(), q.first, static_cast<unsigned long long>(q.second));
+	}
+	ser.Printf("%s_sum{%s} %llu\n", metric, labels.c_str(), static_cast<unsigned long long>(totalTime));
+	ser.Printf("%s_count{%s} %llu\n", metric, labels.c_str(), static_cast<unsigned long long>(count));
+}
+
+LatencyHistogram::LatencyHistogram() : count_(0), total_(0), max_(0) {
+	for (auto &b : buckets_) b.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::bucketOf(uint64_t us) {
+	if (us < kSubBuckets) return int(us);
+	if (us >= (uint64_t(1) << kMaxBits)) us = (uint64_t(1) << kMaxBits) - 1;
+	int msb = 63 - __builtin_clzll(us);
+	int shift = msb - kSubBucketBits;
+	return (shift + 1) * kSubBuckets + int((us >> shift) & (kSubBuckets - 1));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int bucket) {
+	if (bucket < kSubBuckets) return uint64_t(bucket);
+	int shift = bucket / kSubBuckets - 1;
+	uint64_t lower = uint64_t(kSubBuckets + bucket % kSubBuckets) << shift;
+	return lower + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t us) {
+	buckets_[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+	count_.fetch_add(1, std::memory_order_relaxed);
+	total_.fetch_add(us, std::memory_order_relaxed);
+	uint64_t max = max_.load(std::memory_order_relaxed);
+	while (us > max && !max_.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+	}
+}
+
+LatencyStat LatencyHistogram::GetStat() const {
+	LatencyStat stat;
+	uint64_t counts[kBuckets];
+	// Buckets are updated concurrently, so take count from the buckets snapshot to get consistent percentiles
+	for (int i = 0; i < kBuckets; i++) {
+		counts[i] = buckets_[i].load(std::memory_order_relaxed);
+		stat.count += counts[i];
+	}
+	stat.totalTime = total_.load(std::memory_order_relaxed);
+	stat.maxTime = max_.load(std::memory_order_relaxed);
+	if (!stat.count) return stat;
+
+	const std::pair<double, uint64_t *> percentiles[] = {{0.5, &stat.p50}, {0.9, &stat.p90}, {0.99, &stat.p99}, {0.999, &stat.p999}};
+	uint64_t seen = 0;
+	int bucket = 0;
+	for (auto &p : percentiles) {
+		uint64_t rank = std::max(uint64_t(1), uint64_t(p.first * stat.count + 0.5));
+		while (bucket < kBuckets - 1 && seen + counts[bucket] < rank) seen += counts[bucket++];
+		*p.second = std::min(bucketUpperBound(bucket), stat.maxTime);
+	}
+	return stat;
+}
+
+void NamespacePerfCounters::RecordSelect(const Query &q, uint64_t us) {
+	selects_.Record(us);
+	uint64_t hash = q.ShapeHash();
+	{
+		shared_lock<shared_timed_mutex> lck(mtx_);
+		auto it = queries_.find(hash);
+		if (it != queries_.end()) {
+			it->second->latency.Record(us);
+			return;
+		}
+		if (queries_.size() >= kMaxQueryShapes) return;
+	}
+	// Dump is built out of lock, it may be built twice by concurrent selects of the same new shape
+	std::unique_ptr<QueryCounters> counters(new QueryCounters);
+	counters->shape = q.Dump(true);
+	std::unique_lock<shared_timed_mutex> lck(mtx_);
+	if (queries_.size() >= kMaxQueryShapes) return;
+	auto &entry = queries_[hash];
+	if (!entry) entry = std::move(counters);
+	entry->latency.Record(us);
+}
+
+NamespacePerfStat NamespacePerfCounters::GetStat(const std::string &nsName) {
+	NamespacePerfStat stat;
+	stat.name = nsName;
+	stat.selects = selects_.GetStat();
+	stat.upserts = upserts_.GetStat();
+	stat.deletes = deletes_.GetStat();
+	stat.commits = commits_.GetStat();
+	stat.flushes = flushes_.GetStat();
+
+	shared_lock<shared_timed_mutex> lck(mtx_);
+	stat.queries.reserve(queries_.size());
+	for (auto &q : queries_) stat.queries.push_back({q.second->shape, q.second->latency.GetStat()});
+	lck.unlock();
+
+	std::sort(stat.queries.begin(), stat.queries.end(),
+			  [](const QueryPerfStat &lhs, const QueryPerfStat &rhs) { return lhs.latency.totalTime > rhs.latency.totalTime; });
+	return stat;
+}
+
+void NamespacePerfStat::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"name\":\"%s\",", name.c_str());
+	ser.Printf("\"items_count\":%zu,", itemsCount);
+	ser.PutChars("\"selects\":");
+	selects.GetJSON(ser);
+	ser.PutChars(",\"upserts\":");
+	upserts.GetJSON(ser);
+	ser.PutChars(",\"deletes\":");
+	deletes.GetJSON(ser);
+	ser.PutChars(",\"commits\":");
+	commits.GetJSON(ser);
+	ser.PutChars(",\"flushes\":");
+	flushes.GetJSON(ser);
+	ser.PutChars(",\"queries\":[");
+	for (size_t i = 0; i < queries.size(); i++) {
+		if (i != 0) ser.PutChar(',');
+		ser.PutChars("{\"query\":");
+		ser.PrintJsonString(queries[i].shape);
+		ser.PutChars(",\"latency\":");
+		queries[i].latency.GetJSON(ser);
+		ser.PutChar('}');
+	}
+	ser.PutChars("]}");
+}
+
+void NamespacePerfStat::GetPrometheus(WrSerializer &ser, const std::vector<NamespacePerfStat> &stats,
+									  const std::vector<std::string> &dbNames) {
+	std::vector<std::string> nsLabels;
+	nsLabels.reserve(stats.size());
+	for (size_t i = 0; i < stats.size(); i++) {
+		std::string db = i < dbNames.size() ? "db=\"" + escapePrometheusLabel(dbNames[i]) + "\"," : std::string();
+		nsLabels.push_back(db + "ns=\"" + stats[i].name + "\"");
+	}
+
+	ser.PutChars("# TYPE reindexer_ns_items gauge\n");
+	for (size_t i = 0; i < stats.size(); i++) ser.Printf("reindexer_ns_items{%s} %zu\n", nsLabels[i].c_str(), stats[i].itemsCount);
+	ser.PutChars("# TYPE reindexer_ns_latency_us summary\n");
+	for (size_t i = 0; i < stats.size(); i++) {
+		auto &stat = stats[i];
+		const std::pair<const char *, const LatencyStat *> ops[] = {{"select", &stat.selects}, {"upsert", &stat.upserts},
+																	{"delete", &stat.deletes}, {"commit", &stat.commits},
+																	{"flush", &stat.flushes}};
+		for (auto &op : ops) op.second->GetPrometheus(ser, "reindexer_ns_latency_us", nsLabels[i] + ",op=\"" + op.first + "\"");
+	}
+	ser.PutChars("# TYPE reindexer_query_latency_us summary\n");
+	for (size_t i = 0; i < stats.size(); i++) {
+		for (auto &q : stats[i].queries) {
+			q.latency.GetPrometheus(ser, "reindexer_query_latency_us", nsLabels[i] + ",query=\"" + escapePrometheusLabel(q.shape) + "\"");
+		}
+	}
+}
+
+void SelectExplain::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"namespace\":\"%s\",", ns.c_str());
+	ser.Printf("\"prepare_us\":%llu,", static_cast<unsigned long long>(prepareTime));
+	ser.Printf("\"select_us\":%llu,", static_cast<unsigned long long>(selectTime));
+	ser.Printf("\"postprocess_us\":%llu,", static_cast<unsigned long long>(postprocessTime));
+	ser.Printf("\"loop_us\":%llu,", static_cast<unsigned long long>(loopTime));
+	ser.Printf("\"items_count\":%d,", itemsCount);
+	ser.Printf("\"sort_index\":\"%s\",", sortIndex.c_str());
+	ser.PutChars("\"iterators\":[");
+	for (size_t i = 0; i < iterators.size(); i++) {
+		auto &it = iterators[i];
+		if (i != 0) ser.PutChar(',');
+		ser.Printf("{\"name\":\"%s\",\"idsets\":%d,\"comparators\":%d,\"cost\":%g,\"matched\":%d}", it.name.c_str(), it.idsets,
+				   it.comparators, it.cost, it.matched);
+	}
+	ser.PutChars("]}");
+}
+
+void SlowQueryEntry::GetJSON(WrSerializer &ser) const {
+	ser.PutChar('{');
+	ser.Printf("\"time\":%lld,", static_cast<long long>(time));
+	ser.PutChars("\"query\":");
+	ser.PrintJsonString(query);
+	ser.PutChars(",\"shape\":");
+	ser.PrintJsonString(shape);
+	ser.Printf(",\"total_us\":%llu,", static_cast<unsigned long long>(totalTime));
+	ser.Printf("\"items_count\":%zu,", itemsCount);
+	ser.PutChars("\"explain\":");
+	explain.GetJSON(ser);
+	ser.PutChar('}');
+}
+
+void SlowQueryLog::Configure(uint64_t thresholdUs, size_t maxEntries) {
+	std::lock_guard<std::mutex> lck(mtx_);
+	threshold_.store(thresholdUs, std::memory_order_relaxed);
+	maxEntries_ = std::max(maxEntries, size_t(1));
+	entries_.clear();
+	pos_ = 0;
+}
+
+void SlowQueryLog::Add(SlowQueryEntry &&entry) {
+	std::lock_guard<std::mutex> lck(mtx_);
+	if (entries_.size() < maxEntries_) {
+		entries_.push_back(std::move(entry));
+	} else {
+		entries_[pos_] = std::move(entry);
+	}
+	pos_ = (pos_ + 1) % maxEntries_;
+}
+
+std::vector<SlowQueryEntry> SlowQueryLog::Get() {
+	std::lock_guard<std::mutex> lck(mtx_);
+	std::vector<SlowQueryEntry> ret;
+	ret.reserve(entries_.size());
+	for (size_t i = 0; i < entries_.size(); i++) ret.push_back(entries_[(pos_ + entries_.size() - 1 - i) % entries_.size()]);
+	return ret;
+}
+
+}  // namespace reindexer
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "estl/shared_mutex.h"
+
+namespace reindexer {
+
+class WrSerializer;
+class Query;
+
+// Summary of latencies. All times are in microseconds
+struct LatencyStat {
+	void GetJSON(WrSerializer &ser) const;
+	// Put metric in prometheus summary format. 'labels' is comma separated list of labels, e.g. ns="items",op="select"
+	void GetPrometheus(WrSerializer &ser, const char *metric, const std::string &labels) const;
+
+	uint64_t count = 0;
+	uint64_t totalTime = 0;
+	uint64_t maxTime = 0;
+	uint64_t p50 = 0, p90 = 0, p99 = 0, p999 = 0;
+};
+
+// Lock free latency histogram with log-linear buckets (HDR style).
+// Values are grouped by power of 2, and each power of 2 is split to kSubBuckets linear sub buckets,
+// so relative error of percentiles does not exceed 1/kSubBuckets.
+class LatencyHistogram {
+public:
+	LatencyHistogram();
+	LatencyHistogram(const LatencyHistogram &) = delete;
+	LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+	void Record(uint64_t us);
+	LatencyStat GetStat() const;
+	uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+	uint64_t TotalTime() const { return total_.load(std::memory_order_relaxed); }
+
+protected:
+	enum { kSubBucketBits = 3, kSubBuckets = 1 << kSubBucketBits, kMaxBits = 40, kBuckets = (kMaxBits - kSubBucketBits + 1) * kSubBuckets };
+
+	static int bucketOf(uint64_t us);
+	// Highest value, which falls into bucket
+	static uint64_t bucketUpperBound(int bucket);
+
+	std::atomic<uint64_t> buckets_[kBuckets];
+	std::atomic<uint64_t> count_, total_, max_;
+};
+
+struct QueryPerfStat {
+	// Query with values replaced by '?'
+	std::string shape;
+	LatencyStat latency;
+};
+
+struct NamespacePerfStat {
+	void GetJSON(WrSerializer &ser) const;
+	// Put stats of namespaces in prometheus text format. Samples of each metric are grouped together, as format requires.
+	// 'dbNames' - optional names of databases of each namespace, added as 'db' label
+	static void GetPrometheus(WrSerializer &ser, const std::vector<NamespacePerfStat> &stats,
+							  const std::vector<std::string> &dbNames = std::vector<std::string>());
+
+	std::string name;
+	LatencyStat selects;
+	LatencyStat upserts;
+	LatencyStat deletes;
+	LatencyStat commits;
+	// Latencies of namespace updates flushes to storage
+	LatencyStat flushes;
+	size_t itemsCount = 0;
+	// Queries stats, ordered by total execution time
+	std::vector<QueryPerfStat> queries;
+};
+
+// Latency counters of namespace operations
+class NamespacePerfCounters {
+public:
+	// Max count of tracked query shapes. Queries with new shapes are not tracked after limit is reached
+	enum { kMaxQueryShapes = 256 };
+
+	// Record latency of select. Shape of query is looked up by its hash, and dump of query is built only for new shapes
+	void RecordSelect(const Query &q, uint64_t us);
+	void RecordUpsert(uint64_t us) { upserts_.Record(us); }
+	void RecordDelete(uint64_t us) { deletes_.Record(us); }
+	void RecordCommit(uint64_t us) { commits_.Record(us); }
+	void RecordFlush(uint64_t us) { flushes_.Record(us); }
+
+	NamespacePerfStat GetStat(const std::string &nsName);
+
+protected:
+	struct QueryCounters {
+		std::string shape;
+		LatencyHistogram latency;
+	};
+
+	LatencyHistogram selects_, upserts_, deletes_, commits_, flushes_;
+	// Counters of query shapes by hashes of shapes
+	std::unordered_map<uint64_t, std::unique_ptr<QueryCounters>> queries_;
+	shared_timed_mutex mtx_;
+};
+
+// Plan and timing breakdown of select from single namespace
+struct SelectExplain {
+	void GetJSON(WrSerializer &ser) const;
+
+	struct Iterator {
+		std::string name;
+		int idsets, comparators, matched;
+		double cost;
+	};
+
+	std::string ns;
+	uint64_t prepareTime = 0, selectTime = 0, postprocessTime = 0, loopTime = 0;
+	std::string sortIndex;
+	int itemsCount = 0;
+	std::vector<Iterator> iterators;
+};
+
+struct SlowQueryEntry {
+	void GetJSON(WrSerializer &ser) const;
+
+	// Unix time of query completion
+	int64_t time = 0;
+	std::string query;
+	std::string shape;
+	uint64_t totalTime = 0;
+	size_t itemsCount = 0;
+	SelectExplain explain;
+};
+
+// Ring buffer of the last slow queries
+class SlowQueryLog {
+public:
+	// Set min duration of logged queries in microseconds (0 - log is disabled) and max count of stored entries
+	void Configure(uint64_t thresholdUs, size_t maxEntries);
+	uint64_t Threshold() const { return threshold_.load(std::memory_order_relaxed); }
+	bool Enabled() const { return Threshold() != 0; }
+
+	void Add(SlowQueryEntry &&entry);
+	// Get entries, from the newest to the oldest
+	std::vector<SlowQueryEntry> Get();
+
+protected:
+	std::atomic<uint64_t> threshold_{0};
+	std::vector<SlowQueryEntry> entries_;
+	size_t maxEntries_ = 100;
+	size_t pos_ = 0;
+	std::mutex mtx_;
+};
+
+}  // namespace reindexer
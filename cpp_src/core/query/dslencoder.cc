@@ -35,6 +35,8 @@ const unordered_map<Root, string, EnumClassHash> root_map = {{Root::Namespace, "
 															 {Root::SelectFunctions, "select_functions"},
 															 {Root::ReqTotal, "req_total"},
 															 {Root::Aggregations, "aggregations"},
+															 {Root::GroupBy, "group_by"},
+															 {Root::ApproxAggregations, "approx_aggregations"},
 															 {Root::NextOp, "next_op"}};
 
 const unordered_map<Sort, string, EnumClassHash> sort_map = {{Sort::Desc, "desc"}, {Sort::Field, "field"}, {Sort::Values, "values"}};
@@ -54,15 +56,19 @@ const unordered_map<Filter, string, EnumClassHash> filter_map = {
 const unordered_map<CondType, string, EnumClassHash> cond_map = {
 	{CondAny, "any"},	 {CondEq, "eq"},   {CondLt, "lt"},			{CondLe, "le"},		  {CondGt, "gt"},	{CondGe, "ge"},
 	{CondRange, "range"}, {CondSet, "set"}, {CondAllSet, "allset"}, {CondEmpty, "empty"}, {CondEq, "match"},
+	{CondDWithin, "dwithin"}, {CondBox, "box"},
 };
 
 const unordered_map<OpType, string, EnumClassHash> op_map = {{OpOr, "or"}, {OpAnd, "and"}, {OpNot, "not"}};
 
 const unordered_map<CalcTotalMode, string, EnumClassHash> reqtotal_values = {
-	{ModeNoTotal, "disabled"}, {ModeAccurateTotal, "enabled"}, {ModeCachedTotal, "cached"}};
+	{ModeNoTotal, "disabled"}, {ModeAccurateTotal, "enabled"}, {ModeCachedTotal, "cached"}, {ModeApproxTotal, "approximate"}};
 
-const unordered_map<Aggregation, string, EnumClassHash> aggregation_map = {{Aggregation::Field, "field"}, {Aggregation::Type, "type"}};
-const unordered_map<AggType, string, EnumClassHash> aggregation_types = {{AggSum, "sum"}, {AggAvg, "avg"}};
+const unordered_map<Aggregation, string, EnumClassHash> aggregation_map = {
+	{Aggregation::Field, "field"}, {Aggregation::Type, "type"}, {Aggregation::Limit, "limit"}};
+const unordered_map<AggType, string, EnumClassHash> aggregation_types = {
+	{AggSum, "sum"}, {AggAvg, "avg"}, {AggMin, "min"}, {AggMax, "max"}, {AggFacet, "facet"}, {AggCount, "count"},
+	{AggCountDistinct, "count_distinct"}, {AggCountDistinctApprox, "approx_count_distinct"}};
 
 template <typename T>
 string get(unordered_map<T, string, EnumClassHash> const& m, const T& key) {
@@ -265,6 +271,10 @@ void encodeAggregationFunctions(const Query& query, string& dsl) {
 		encodeStringField(get(aggregation_map, Aggregation::Field), entry.index_, dsl);
 		addComa(dsl);
 		encodeStringField(get(aggregation_map, Aggregation::Type), get(aggregation_types, entry.type_), dsl);
+		if (entry.limit_ != UINT_MAX) {
+			addComa(dsl);
+			encodeNumericField(get(aggregation_map, Aggregation::Limit), entry.limit_, dsl);
+		}
 		dsl += rightBracket;
 		if (i != query.aggregations_.size() - 1) addComa(dsl);
 	}
@@ -354,6 +364,17 @@ std::string toDsl(const Query& query) {
 	if (!query.aggregations_.empty()) addComa(dsl);
 	encodeAggregationFunctions(query, dsl);
 
+	if (!query.groupBy_.empty()) {
+		addComa(dsl);
+		encodeNodeName(get(root_map, Root::GroupBy), dsl);
+		encodeStringArray(query.groupBy_, dsl);
+	}
+
+	if (query.aggregationsMaxError > 0) {
+		addComa(dsl);
+		encodeNumericField(get(root_map, Root::ApproxAggregations), query.aggregationsMaxError, dsl);
+	}
+
 	if (!query.joinQueries_.empty()) addComa(dsl);
 	encodeJoins(query, dsl);
 
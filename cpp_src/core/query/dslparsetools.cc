@@ -24,6 +24,8 @@ static const fast_hash_map<string, Root> root_map = {{"namespace", Root::Namespa
 													 {"select_functions", Root::SelectFunctions},
 													 {"req_total", Root::ReqTotal},
 													 {"aggregations", Root::Aggregations},
+													 {"group_by", Root::GroupBy},
+													 {"approx_aggregations", Root::ApproxAggregations},
 													 {"next_op", Root::NextOp}};
 
 // additional for parse field 'sort'
@@ -51,6 +53,7 @@ static const fast_hash_map<string, Filter> filter_map = {
 static const fast_hash_map<string, CondType> cond_map = {
 	{"any", CondAny},	 {"eq", CondEq},   {"lt", CondLt},			{"le", CondLe},		  {"gt", CondGt},	{"ge", CondGe},
 	{"range", CondRange}, {"set", CondSet}, {"allset", CondAllSet}, {"empty", CondEmpty}, {"match", CondEq},
+	{"dwithin", CondDWithin}, {"box", CondBox},
 };
 
 static const fast_hash_map<string, OpType> op_map = {{"or", OpOr}, {"and", OpAnd}, {"not", OpNot}};
@@ -58,12 +61,15 @@ static const fast_hash_map<string, OpType> op_map = {{"or", OpOr}, {"and", OpAnd
 // additional for 'Root::ReqTotal' field
 
 static const fast_hash_map<string, CalcTotalMode> reqtotal_values = {
-	{"disabled", ModeNoTotal}, {"enabled", ModeAccurateTotal}, {"cached", ModeCachedTotal}};
+	{"disabled", ModeNoTotal}, {"enabled", ModeAccurateTotal}, {"cached", ModeCachedTotal}, {"approximate", ModeApproxTotal}};
 
 // additional for 'Root::Aggregations' field
 
-static const fast_hash_map<string, Aggregation> aggregation_map = {{"field", Aggregation::Field}, {"type", Aggregation::Type}};
-static const fast_hash_map<string, AggType> aggregation_types = {{"sum", AggSum}, {"avg", AggAvg}};
+static const fast_hash_map<string, Aggregation> aggregation_map = {
+	{"field", Aggregation::Field}, {"type", Aggregation::Type}, {"limit", Aggregation::Limit}};
+static const fast_hash_map<string, AggType> aggregation_types = {
+	{"sum", AggSum}, {"avg", AggAvg}, {"min", AggMin}, {"max", AggMax}, {"facet", AggFacet}, {"count", AggCount},
+	{"count_distinct", AggCountDistinct}, {"approx_count_distinct", AggCountDistinctApprox}};
 
 void checkJsonValueType(JsonValue& val, const string& name, JsonTag expectedType) {
 	if (val.getTag() != expectedType) throw Error(errParseJson, "Wrong type of field '%s'", name.c_str());
@@ -167,6 +173,16 @@ void parseFilter(JsonValue& filter, Query& q) {
 				throw Error(errLogic, "Condition RANGE must have exact 2 values, but %d values was provided", int(qe.values.size()));
 			}
 			break;
+		case CondDWithin:
+			if (qe.values.size() != 3) {
+				throw Error(errLogic, "Condition DWITHIN must have exact 3 values, but %d values was provided", int(qe.values.size()));
+			}
+			break;
+		case CondBox:
+			if (qe.values.size() != 4) {
+				throw Error(errLogic, "Condition BOX must have exact 4 values, but %d values was provided", int(qe.values.size()));
+			}
+			break;
 		case CondSet:
 			if (qe.values.size() < 1) {
 				throw Error(errLogic, "Condition SET must have at least 1 value, but %d values was provided", int(qe.values.size()));
@@ -290,6 +306,10 @@ void parseAggregation(JsonValue& aggregation, Query& query) {
 				checkJsonValueType(value, name, JSON_STRING);
 				aggEntry.type_ = get(aggregation_types, lower(value.toString()));
 				break;
+			case Aggregation::Limit:
+				checkJsonValueType(value, name, JSON_NUMBER);
+				aggEntry.limit_ = static_cast<unsigned>(value.toNumber());
+				break;
 		}
 	}
 	query.aggregations_.push_back(aggEntry);
@@ -356,6 +376,15 @@ void parse(JsonValue& root, Query& q) {
 			case Root::Aggregations:
 				checkJsonValueType(v, name, JSON_ARRAY);
 				for (auto aggregation : v) parseAggregation(aggregation->value, q);
+				break;
+			case Root::GroupBy:
+				checkJsonValueType(v, name, JSON_ARRAY);
+				parseStringArray(v, q.groupBy_);
+				break;
+			case Root::ApproxAggregations:
+				checkJsonValueType(v, name, JSON_NUMBER);
+				q.aggregationsMaxError = v.toNumber();
+				break;
 		}
 	}
 }
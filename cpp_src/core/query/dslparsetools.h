@@ -21,14 +21,16 @@ enum class Root {
 	SelectFunctions,
 	ReqTotal,
 	NextOp,
-	Aggregations
+	Aggregations,
+	GroupBy,
+	ApproxAggregations
 };
 
 enum class Sort { Desc, Field, Values };
 enum class JoinRoot { Type, On, Op, Namespace, Filters, Sort, Limit, Offset };
 enum class JoinEntry { LetfField, RightField, Cond, Op };
 enum class Filter { Cond, Op, Field, Value };
-enum class Aggregation { Field, Type };
+enum class Aggregation { Field, Type, Limit };
 
 void parse(JsonValue& value, Query& q);
 }  // namespace dsl
@@ -25,12 +25,15 @@ bool Query::operator==(const Query &obj) const {
 	if (start != obj.start) return false;
 	if (count != obj.count) return false;
 	if (debugLevel != obj.debugLevel) return false;
+	if (cacheResults != obj.cacheResults) return false;
+	if (aggregationsMaxError != obj.aggregationsMaxError) return false;
 	if (joinType != obj.joinType) return false;
 	if (forcedSortOrder != obj.forcedSortOrder) return false;
 	if (namespacesNames_ != obj.namespacesNames_) return false;
 
 	if (selectFilter_ != obj.selectFilter_) return false;
 	if (selectFunctions_ != obj.selectFunctions_) return false;
+	if (groupBy_ != obj.groupBy_) return false;
 	if (joinQueries_ != obj.joinQueries_) return false;
 	if (mergeQueries_ != obj.mergeQueries_) return false;
 
@@ -84,6 +87,10 @@ void Query::deserialize(Serializer &ser) {
 			case QueryAggregation:
 				aggregations_.push_back({ser.GetVString().ToString(), AggType(ser.GetVarUint())});
 				break;
+			case QueryAggregationLimit:
+				if (aggregations_.empty()) throw Error(errParseBin, "Aggregation limit without aggregation");
+				aggregations_.back().limit_ = ser.GetVarUint();
+				break;
 			case QueryDistinct:
 				qe.index = ser.GetVString().ToString();
 				qe.distinct = true;
@@ -123,6 +130,15 @@ void Query::deserialize(Serializer &ser) {
 			case QuerySelectFunction:
 				selectFunctions_.push_back(ser.GetVString().ToString());
 				break;
+			case QueryCacheResults:
+				cacheResults = ser.GetVarUint();
+				break;
+			case QueryGroupBy:
+				groupBy_.push_back(ser.GetVString().ToString());
+				break;
+			case QueryApproxAggregations:
+				aggregationsMaxError = ser.GetDouble();
+				break;
 			case QueryEnd:
 				return;
 		}
@@ -152,6 +168,7 @@ int Query::Parse(tokenizer &parser) {
 int Query::selectParse(tokenizer &parser) {
 	// Get filter
 	token tok;
+	bool countAll = false;
 	while (!parser.end()) {
 		auto nameWithCase = parser.peek_token(false).text;
 		auto name = parser.next_token().text;
@@ -163,9 +180,35 @@ int Query::selectParse(tokenizer &parser) {
 				aggregations_.push_back({tok.text, AggAvg});
 			} else if (name == "sum") {
 				aggregations_.push_back({tok.text, AggSum});
+			} else if (name == "min") {
+				aggregations_.push_back({tok.text, AggMin});
+			} else if (name == "max") {
+				aggregations_.push_back({tok.text, AggMax});
+			} else if (name == "facet") {
+				aggregations_.push_back({tok.text, AggFacet});
+				if (parser.peek_token().text == "limit") {
+					parser.next_token();
+					tok = parser.next_token();
+					if (tok.type != TokenNumber) {
+						throw Error(errParseSQL, "Expected number in facet limit, but found '%s', %s", tok.text.c_str(),
+									parser.where().c_str());
+					}
+					aggregations_.back().limit_ = stoi(tok.text);
+				}
+			} else if (name == "approx_count_distinct") {
+				aggregations_.push_back({tok.text, AggCountDistinctApprox});
+			} else if (name == "count" && tok.text == "distinct") {
+				aggregations_.push_back({parser.next_token().text, AggCountDistinct});
+			} else if (name == "count" && tok.text != "*") {
+				aggregations_.push_back({tok.text, AggCount});
 			} else if (name == "count") {
 				calcTotal = ModeAccurateTotal;
 				count = 0;
+				countAll = true;
+			} else if (name == "approx_count" && tok.text == "*") {
+				calcTotal = ModeApproxTotal;
+				count = 0;
+				countAll = true;
 			} else {
 				throw Error(errParams, "Unknown function name SQL - %s, %s", name.c_str(), parser.where().c_str());
 			}
@@ -218,7 +261,8 @@ int Query::selectParse(tokenizer &parser) {
 				throw Error(errParseSQL, "Expected name, but found '%s' in query, %s", tok.text.c_str(), parser.where().c_str());
 			sortBy = tok.text;
 			tok = parser.peek_token();
-			if (tok.text == "(" && nameWithCase == "field") {
+			// ORDER BY FIELD(field, values...) or ORDER BY ST_DISTANCE(point_field, x, y)
+			if (tok.text == "(" && (nameWithCase == "field" || nameWithCase == "st_distance")) {
 				parser.next_token();
 				tok = parser.next_token(false);
 				if (tok.type != TokenName)
@@ -260,6 +304,19 @@ int Query::selectParse(tokenizer &parser) {
 			auto jtype = nextOp_ == OpOr ? JoinType::OrInnerJoin : JoinType::InnerJoin;
 			nextOp_ = OpAnd;
 			parseJoin(jtype, parser);
+		} else if (tok.text == "group") {
+			parser.next_token();
+			if (parser.next_token().text != "by") {
+				throw Error(errParseSQL, "Expected BY, but found '%s' in query, %s", tok.text.c_str(), parser.where().c_str());
+			}
+			for (;;) {
+				tok = parser.next_token(false);
+				if (tok.type != TokenName)
+					throw Error(errParseSQL, "Expected name, but found '%s' in query, %s", tok.text.c_str(), parser.where().c_str());
+				groupBy_.push_back(tok.text);
+				if (parser.peek_token().text != ",") break;
+				parser.next_token();
+			}
 		} else if (tok.text == "merge") {
 			parser.next_token();
 			parseMerge(parser);
@@ -270,6 +327,11 @@ int Query::selectParse(tokenizer &parser) {
 			break;
 		}
 	}
+	// COUNT(*) of grouped query is count of items in each group, which is always returned
+	if (countAll && !groupBy_.empty()) {
+		calcTotal = ModeNoTotal;
+		count = UINT_MAX;
+	}
 	return 0;
 }
 
@@ -435,6 +497,10 @@ void Query::Serialize(WrSerializer &ser, uint8_t mode) const {
 		ser.PutVarUint(QueryAggregation);
 		ser.PutVString(agg.index_);
 		ser.PutVarUint(agg.type_);
+		if (agg.limit_ != UINT_MAX) {
+			ser.PutVarUint(QueryAggregationLimit);
+			ser.PutVarUint(agg.limit_);
+		}
 	}
 
 	if (!sortBy.empty()) {
@@ -473,11 +539,26 @@ void Query::Serialize(WrSerializer &ser, uint8_t mode) const {
 		ser.PutVarUint(calcTotal);
 	}
 
+	if (cacheResults) {
+		ser.PutVarUint(QueryCacheResults);
+		ser.PutVarUint(cacheResults);
+	}
+
 	for (auto &sf : selectFilter_) {
 		ser.PutVarUint(QuerySelectFilter);
 		ser.PutVString(sf);
 	}
 
+	for (auto &gb : groupBy_) {
+		ser.PutVarUint(QueryGroupBy);
+		ser.PutVString(gb);
+	}
+
+	if (aggregationsMaxError > 0) {
+		ser.PutVarUint(QueryApproxAggregations);
+		ser.PutDouble(aggregationsMaxError);
+	}
+
 	ser.PutVarUint(QueryEnd);  // finita la commedia... of root query
 
 	if (!(mode & SkipJoinQueries)) {
@@ -530,7 +611,7 @@ const char *Query::JoinTypeName(JoinType type) {
 	}
 }
 
-string Query::dumpJoined() const {
+string Query::dumpJoined(bool stripValues) const {
 	extern const char *condNames[];
 	string ret;
 	for (auto &je : joinQueries_) {
@@ -539,7 +620,7 @@ string Query::dumpJoined() const {
 		if (je.entries.empty() && je.count == INT_MAX) {
 			ret += " " + je._namespace + " ON ";
 		} else {
-			ret += " (" + je.Dump() + ") ON ";
+			ret += " (" + je.Dump(stripValues) + ") ON ";
 		}
 		if (je.joinEntries_.size() != 1) ret += "(";
 		for (auto &e : je.joinEntries_) {
@@ -554,15 +635,15 @@ string Query::dumpJoined() const {
 	return ret;
 }
 
-string Query::dumpMerged() const {
+string Query::dumpMerged(bool stripValues) const {
 	string ret;
 	for (auto &me : mergeQueries_) {
-		ret += " " + string(JoinTypeName(me.joinType)) + "( " + me.Dump() + ")";
+		ret += " " + string(JoinTypeName(me.joinType)) + "( " + me.Dump(stripValues) + ")";
 	}
 	return ret;
 }
 
-string Query::dumpOrderBy() const {
+string Query::dumpOrderBy(bool stripValues) const {
 	string ret;
 	if (sortBy.empty()) {
 		return ret;
@@ -572,8 +653,12 @@ string Query::dumpOrderBy() const {
 		ret += sortBy;
 	} else {
 		ret += "FIELD(" + sortBy;
-		for (auto &v : forcedSortOrder) {
-			ret += ", '" + v.As<string>() + "'";
+		if (stripValues) {
+			ret += ", ?";
+		} else {
+			for (auto &v : forcedSortOrder) {
+				ret += ", '" + v.As<string>() + "'";
+			}
 		}
 		ret += ")";
 	}
@@ -581,10 +666,74 @@ string Query::dumpOrderBy() const {
 	return ret + (sortDirDesc ? " DESC" : "");
 }
 
-string Query::Dump() const {
+namespace {
+// FNV-1a style mixing of hashes of query parts
+struct ShapeHasher {
+	void Add(uint64_t v) { hash = (hash ^ v) * 1099511628211ULL; }
+	void Add(const string &s) { Add(std::hash<string>()(s)); }
+	uint64_t hash = 14695981039346656037ULL;
+};
+}  // namespace
+
+uint64_t Query::ShapeHash() const {
+	// Parts are mixed in the same order and with the same details as they are printed by Dump(true)
+	ShapeHasher h;
+	h.Add(_namespace);
+	h.Add(entries.size());
+	for (auto &e : entries) {
+		h.Add(&e == &*entries.begin() ? 0 : unsigned(e.op) + 1);
+		h.Add(e.index);
+		h.Add(e.condition);
+		h.Add(e.values.size() > 1 ? 2 : e.values.size());
+	}
+	h.Add(aggregations_.size());
+	for (auto &a : aggregations_) {
+		h.Add(a.type_);
+		h.Add(a.index_);
+		h.Add(a.limit_ != UINT_MAX);
+	}
+	if (aggregations_.empty()) {
+		h.Add(selectFilter_.size());
+		for (auto &f : selectFilter_) h.Add(f);
+	}
+	h.Add(calcTotal);
+	h.Add(groupBy_.size());
+	for (auto &gb : groupBy_) h.Add(gb);
+	h.Add(joinQueries_.size());
+	for (auto &je : joinQueries_) {
+		h.Add(je.joinType);
+		if (je.entries.empty() && je.count == INT_MAX) {
+			h.Add(je._namespace);
+		} else {
+			h.Add(je.ShapeHash());
+		}
+		h.Add(je.joinEntries_.size());
+		for (auto &e : je.joinEntries_) {
+			h.Add(e.op_ == OpOr);
+			h.Add(e.joinIndex_);
+			h.Add(e.condition_);
+			h.Add(e.index_);
+		}
+	}
+	h.Add(mergeQueries_.size());
+	for (auto &me : mergeQueries_) {
+		h.Add(me.joinType);
+		h.Add(me.ShapeHash());
+	}
+	h.Add(sortBy);
+	if (!sortBy.empty()) {
+		h.Add(forcedSortOrder.empty());
+		h.Add(sortDirDesc);
+	}
+	h.Add(start != 0);
+	h.Add(count != UINT_MAX);
+	return h.hash;
+}
+
+string Query::Dump(bool stripValues) const {
 	string lim, filt;
-	if (start != 0) lim += " OFFSET " + std::to_string(start);
-	if (count != UINT_MAX) lim += " LIMIT " + std::to_string(count);
+	if (start != 0) lim += " OFFSET " + (stripValues ? string("?") : std::to_string(start));
+	if (count != UINT_MAX) lim += " LIMIT " + (stripValues ? string("?") : std::to_string(count));
 
 	if (aggregations_.size()) {
 		for (auto &a : aggregations_) {
@@ -596,11 +745,31 @@ string Query::Dump() const {
 				case AggSum:
 					filt += "SUM(";
 					break;
+				case AggMin:
+					filt += "MIN(";
+					break;
+				case AggMax:
+					filt += "MAX(";
+					break;
+				case AggFacet:
+					filt += "FACET(";
+					break;
+				case AggCount:
+					filt += "COUNT(";
+					break;
+				case AggCountDistinct:
+					filt += "COUNT(DISTINCT ";
+					break;
+				case AggCountDistinctApprox:
+					filt += "APPROX_COUNT_DISTINCT(";
+					break;
 				default:
 					filt += "<?> (";
 					break;
 			}
-			filt += a.index_ + ")";
+			filt += a.index_;
+			if (a.limit_ != UINT_MAX) filt += " LIMIT " + (stripValues ? string("?") : std::to_string(a.limit_));
+			filt += ")";
 		}
 	} else if (selectFilter_.size()) {
 		for (auto &f : selectFilter_) {
@@ -609,9 +778,13 @@ string Query::Dump() const {
 		}
 	} else
 		filt = "*";
-	if (calcTotal) filt += ", COUNT(*)";
+	if (calcTotal) filt += (calcTotal == ModeApproxTotal) ? ", APPROX_COUNT(*)" : ", COUNT(*)";
+
+	string groupBy;
+	for (auto &gb : groupBy_) groupBy += (groupBy.empty() ? " GROUP BY " : ", ") + gb;
 
-	string buf = "SELECT " + filt + " FROM " + _namespace + QueryWhere::toString() + dumpJoined() + dumpMerged() + dumpOrderBy() + lim;
+	string buf = "SELECT " + filt + " FROM " + _namespace + QueryWhere::toString(stripValues) + groupBy + dumpJoined(stripValues) +
+				 dumpMerged(stripValues) + dumpOrderBy(stripValues) + lim;
 	return buf;
 }
 
@@ -42,7 +42,13 @@ public:
 	Error ParseJson(const string &dsl);
 
 	/// Logs query in 'Select field1, ... field N from namespace ...' format.
-	string Dump() const;
+	/// @param stripValues - replace values of conditions, limits and offsets with '?'.
+	/// Queries, which differ only by values, have the same stripped dump (query shape).
+	string Dump(bool stripValues = false) const;
+
+	/// Hash of query shape: queries with the same stripped dump have the same hash.
+	/// It is calculated without building of dump string, so it's cheap enough to be calculated for each query.
+	uint64_t ShapeHash() const;
 
 	/// Adds a condition with a single value. Analog to sql Where clause.
 	/// @param idx - index used in condition clause.
@@ -217,6 +223,31 @@ public:
 		return *this;
 	}
 
+	/// Performs sorting by distance to point. Analog to sql ORDER BY ST_Distance(field, x, y).
+	/// @param idx - name of point index.
+	/// @param x, y - coordinates of point.
+	/// @param desc - is sorting direction descending or ascending.
+	/// @return Query object.
+	Query &SortByDistance(const char *idx, double x, double y, bool desc = false) {
+		sortBy = idx;
+		sortDirDesc = desc;
+		forcedSortOrder = {KeyValue(x), KeyValue(y)};
+		return *this;
+	}
+
+	/// Adds a condition, which matches points within distance from certain point.
+	/// @param idx - name of point index.
+	/// @param x, y - coordinates of point.
+	/// @param distance - max distance to point.
+	/// @return Query object ready to be executed.
+	Query &DWithin(const char *idx, double x, double y, double distance) { return Where(idx, CondDWithin, {x, y, distance}); }
+
+	/// Adds a condition, which matches points inside bounding box.
+	/// @param idx - name of point index.
+	/// @param x1, y1, x2, y2 - coordinates of box corners.
+	/// @return Query object ready to be executed.
+	Query &Box(const char *idx, double x1, double y1, double x2, double y2) { return Where(idx, CondBox, {x1, y1, x2, y2}); }
+
 	/// Performs distinct for a certain index.
 	/// @param indexName - name of index for distict operation.
 	Query &Distinct(const char *indexName) {
@@ -237,10 +268,22 @@ public:
 	/// Adds an aggregate function for certain column.
 	/// Analog to sql aggregate functions (min, max, avg, etc).
 	/// @param idx - name of the field to be aggregated.
-	/// @param type - aggregation function type (Sum, Avg).
+	/// @param type - aggregation function type (Sum, Avg, Min, Max, Count, CountDistinct, CountDistinctApprox, Facet).
+	/// Facet values with counts of items are returned in QueryResults::aggregationFacets.
+	/// @param limit - max count of returned values of facet, with biggest counts of items.
 	/// @return Query object ready to be executed.
-	Query &Aggregate(const char *idx, AggType type) {
-		aggregations_.push_back({idx, type});
+	Query &Aggregate(const char *idx, AggType type, unsigned limit = UINT_MAX) {
+		aggregations_.push_back({idx, type, limit});
+		return *this;
+	}
+
+	/// Groups matched items by values of field. Aggregations of query are calculated for each group.
+	/// Analog to sql GROUP BY. Could be called several times to group by several fields.
+	/// Results are returned in QueryResults::groupedResults, items are not returned.
+	/// @param field - name of field to group by. Field must be indexed and not array.
+	/// @return Query object.
+	Query &GroupBy(const string &field) {
+		groupBy_.push_back(field);
 		return *this;
 	}
 
@@ -291,6 +334,32 @@ public:
 		return *this;
 	}
 
+	/// Set the total count calculation mode to Approximate.
+	/// Total count is extrapolated from matches among sampled ids, after requested items are selected
+	/// @return Query object
+	Query &ApproxTotal() {
+		calcTotal = ModeApproxTotal;
+		return *this;
+	}
+
+	/// Enable cache of query results.
+	/// Results of repeated query will be taken from cache, until namespace is modified.
+	/// Query must not contain joins, merges, select functions and fulltext conditions
+	/// @return Query object
+	Query &CacheResults() {
+		cacheResults = true;
+		return *this;
+	}
+
+	/// Calculate SUM, AVG and COUNT aggregations by random sample of matched items.
+	/// Sample grows, until relative error of results with 95% confidence is less than maxError
+	/// @param maxError - max relative error of aggregations, e.g. 0.01. 0 - aggregations are exact
+	/// @return Query object
+	Query &ApproxAggregations(double maxError) {
+		aggregationsMaxError = maxError;
+		return *this;
+	}
+
 	/// Serializes query data to stream.
 	/// @param ser - serializer object for write.
 	/// @param mode - serialization mode.
@@ -343,15 +412,15 @@ protected:
 
 	/// Builds print version of a query with join in sql format.
 	/// @return query sql string.
-	string dumpJoined() const;
+	string dumpJoined(bool stripValues) const;
 
 	/// Builds a print version of a query with merge queries in sql format.
 	/// @return query sql string.
-	string dumpMerged() const;
+	string dumpMerged(bool stripValues) const;
 
 	/// Builds a print version of a query's order by statement
 	/// @return query sql string.
-	string dumpOrderBy() const;
+	string dumpOrderBy(bool stripValues) const;
 
 public:
 	/// Next operation constant.
@@ -380,10 +449,17 @@ public:
 	/// Debug level.
 	int debugLevel = 0;
 
+	/// Cache query results.
+	bool cacheResults = false;
+
+	/// Max relative error of sampled aggregations. 0 - aggregations are exact.
+	double aggregationsMaxError = 0;
+
 	/// Default join type.
 	JoinType joinType = JoinType::LeftJoin;
 
 	/// Keys whiech always go first - before any ordered values.
+	/// For sort by point index - coordinates of point to sort by distance to.
 	KeyValues forcedSortOrder;
 
 	/// Container or namespaces in a describe part.
@@ -400,6 +476,9 @@ public:
 
 	/// List of sql functions
 	h_vector<string, 1> selectFunctions_;
+
+	/// Fields to group by.
+	h_vector<string, 1> groupBy_;
 };
 
 }  // namespace reindexer
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/lrucache.h"
+#include "core/query/queryresults.h"
 #include "estl/h_vector.h"
 #include "query.h"
 #include "tools/serializer.h"
@@ -13,11 +14,13 @@ namespace reindexer {
 
 struct QueryCacheVal {
 	QueryCacheVal() = default;
-	QueryCacheVal(const size_t& total) : total_count(total) {}
+	QueryCacheVal(const size_t& total, uint64_t gen = 0) : total_count(total), generation(gen) {}
 
-	size_t Size() const { return sizeof total_count; }
+	size_t Size() const { return sizeof total_count + sizeof generation; }
 
 	int total_count = -1;
+	// Generation of namespace and indexes, total was calculated on
+	uint64_t generation = 0;
 };
 
 struct QueryCacheKey {
@@ -49,4 +52,42 @@ struct HashQueryCacheKey {
 
 struct QueryCache : LRUCache<QueryCacheKey, QueryCacheVal, HashQueryCacheKey, EqQueryCacheKey> {};
 
+const size_t kDefaultQueryResultsCacheSizeLimit = 1024 * 1024 * 32;
+
+// Final results of query: ids of items, without payloads. Valid only for generation of namespace and indexes, it was built for
+struct QueryResultsCacheVal {
+	QueryResultsCacheVal() = default;
+	QueryResultsCacheVal(const QueryResults& qr, uint64_t gen)
+		: items(std::make_shared<vector<ItemRef>>()),
+		  totalCount(qr.totalCount),
+		  aggregationResults(qr.aggregationResults),
+		  aggregationFacets(qr.aggregationFacets),
+		  groupedResults(qr.groupedResults),
+		  generation(gen) {
+		items->reserve(qr.size());
+		for (auto& it : qr) items->push_back({it.id, it.version, PayloadValue(), it.proc, it.nsid});
+	}
+
+	size_t Size() const {
+		size_t size = (items ? items->size() * sizeof(ItemRef) : 0) + aggregationResults.size() * sizeof(double);
+		for (auto& facets : aggregationFacets) {
+			for (auto& f : facets) size += sizeof(f) + f.value.size();
+		}
+		size += groupedResults.counts.size() * (sizeof(int) + groupedResults.keys.size() * sizeof(KeyValue) +
+												 groupedResults.values.size() * sizeof(double));
+		return size;
+	}
+
+	std::shared_ptr<vector<ItemRef>> items;
+	int totalCount = 0;
+	h_vector<double> aggregationResults;
+	vector<vector<FacetResult>> aggregationFacets;
+	GroupedResults groupedResults;
+	uint64_t generation = 0;
+};
+
+struct QueryResultsCache : LRUCache<QueryCacheKey, QueryResultsCacheVal, HashQueryCacheKey, EqQueryCacheKey> {
+	QueryResultsCache() : LRUCache(kDefaultQueryResultsCacheSizeLimit) {}
+};
+
 }  // namespace reindexer
@@ -18,6 +18,30 @@ struct QueryResults::Context {
 static_assert(sizeof(QueryResults::Context) < QueryResults::kSizeofContext,
 			  "QueryResults::kSizeofContext should >=  sizeof(QueryResults::Context)");
 
+size_t JoinedResults::Add(int joinIdx, const ItemRef *items, size_t count) {
+	size_t offset = items_.size();
+	items_.insert(items_.end(), items, items + count);
+	for (size_t i = offset; i < items_.size(); ++i) items_[i].nsid = joinIdx + 1;
+	return offset;
+}
+
+void JoinedResults::Link(IdType id, int joinIdx, size_t offset, size_t count) {
+	assert(joinIdx < joinedQueries_);
+	auto it = rows_.emplace(id, ranges_.size());
+	if (it.second) ranges_.resize(ranges_.size() + joinedQueries_);
+	auto &range = ranges_[it.first->second + joinIdx];
+	range.offset = offset;
+	range.count = count;
+}
+
+JoinedResults::ItemsRange JoinedResults::Get(IdType id, int joinIdx) const {
+	auto it = rows_.find(id);
+	if (it == rows_.end() || joinIdx >= joinedQueries_) return ItemsRange();
+	auto &range = ranges_[it->second + joinIdx];
+	const ItemRef *begin = items_.data() + range.offset;
+	return ItemsRange(begin, begin + range.count);
+}
+
 QueryResults::QueryResults(std::initializer_list<ItemRef> l) : ItemRefVector(l) {}
 QueryResults::QueryResults() = default;
 QueryResults::QueryResults(QueryResults &&) = default;
@@ -27,6 +51,8 @@ QueryResults &QueryResults::operator=(QueryResults &&obj) noexcept {
 		ItemRefVector::operator=(static_cast<ItemRefVector &&>(obj));
 		joined_ = std::move(obj.joined_);
 		aggregationResults = std::move(obj.aggregationResults);
+		aggregationFacets = std::move(obj.aggregationFacets);
+		groupedResults = std::move(obj.groupedResults);
 		totalCount = std::move(obj.totalCount);
 		haveProcent = std::move(obj.haveProcent);
 		ctxs = std::move(obj.ctxs);
@@ -52,10 +78,9 @@ void QueryResults::lockResults() {
 		}
 	}
 	if (joined_) {
-		for (auto &jr : *joined_) {
-			for (auto &jqr : jr.second) {
-				jqr.lockResults();
-			}
+		for (auto &itemRef : joined_->Items()) {
+			assert(ctxs.size() > itemRef.nsid);
+			Payload(ctxs[itemRef.nsid].type_, itemRef.value).AddRefStrings();
 		}
 	}
 	lockedResults_ = true;
@@ -69,6 +94,11 @@ void QueryResults::unlockResults() {
 			Payload(ctxs[itemRef.nsid].type_, itemRef.value).ReleaseStrings();
 		}
 	}
+	if (joined_) {
+		for (auto &itemRef : joined_->Items()) {
+			Payload(ctxs[itemRef.nsid].type_, itemRef.value).ReleaseStrings();
+		}
+	}
 	lockedResults_ = false;
 }
 
@@ -88,19 +118,17 @@ void QueryResults::Dump() const {
 	for (auto &r : *this) {
 		if (&r != &*(*this).begin()) buf += ",";
 		buf += std::to_string(r.id);
-		if (joined_) {
-			auto it = joined_->find(r.id);
-			if (it != joined_->end()) {
-				buf += "[";
-				for (auto &ra : it->second) {
-					if (&ra != &*it->second.begin()) buf += ";";
-					for (auto &rr : ra) {
-						if (&rr != &*ra.begin()) buf += ",";
-						buf += std::to_string(rr.id);
-					}
+		if (joined_ && joined_->Has(r.id)) {
+			buf += "[";
+			for (int i = 0; i < joined_->JoinedQueries(); ++i) {
+				if (i != 0) buf += ";";
+				auto ra = joined_->Get(r.id, i);
+				for (auto &rr : ra) {
+					if (&rr != ra.begin()) buf += ",";
+					buf += std::to_string(rr.id);
 				}
-				buf += "]";
 			}
+			buf += "]";
 		}
 	}
 	logPrintf(LogInfo, "Query returned: [%s]; total=%d", buf.c_str(), this->totalCount);
@@ -108,17 +136,14 @@ void QueryResults::Dump() const {
 
 class QueryResults::JsonEncoderDatasourceWithJoins : public IJsonEncoderDatasourceWithJoins {
 public:
-	JsonEncoderDatasourceWithJoins(const QRVector &joined, const ContextsVector &ctxs) : joined_(joined), ctxs_(ctxs) {}
+	JsonEncoderDatasourceWithJoins(const JoinedResults &joined, IdType id, const ContextsVector &ctxs)
+		: joined_(joined), id_(id), ctxs_(ctxs) {}
 	~JsonEncoderDatasourceWithJoins() {}
 
-	size_t GetJoinedRowsCount() final { return joined_.size(); }
-	size_t GetJoinedRowItemsCount(size_t rowId) final {
-		const QueryResults &queryRes(joined_[rowId]);
-		return queryRes.size();
-	}
+	size_t GetJoinedRowsCount() final { return joined_.JoinedQueries(); }
+	size_t GetJoinedRowItemsCount(size_t rowId) final { return joined_.Get(id_, rowId).size(); }
 	ConstPayload GetJoinedItemPayload(size_t rowid, size_t plIndex) final {
-		const QueryResults &queryRes(joined_[rowid]);
-		const ItemRef &itemRef = queryRes[plIndex];
+		const ItemRef &itemRef = joined_.Get(id_, rowid)[plIndex];
 		const Context &ctx = ctxs_[rowid + 1];
 		return ConstPayload(ctx.type_, itemRef.value);
 	}
@@ -137,49 +162,51 @@ public:
 	}
 
 private:
-	const QRVector &joined_;
+	const JoinedResults &joined_;
+	IdType id_;
 	const ContextsVector &ctxs_;
 };
 
-void QueryResults::encodeJSON(int idx, WrSerializer &ser) const {
-	auto &itemRef = at(idx);
+void QueryResults::encodeJSON(const ItemRef &itemRef, WrSerializer &ser) const {
 	assert(ctxs.size() > itemRef.nsid);
 	auto &ctx = ctxs[itemRef.nsid];
 
 	ConstPayload pl(ctx.type_, itemRef.value);
 	JsonEncoder jsonEncoder(ctx.tagsMatcher_, ctx.jsonFilter_);
 
-	if (joined_) {
-		auto itJoined(joined_->find(itemRef.id));
-		bool withJoins((itJoined != joined_->end()) && !itJoined->second.empty());
-		if (withJoins) {
-			JsonEncoderDatasourceWithJoins ds(itJoined->second, ctxs);
-			jsonEncoder.Encode(&pl, ser, ds);
-			return;
-		}
+	// Only items of main namespace have joined items
+	if (joined_ && itemRef.nsid == 0 && joined_->Has(itemRef.id)) {
+		JsonEncoderDatasourceWithJoins ds(*joined_, itemRef.id, ctxs);
+		jsonEncoder.Encode(&pl, ser, ds);
+		return;
 	}
 	jsonEncoder.Encode(&pl, ser);
 }
 
 void QueryResults::GetJSON(int idx, WrSerializer &ser, bool withHdrLen) const {
 	assert(static_cast<size_t>(idx) < size());
+	GetJSON(at(idx), ser, withHdrLen);
+}
+
+void QueryResults::GetJSON(const ItemRef &itemRef, WrSerializer &ser, bool withHdrLen) const {
 	if (withHdrLen) {
 		// reserve place for size
 		uint32_t saveLen = ser.Len();
 		ser.PutUInt32(0);
 
-		encodeJSON(idx, ser);
+		encodeJSON(itemRef, ser);
 
 		// put real json size
 		int realSize = ser.Len() - saveLen - sizeof(saveLen);
 		memcpy(ser.Buf() + saveLen, &realSize, sizeof(saveLen));
 	} else {
-		encodeJSON(idx, ser);
+		encodeJSON(itemRef, ser);
 	}
 }
 
-void QueryResults::GetCJSON(int idx, WrSerializer &ser, bool withHdrLen) const {
-	auto &itemRef = at(idx);
+void QueryResults::GetCJSON(int idx, WrSerializer &ser, bool withHdrLen) const { GetCJSON(at(idx), ser, withHdrLen); }
+
+void QueryResults::GetCJSON(const ItemRef &itemRef, WrSerializer &ser, bool withHdrLen) const {
 	assert(ctxs.size() > itemRef.nsid);
 	auto &ctx = ctxs[itemRef.nsid];
 
@@ -201,9 +228,9 @@ void QueryResults::GetCJSON(int idx, WrSerializer &ser, bool withHdrLen) const {
 	}
 }
 
-Item QueryResults::GetItem(int idx) const {
-	auto &itemRef = at(idx);
+Item QueryResults::GetItem(int idx) const { return GetItem(at(idx)); }
 
+Item QueryResults::GetItem(const ItemRef &itemRef) const {
 	assert(ctxs.size() > itemRef.nsid);
 	auto &ctx = ctxs[itemRef.nsid];
 
@@ -246,4 +273,8 @@ void QueryResults::addNSContext(const PayloadType &type, const TagsMatcher &tags
 	ctxs.push_back(Context(type, tagsMatcher, jsonFilter));
 }
 
+void QueryResults::addNSContexts(const QueryResults &other) {
+	for (auto &ctx : other.ctxs) ctxs.push_back(ctx);
+}
+
 }  // namespace reindexer
@@ -1,15 +1,17 @@
 #pragma once
 
-#include <unordered_map>
+#include <vector>
+#include "core/aggregator.h"
 #include "core/item.h"
 #include "core/itemimpl.h"
+#include "estl/fast_hash_map.h"
 #include "estl/h_vector.h"
 
 namespace reindexer {
 
 using std::string;
-using std::unordered_map;
 using std::unique_ptr;
+using std::vector;
 
 static const int kDefaultQueryResultsSize = 32;
 struct ItemRef {
@@ -29,7 +31,61 @@ class TagsMatcher;
 class PayloadType;
 class JsonPrintFilter;
 class WrSerializer;
-class QRVector;
+
+/// Items of joined namespaces, joined to items of main namespace.<br>
+/// Items of all joined queries are stored in one flat array. Items, joined to one item of main namespace by one joined query,
+/// are continuous range of this array, and the same range could be shared by several items of main namespace (e.g. with equal join keys).
+class JoinedResults {
+public:
+	/// Items, joined to one item of main namespace by one joined query
+	class ItemsRange {
+	public:
+		ItemsRange(const ItemRef *begin = nullptr, const ItemRef *end = nullptr) : begin_(begin), end_(end) {}
+		const ItemRef *begin() const { return begin_; }
+		const ItemRef *end() const { return end_; }
+		size_t size() const { return end_ - begin_; }
+		bool empty() const { return begin_ == end_; }
+		const ItemRef &operator[](size_t i) const { return begin_[i]; }
+
+	protected:
+		const ItemRef *begin_, *end_;
+	};
+
+	explicit JoinedResults(int joinedQueries) : joinedQueries_(joinedQueries) {}
+
+	/// Add items of joined query. nsid of added items is set to joinIdx + 1 - index of context of joined namespace in QueryResults
+	/// @param joinIdx - index of joined query
+	/// @param items - items to add
+	/// @param count - count of items to add
+	/// @return offset of added items, which should be passed to Link
+	size_t Add(int joinIdx, const ItemRef *items, size_t count);
+	/// Set items, joined to item of main namespace by joined query
+	/// @param id - id of item of main namespace
+	/// @param joinIdx - index of joined query
+	/// @param offset - offset of items, returned by Add
+	/// @param count - count of items
+	void Link(IdType id, int joinIdx, size_t offset, size_t count);
+	/// Get items, joined to item of main namespace by joined query. Returns empty range, if nothing was joined
+	ItemsRange Get(IdType id, int joinIdx) const;
+	/// Returns true, if anything was joined to item of main namespace
+	bool Has(IdType id) const { return rows_.find(id) != rows_.end(); }
+	int JoinedQueries() const { return joinedQueries_; }
+	/// All joined items of all joined queries
+	vector<ItemRef> &Items() { return items_; }
+	const vector<ItemRef> &Items() const { return items_; }
+
+protected:
+	struct Range {
+		uint32_t offset = 0;
+		uint32_t count = 0;
+	};
+
+	int joinedQueries_;
+	vector<ItemRef> items_;
+	// id of item of main namespace -> index of its first range in ranges_. Each item has joinedQueries_ ranges
+	fast_hash_map<IdType, uint32_t> rows_;
+	vector<Range> ranges_;
+};
 
 /// QueryResults is the interface for iterating documents, returned by Query from Reindexer.<br>
 /// *Lifetime*: QueryResults is uses Copy-On-Write semantics, so it have independent lifetime and state - e.g., aquired from Reindexer
@@ -64,10 +120,18 @@ public:
 	void GetCJSON(int idx, WrSerializer &wrser, bool withHdrLen = true) const;
 
 	Item GetItem(int idx) const;
+	// Methods for items, referenced by ItemRef. Could be used for items of joined namespaces
+	void GetJSON(const ItemRef &itemRef, WrSerializer &wrser, bool withHdrLen = true) const;
+	void GetCJSON(const ItemRef &itemRef, WrSerializer &wrser, bool withHdrLen = true) const;
+	Item GetItem(const ItemRef &itemRef) const;
 
-	// joinded fields 0 - 1st joined ns, 1 - second joined
-	unique_ptr<unordered_map<IdType, QRVector>> joined_;  // joinded items
+	// joinded items: 0 - 1st joined ns, 1 - second joined
+	unique_ptr<JoinedResults> joined_;
 	h_vector<double> aggregationResults;
+	// Values of FACET aggregations, by indexes of aggregationResults. Empty for other aggregations
+	vector<vector<FacetResult>> aggregationFacets;
+	// Results of aggregations by groups of GROUP BY query
+	GroupedResults groupedResults;
 	int totalCount = 0;
 	bool haveProcent = false;
 	bool nonCacheableData = false;
@@ -79,6 +143,8 @@ public:
 	ContextsVector ctxs;
 
 	void addNSContext(const PayloadType &type, const TagsMatcher &tagsMatcher, const JsonPrintFilter &jsonFilter);
+	// Add contexts of all namespaces of other results
+	void addNSContexts(const QueryResults &other);
 	const TagsMatcher &getTagsMatcher(int nsid) const;
 	const PayloadType &getPayloadType(int nsid) const;
 	TagsMatcher &getTagsMatcher(int nsid);
@@ -91,13 +157,8 @@ protected:
 
 private:
 	void unlockResults();
-	void encodeJSON(int idx, WrSerializer &ser) const;
+	void encodeJSON(const ItemRef &itemRef, WrSerializer &ser) const;
 	bool lockedResults_ = false;
 };
 
-class QRVector : public h_vector<QueryResults, 2> {
-public:
-	using h_vector<QueryResults, 2>::h_vector;
-};
-
 }  // namespace reindexer
@@ -28,6 +28,7 @@ bool QueryJoinEntry::operator==(const QueryJoinEntry &obj) const {
 bool AggregateEntry::operator==(const AggregateEntry &obj) const {
 	if (index_ != obj.index_) return false;
 	if (type_ != obj.type_) return false;
+	if (limit_ != obj.limit_) return false;
 	return true;
 }
 
@@ -55,6 +56,10 @@ CondType QueryWhere::getCondType(const string &cond) {
 		return CondSet;
 	} else if (cond == "range") {
 		return CondRange;
+	} else if (cond == "dwithin") {
+		return CondDWithin;
+	} else if (cond == "box") {
+		return CondBox;
 	}
 	throw Error(errParseSQL, "Expected condition operator, but found '%s' in query", cond.c_str());
 }
@@ -144,10 +149,10 @@ int QueryWhere::ParseWhere(tokenizer &parser) {
 	return 0;
 }
 
-const char *condNames[] = {"ANY", "=", "<", "<=", ">", "=>", "RANGE", "IN", "ALLSET", "EMPTY"};
+const char *condNames[] = {"ANY", "=", "<", "<=", ">", "=>", "RANGE", "IN", "ALLSET", "EMPTY", "DWITHIN", "BOX"};
 const char *opNames[] = {"-", "OR", "AND", "AND NOT"};
 
-string QueryWhere::toString() const {
+string QueryWhere::toString(bool stripValues) const {
 	string res;
 	if (entries.size()) res = " WHERE";
 
@@ -160,6 +165,15 @@ string QueryWhere::toString() const {
 			res += string(condNames[e.condition]) + " ";
 		else
 			res += "<unknown cond> ";
+		if (stripValues) {
+			// Lists of different length have the same shape
+			if (e.values.size() > 1) {
+				res += "(?)";
+			} else if (e.values.size()) {
+				res += "?";
+			}
+			continue;
+		}
 		if (e.values.size() > 1) res += "(";
 		for (auto &v : e.values) {
 			if (&v != &*e.values.begin()) res += ",";
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <climits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -44,10 +45,14 @@ struct QueryJoinEntry {
 struct QueryEntries : public h_vector<QueryEntry, 4> {};
 
 struct AggregateEntry {
+	AggregateEntry() = default;
+	AggregateEntry(const string &index, AggType type, unsigned limit = UINT_MAX) : index_(index), type_(type), limit_(limit) {}
 	bool operator==(const AggregateEntry &) const;
 	bool operator!=(const AggregateEntry &) const;
 	string index_;
 	AggType type_;
+	// Max count of returned values of FACET, with biggest counts
+	unsigned limit_ = UINT_MAX;
 };
 
 class QueryWhere {
@@ -58,7 +63,7 @@ public:
 
 protected:
 	int ParseWhere(tokenizer &tok);
-	string toString() const;
+	string toString(bool stripValues = false) const;
 	static CondType getCondType(const string &cond);
 
 public:
@@ -32,5 +32,12 @@ Error Reindexer::GetStats(reindexer_stat& stat) { return impl_->GetStats(stat);
 Error Reindexer::AddIndex(const string& _namespace, const IndexDef& idx) { return impl_->AddIndex(_namespace, idx); }
 Error Reindexer::DropIndex(const string& _namespace, const string& index) { return impl_->DropIndex(_namespace, index); }
 Error Reindexer::EnumNamespaces(vector<NamespaceDef>& defs, bool bEnumAll) { return impl_->EnumNamespaces(defs, bEnumAll); }
+Error Reindexer::GetCacheStats(vector<NamespaceCacheStats>& stats) { return impl_->GetCacheStats(stats); }
+Error Reindexer::GetMemStat(const string& _namespace, NamespaceMemStat& stat) { return impl_->GetMemStat(_namespace, stat); }
+Error Reindexer::GetPerfStats(vector<NamespacePerfStat>& stats) { return impl_->GetPerfStats(stats); }
+Error Reindexer::ConfigureSlowQueryLog(uint64_t thresholdUs, size_t maxEntries) {
+	return impl_->ConfigureSlowQueryLog(thresholdUs, maxEntries);
+}
+Error Reindexer::GetSlowQueries(vector<SlowQueryEntry>& entries) { return impl_->GetSlowQueries(entries); }
 
 }  // namespace reindexer
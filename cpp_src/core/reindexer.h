@@ -1,5 +1,8 @@
 #pragma once
 
+#include "cachestats.h"
+#include "memstat.h"
+#include "perfstat.h"
 #include "namespacedef.h"
 #include "query/query.h"
 #include "query/queryresults.h"
@@ -58,6 +61,23 @@ public:
 	/// @param defs - std::vector of NamespaceDef of available namespaves
 	/// @param bEnumAll - Also include currenty not opened, but exists on disk namespaces
 	Error EnumNamespaces(vector<NamespaceDef> &defs, bool bEnumAll);
+	/// Get memory usage and hit statistics of query and index caches of all opened namespaces
+	/// @param stats - std::vector of NamespaceCacheStats
+	Error GetCacheStats(vector<NamespaceCacheStats> &stats);
+	/// Get memory usage of namespace: items payloads, indexes and caches
+	/// @param nsName - Name of namespace
+	/// @param stat - Memory statistics of namespace and each of it's indexes
+	Error GetMemStat(const string &nsName, NamespaceMemStat &stat);
+	/// Get latency statistics of selects, upserts, deletes and commits of all opened namespaces, and of each query shape
+	/// @param stats - std::vector of NamespacePerfStat
+	Error GetPerfStats(vector<NamespacePerfStat> &stats);
+	/// Configure log of slow queries. Selects, which took longer than threshold, are stored with their plan and timings
+	/// @param thresholdUs - Min duration of logged query in microseconds. 0 - disable log
+	/// @param maxEntries - Max count of stored queries. The oldest queries are dropped from log
+	Error ConfigureSlowQueryLog(uint64_t thresholdUs, size_t maxEntries = 100);
+	/// Get logged slow queries
+	/// @param entries - std::vector of SlowQueryEntry, from the newest to the oldest
+	Error GetSlowQueries(vector<SlowQueryEntry> &entries);
 	/// Set index parameters
 	/// @param nsName - Name of namespace
 	/// @param index - Name of index
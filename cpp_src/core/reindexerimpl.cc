@@ -1,8 +1,14 @@
 #include "core/reindexerimpl.h"
 #include <stdio.h>
+#include <algorithm>
 #include <chrono>
+#include <ctime>
 #include <thread>
+#include <unordered_set>
 #include "core/cjson/jsondecoder.h"
+#include "core/cjson/jsonencoder.h"
+#include "core/index/index.h"
+#include "core/nsselecter/joinhashtable.h"
 #include "core/selectfunc/selectfunc.h"
 #include "kx/kxsort.h"
 #include "namespacedef.h"
@@ -37,7 +43,102 @@ static thread_local reindexer_stat local_stat;
 #define STAT_FUNC(name)
 #endif
 
-ReindexerImpl::ReindexerImpl() { stopFlusher_ = false; }
+static uint64_t elapsedUs(high_resolution_clock::time_point tmStart) {
+	return duration_cast<microseconds>(high_resolution_clock::now() - tmStart).count();
+}
+
+// Hash table for join is built, when count of done nested selects, multiplied by kHashJoinProbeCost, reaches size of right side
+const size_t kHashJoinProbeCost = 64;
+// Max count of items of right side of join, for which hash table could be built
+const size_t kHashJoinMaxItems = 100000;
+
+// State of adaptive hash join of one joined query.
+// Join starts as nested selects for each item of main namespace (or batched selects for left joins),
+// and switches to hash table probes, when it becomes cheaper, than selects.
+struct HashJoinCtx {
+	typedef shared_ptr<HashJoinCtx> Ptr;
+	h_vector<int, 2> leftFields, rightFields;
+	// Estimated count of items of right side
+	size_t rightSize = 0;
+	size_t probes = 0;
+	JoinHashTable::Ptr table;
+};
+
+// Join keys could be hashed, if all conditions are AND equalities of scalar fields with the same types and without collation
+HashJoinCtx::Ptr ReindexerImpl::prepareHashJoin(const Query& jq, Namespace& ns, Namespace& jns,
+												 const SelectCtx::PreResult::Ptr& preResult) {
+	auto hctx = std::make_shared<HashJoinCtx>();
+	for (auto& je : jq.joinEntries_) {
+		if (je.op_ != OpAnd || je.condition_ != CondEq) return nullptr;
+		int left = ns.getIndexByName(je.index_), right = jns.getIndexByName(je.joinIndex_);
+		if (left >= ns.payloadType_->NumFields() || right >= jns.payloadType_->NumFields()) return nullptr;
+		auto &lidx = *ns.indexes_[left], &ridx = *jns.indexes_[right];
+		if (lidx.Opts().IsArray() || ridx.Opts().IsArray() || lidx.KeyType() != ridx.KeyType()) return nullptr;
+		if (lidx.Opts().collateOpts_.mode != CollateNone || ridx.Opts().collateOpts_.mode != CollateNone) return nullptr;
+		hctx->leftFields.push_back(left);
+		hctx->rightFields.push_back(right);
+	}
+
+	hctx->rightSize = jns.items_.size() - jns.free_.size();
+	if (preResult && preResult->mode == SelectCtx::PreResult::ModeIdSet) {
+		hctx->rightSize = preResult->ids.size();
+	} else if (preResult && preResult->mode == SelectCtx::PreResult::ModeIterators) {
+		for (auto& it : preResult->iterators) {
+			if (it.comparators_.empty() && it.op == OpAnd) hctx->rightSize = std::min(hctx->rightSize, size_t(it.GetMaxIterations()));
+		}
+	}
+	return hctx;
+}
+
+// Results of joined query for one join key. Equal join keys give equal results, so they are computed once per query
+struct JoinMemoEntry {
+	bool done = false;
+	bool found = false;
+	// Joined items are put to results. It's false, if join was done only to check match of item of main namespace
+	bool haveItems = false;
+	size_t offset = 0, count = 0;
+};
+typedef std::unordered_map<JoinHashTable::Key, JoinMemoEntry, JoinHashTable::hash_key, JoinHashTable::equal_key> JoinMemo;
+
+// Key of memo: values of all left fields of join conditions, each list of values is prefixed by its size
+static JoinHashTable::Key joinMemoKey(const Query& jq, const ConstPayload& payload) {
+	JoinHashTable::Key key;
+	KeyRefs vals;
+	for (auto& je : jq.joinEntries_) {
+		payload.Get(je.idxNo, vals);
+		key.push_back(KeyRef(int(vals.size())));
+		for (auto& v : vals) key.push_back(v);
+	}
+	return key;
+}
+
+// Put items, joined to item of main namespace, to results and memo
+static void putJoinedItems(JoinedResults& joined, int joinIdx, IdType id, const ItemRef* items, size_t count, JoinMemoEntry* memo) {
+	size_t offset = joined.Add(joinIdx, items, count);
+	if (count) joined.Link(id, joinIdx, offset, count);
+	if (memo) {
+		memo->haveItems = true;
+		memo->offset = offset;
+		memo->count = count;
+	}
+}
+
+static void putJoinedItems(JoinedResults& joined, int joinIdx, IdType id, const JoinHashTable& table, const h_vector<int, 1>& found,
+						   unsigned limit, JoinMemoEntry* memo) {
+	h_vector<ItemRef, 8> items;
+	size_t count = std::min(size_t(limit), size_t(found.size()));
+	for (size_t i = 0; i < count; ++i) items.push_back(table.Items()[found[i]]);
+	putJoinedItems(joined, joinIdx, id, items.size() ? &items[0] : nullptr, items.size(), memo);
+}
+
+// Max count of threads for parallel selects of merged queries. Calling thread is used too
+const size_t kMaxSelectWorkers = 7;
+
+ReindexerImpl::ReindexerImpl()
+	: ns_mutex("reindexer:namespaces"),
+	  selectWorkers_(std::min(size_t(std::max(std::thread::hardware_concurrency(), 1u) - 1), kMaxSelectWorkers)) {
+	stopFlusher_ = false;
+}
 
 ReindexerImpl::~ReindexerImpl() {
 	if (storagePath_.length()) {
@@ -100,7 +201,7 @@ Error ReindexerImpl::AddNamespace(const NamespaceDef& nsDef) {
 	shared_ptr<Namespace> ns;
 	try {
 		{
-			lock_guard<shared_timed_mutex> lock(ns_mutex);
+			lock_guard<profiled_shared_mutex> lock(ns_mutex);
 			if (namespaces.find(nsDef.name) != namespaces.end()) {
 				return Error(errParams, "Namespace '%s' already exists", nsDef.name.c_str());
 			}
@@ -129,7 +230,7 @@ Error ReindexerImpl::AddNamespace(const NamespaceDef& nsDef) {
 		if (nsDef.storage.IsEnabled()) {
 			ns->LoadFromStorage();
 		}
-		lock_guard<shared_timed_mutex> lock(ns_mutex);
+		lock_guard<profiled_shared_mutex> lock(ns_mutex);
 		namespaces.insert({nsDef.name, ns});
 	} catch (const Error& err) {
 		return err;
@@ -140,7 +241,7 @@ Error ReindexerImpl::OpenNamespace(const string& name, const StorageOpts& storag
 	shared_ptr<Namespace> ns;
 	try {
 		{
-			lock_guard<shared_timed_mutex> lock(ns_mutex);
+			lock_guard<profiled_shared_mutex> lock(ns_mutex);
 			if (namespaces.find(name) != namespaces.end()) {
 				return 0;
 			}
@@ -153,7 +254,7 @@ Error ReindexerImpl::OpenNamespace(const string& name, const StorageOpts& storag
 			ns->EnableStorage(storagePath_, storage);
 			ns->LoadFromStorage();
 		}
-		lock_guard<shared_timed_mutex> lock(ns_mutex);
+		lock_guard<profiled_shared_mutex> lock(ns_mutex);
 		namespaces.insert({name, ns});
 	} catch (const Error& err) {
 		return err;
@@ -167,7 +268,7 @@ Error ReindexerImpl::CloseNamespace(const string& _namespace) { return closeName
 Error ReindexerImpl::closeNamespace(const string& _namespace, bool dropStorage) {
 	shared_ptr<Namespace> ns;
 	try {
-		lock_guard<shared_timed_mutex> lock(ns_mutex);
+		lock_guard<profiled_shared_mutex> lock(ns_mutex);
 		auto nsIt = namespaces.find(_namespace);
 
 		if (nsIt == namespaces.end()) {
@@ -195,7 +296,9 @@ Error ReindexerImpl::Insert(const string& _namespace, Item& item) {
 	STAT_FUNC(insert);
 	try {
 		auto ns = getNamespace(_namespace);
+		auto tmStart = high_resolution_clock::now();
 		ns->Insert(item);
+		ns->perfCounters_->RecordUpsert(elapsedUs(tmStart));
 	} catch (const Error& err) {
 		return err;
 	}
@@ -206,7 +309,9 @@ Error ReindexerImpl::Update(const string& _namespace, Item& item) {
 	STAT_FUNC(update);
 	try {
 		auto ns = getNamespace(_namespace);
+		auto tmStart = high_resolution_clock::now();
 		ns->Update(item);
+		ns->perfCounters_->RecordUpsert(elapsedUs(tmStart));
 	} catch (const Error& err) {
 		return err;
 	}
@@ -217,7 +322,9 @@ Error ReindexerImpl::Upsert(const string& _namespace, Item& item) {
 	STAT_FUNC(upsert);
 	try {
 		auto ns = getNamespace(_namespace);
+		auto tmStart = high_resolution_clock::now();
 		ns->Upsert(item);
+		ns->perfCounters_->RecordUpsert(elapsedUs(tmStart));
 	} catch (const Error& err) {
 		return err;
 	}
@@ -263,7 +370,9 @@ Error ReindexerImpl::Delete(const string& _namespace, Item& item) {
 	STAT_FUNC(delete);
 	try {
 		auto ns = getNamespace(_namespace);
+		auto tmStart = high_resolution_clock::now();
 		ns->Delete(item);
+		ns->perfCounters_->RecordDelete(elapsedUs(tmStart));
 	} catch (const Error& err) {
 		return err;
 	}
@@ -273,7 +382,9 @@ Error ReindexerImpl::Delete(const Query& q, QueryResults& result) {
 	STAT_FUNC(delete);
 	try {
 		auto ns = getNamespace(q._namespace);
+		auto tmStart = high_resolution_clock::now();
 		ns->Delete(q, result);
+		ns->perfCounters_->RecordDelete(elapsedUs(tmStart));
 	} catch (const Error& err) {
 		return err;
 	}
@@ -307,11 +418,18 @@ struct ItemRefLess {
 };
 
 Error ReindexerImpl::Select(const Query& q, QueryResults& result) {
+	auto tmStart = high_resolution_clock::now();
 	NsLocker locks;
+	Namespace::Ptr mainNs;
 
 	if (!q.joinQueries_.empty() && !q.mergeQueries_.empty()) {
 		return Error(errParams, "Merge and join can't be in same query");
 	}
+	if (!q.mergeQueries_.empty()) {
+		bool grouped = !q.groupBy_.empty();
+		for (auto& mq : q.mergeQueries_) grouped = grouped || !mq.groupBy_.empty();
+		if (grouped) return Error(errParams, "Merge and group by can't be in same query");
+	}
 
 	try {
 		if (q.describe) {
@@ -331,7 +449,8 @@ Error ReindexerImpl::Select(const Query& q, QueryResults& result) {
 		}
 
 		// Loockup and lock namespaces
-		locks.Add(getNamespace(q._namespace));
+		mainNs = getNamespace(q._namespace);
+		locks.Add(mainNs);
 		for (auto& jq : q.joinQueries_) locks.Add(getNamespace(jq._namespace));
 		for (auto& mq : q.mergeQueries_) locks.Add(getNamespace(mq._namespace));
 		locks.Lock();
@@ -339,12 +458,14 @@ Error ReindexerImpl::Select(const Query& q, QueryResults& result) {
 		return err;
 	}
 
+	SelectExplain explain;
+	bool slowLogEnabled = slowQueryLog_.Enabled();
 	for (;;) {
 		try {
 			SelectFunctionsHolder func;
 			h_vector<Query, 4> queries;
 			JoinedSelectors joinedSelectors = prepareJoinedSelectors(q, result, locks, queries, func);
-			doSelect(q, result, joinedSelectors, locks, func);
+			doSelect(q, result, joinedSelectors, locks, func, slowLogEnabled ? &explain : nullptr);
 			result.lockResults();
 			func.Process(result);
 
@@ -359,6 +480,19 @@ Error ReindexerImpl::Select(const Query& q, QueryResults& result) {
 			}
 		}
 	}
+
+	uint64_t elapsed = elapsedUs(tmStart);
+	mainNs->perfCounters_->RecordSelect(q, elapsed);
+	if (slowLogEnabled && elapsed >= slowQueryLog_.Threshold()) {
+		SlowQueryEntry entry;
+		entry.time = time(nullptr);
+		entry.query = q.Dump();
+		entry.shape = q.Dump(true);
+		entry.totalTime = elapsed;
+		entry.itemsCount = result.size();
+		entry.explain = std::move(explain);
+		slowQueryLog_.Add(std::move(entry));
+	}
 	return 0;
 }
 
@@ -369,7 +503,7 @@ JoinedSelectors ReindexerImpl::prepareJoinedSelectors(const Query& q, QueryResul
 	auto ns = locks.Get(q._namespace);
 
 	if (!q.joinQueries_.empty()) {
-		result.joined_.reset(new unordered_map<IdType, QRVector>());
+		result.joined_.reset(new JoinedResults(q.joinQueries_.size()));
 	}
 	// For each joined queries
 	for (auto& jq : q.joinQueries_) {
@@ -407,106 +541,300 @@ JoinedSelectors ReindexerImpl::prepareJoinedSelectors(const Query& q, QueryResul
 		queries.push_back(std::move(jItemQ));
 		Query* pjItemQ = &queries.back();
 
-		auto joinedSelector = [&result, &jq, jns, preResult, pos, pjItemQ, &locks, &func](IdType id, ConstPayload payload, bool match) {
+		auto hashJoin = prepareHashJoin(jq, *ns, *jns, preResult);
+		bool memoizable = std::all_of(jq.joinEntries_.begin(), jq.joinEntries_.end(),
+									  [&ns](const QueryJoinEntry& je) { return je.idxNo < ns->payloadType_->NumFields(); });
+		auto memo = memoizable ? std::make_shared<JoinMemo>() : nullptr;
+
+		auto joinedSelector = [&result, &jq, jns, preResult, pos, pjItemQ, &locks, &func, hashJoin, memo](IdType id, ConstPayload payload,
+																										 bool match) {
 			local_stat.count_join++;  // Do not measure each join time (expensive). Just give count
-			// Put values to join conditions
-			int cnt = 0;
-			for (auto& je : jq.joinEntries_) {
-				payload.Get(je.idxNo, pjItemQ->entries[cnt].values);
-				cnt++;
+
+			JoinMemoEntry* memoEntry = nullptr;
+			if (memo) {
+				memoEntry = &(*memo)[joinMemoKey(jq, payload)];
+				if (memoEntry->done && (!match || !memoEntry->found || memoEntry->haveItems)) {
+					if (match && memoEntry->count) result.joined_->Link(id, pos, memoEntry->offset, memoEntry->count);
+					return memoEntry->found;
+				}
+			}
+
+			if (hashJoin && !hashJoin->table && hashJoin->rightSize <= kHashJoinMaxItems &&
+				++hashJoin->probes * kHashJoinProbeCost >= hashJoin->rightSize) {
+				// Select all items of right side once, in the same order, as nested selects do
+				Query allItemsQ(*pjItemQ);
+				allItemsQ.entries.clear();
+				allItemsQ.Limit(UINT_MAX);
+				QueryResults allItems;
+				SelectCtx ctx(allItemsQ, &locks);
+				if (jq.entries.size()) ctx.preResult = preResult;
+				ctx.skipIndexesLookup = true;
+				ctx.functions = &func;
+				jns->Select(allItems, ctx);
+
+				hashJoin->table = std::make_shared<JoinHashTable>(hashJoin->leftFields, hashJoin->rightFields);
+				hashJoin->table->Build(std::move(allItems), jns->payloadType_);
+				if (jq.debugLevel >= LogInfo) {
+					logPrintf(LogInfo, "Built hash table for join of '%s' with %d items", jq._namespace.c_str(),
+							  int(hashJoin->table->Size()));
+				}
 			}
-			pjItemQ->Limit(match ? jq.count : 0);
-			QueryResults joinItemR;
-
-			SelectCtx ctx(*pjItemQ, &locks);
-			if (jq.entries.size()) ctx.preResult = preResult;
-			ctx.matchedAtLeastOnce = false;
-			ctx.reqMatchedOnceFlag = true;
-			ctx.skipIndexesLookup = true;
-			ctx.functions = &func;
-			jns->Select(joinItemR, ctx);
 
-			bool found = joinItemR.size();
-			if (match && found) {
-				auto& jres = result.joined_->emplace(id, QRVector()).first->second;
+			bool found = false;
+			if (hashJoin && hashJoin->table) {
+				auto items = hashJoin->table->Find(payload);
+				found = items != nullptr;
+				if (match && found) putJoinedItems(*result.joined_, pos, id, *hashJoin->table, *items, jq.count, memoEntry);
+			} else {
+				// Put values to join conditions
+				int cnt = 0;
+				for (auto& je : jq.joinEntries_) {
+					payload.Get(je.idxNo, pjItemQ->entries[cnt].values);
+					cnt++;
+				}
+				pjItemQ->Limit(match ? jq.count : 0);
+				QueryResults joinItemR;
+
+				SelectCtx ctx(*pjItemQ, &locks);
+				if (jq.entries.size()) ctx.preResult = preResult;
+				ctx.matchedAtLeastOnce = false;
+				ctx.reqMatchedOnceFlag = true;
+				ctx.skipIndexesLookup = true;
+				ctx.functions = &func;
+				jns->Select(joinItemR, ctx);
+
+				found = ctx.matchedAtLeastOnce;
+				if (match && found) {
+					putJoinedItems(*result.joined_, pos, id, joinItemR.size() ? &joinItemR[0] : nullptr, joinItemR.size(), memoEntry);
+				}
+			}
+			if (memoEntry) memoEntry->done = true, memoEntry->found = found;
+			return found;
+		};
+		joinedSelectors.push_back({jq.joinType, jq.count == 0, joinedSelector, 0, 0, jns->name_, nullptr});
+		if (jq.joinType != JoinType::LeftJoin || !hashJoin || hashJoin->leftFields.size() != 1) continue;
+
+		// Left join by one field is done by one select with set of distinct keys of batch items
+		joinedSelectors.back().batchFunc = [&result, &jq, ns, jns, preResult, pos, pjItemQ, &locks, &func, hashJoin, memo, joinedSelector](
+											   const vector<std::pair<IdType, PayloadValue>>& items) {
+			if (hashJoin->table || (hashJoin->rightSize <= kHashJoinMaxItems &&
+									(hashJoin->probes + items.size()) * kHashJoinProbeCost >= hashJoin->rightSize)) {
+				for (auto& item : items) joinedSelector(item.first, ConstPayload(ns->payloadType_, item.second), true);
+				return;
+			}
+			local_stat.count_join += items.size();
+			hashJoin->probes += items.size();
+
+			Query batchQ(*pjItemQ);
+			auto& qe = batchQ.entries[0];
+			qe.condition = CondSet;
+			qe.values.clear();
+			batchQ.Limit(UINT_MAX);
+
+			// Select only keys, which results are not memoized yet
+			std::unordered_set<JoinHashTable::Key, JoinHashTable::hash_key, JoinHashTable::equal_key> keys;
+			KeyRefs vals;
+			for (auto& item : items) {
+				ConstPayload pl(ns->payloadType_, item.second);
+				auto& memoEntry = (*memo)[joinMemoKey(jq, pl)];
+				if (memoEntry.done && (!memoEntry.found || memoEntry.haveItems)) continue;
+				pl.Get(hashJoin->leftFields[0], vals);
+				if (vals.size() == 1 && keys.insert(JoinHashTable::Key{vals[0]}).second) qe.values.push_back(KeyValue(vals[0]));
+			}
 
-				if (pos >= jres.size()) jres.resize(pos + 1);
+			JoinHashTable table(hashJoin->leftFields, hashJoin->rightFields);
+			if (!qe.values.empty()) {
+				QueryResults batchRes;
+				SelectCtx ctx(batchQ, &locks);
+				if (jq.entries.size()) ctx.preResult = preResult;
+				ctx.skipIndexesLookup = true;
+				ctx.functions = &func;
+				jns->Select(batchRes, ctx);
+				table.Build(std::move(batchRes), jns->payloadType_);
+			}
 
-				jres[pos] = std::move(joinItemR);
+			for (auto& item : items) {
+				ConstPayload pl(ns->payloadType_, item.second);
+				auto& memoEntry = (*memo)[joinMemoKey(jq, pl)];
+				if (memoEntry.done && (!memoEntry.found || memoEntry.haveItems)) {
+					if (memoEntry.count) result.joined_->Link(item.first, pos, memoEntry.offset, memoEntry.count);
+					continue;
+				}
+				auto found = table.Find(pl);
+				if (found) putJoinedItems(*result.joined_, pos, item.first, table, *found, jq.count, &memoEntry);
+				memoEntry.done = true;
+				memoEntry.found = found != nullptr;
 			}
-			return ctx.matchedAtLeastOnce;
 		};
-		joinedSelectors.push_back({jq.joinType, jq.count == 0, joinedSelector, 0, 0, jns->name_});
 	}
 	return joinedSelectors;
 }
 
 void ReindexerImpl::doSelect(const Query& q, QueryResults& result, JoinedSelectors& joinedSelectors, NsLocker& locks,
-							 SelectFunctionsHolder& func) {
+							 SelectFunctionsHolder& func, SelectExplain* explain) {
 	auto ns = locks.Get(q._namespace);
 	if (!ns) {
 		throw Error(errParams, "Namespace '%s' is not exists", q._namespace.c_str());
 	}
 
-	{
+	if (q.mergeQueries_.empty()) {
 		STAT_FUNC(select);
 		SelectCtx ctx(q, &locks);
 		ctx.functions = &func;
 		ctx.joinedSelectors = &joinedSelectors;
+		ctx.explain = explain;
 		ctx.nsid = 0;
-		ctx.isForceAll = !q.mergeQueries_.empty() || !q.forcedSortOrder.empty();
+		ctx.isForceAll = !q.forcedSortOrder.empty();
 		ns->Select(result, ctx);
+	} else {
+		doMergeSelect(q, result, locks, func, explain);
 	}
-	if (!q.mergeQueries_.empty()) {
-		uint8_t counter = 0;
-
-		for (auto& mq : q.mergeQueries_) {
-			auto mns = locks.Get(mq._namespace);
-			STAT_FUNC(select);
-			SelectCtx ctx(mq, &locks);
-			ctx.nsid = ++counter;
-			ctx.isForceAll = true;
-			ctx.functions = &func;
+	// dummy selects for put ctx-es
+	for (auto& jq : q.joinQueries_) {
+		auto jns = locks.Get(jq._namespace);
+		Query tmpq(jq._namespace);
+		tmpq.Limit(0);
+		tmpq.selectFilter_ = jq.selectFilter_;
+		SelectCtx ctx(tmpq, &locks);
+		ctx.functions = &func;
+		jns->Select(result, ctx);
+	}
+}
 
-			mns->Select(result, ctx);
+// Merge results of queries, each sorted by ItemRefLess, to one sorted result, and apply offset and limit to it
+static void mergeSortedResults(vector<QueryResults>& parts, QueryResults& result, unsigned start, unsigned count) {
+	size_t total = 0;
+	for (auto& part : parts) total += part.size();
+	result.reserve(std::min(total - std::min(total, size_t(start)), size_t(count)));
+
+	// Heap of positions (part, item) with the least item on the top
+	typedef std::pair<size_t, size_t> Pos;
+	auto greater = [&parts](const Pos& lhs, const Pos& rhs) {
+		return ItemRefLess()(parts[rhs.first][rhs.second], parts[lhs.first][lhs.second]);
+	};
+	vector<Pos> heap;
+	heap.reserve(parts.size());
+	for (size_t i = 0; i < parts.size(); ++i) {
+		if (parts[i].size()) heap.push_back({i, 0});
+	}
+	std::make_heap(heap.begin(), heap.end(), greater);
+	while (!heap.empty() && count) {
+		std::pop_heap(heap.begin(), heap.end(), greater);
+		auto& top = heap.back();
+		if (start) {
+			--start;
+		} else {
+			result.Add(parts[top.first][top.second]);
+			--count;
 		}
-
-		if (static_cast<size_t>(q.start) >= result.size()) {
-			result.Erase(result.begin(), result.end());
-			return;
+		if (++top.second < parts[top.first].size()) {
+			std::push_heap(heap.begin(), heap.end(), greater);
+		} else {
+			heap.pop_back();
 		}
+	}
 
-		std::sort(result.begin(), result.end(), ItemRefLess());
-		if (q.calcTotal) {
-			result.totalCount = result.size();
-		}
+	for (auto& part : parts) {
+		result.addNSContexts(part);
+		result.haveProcent |= part.haveProcent;
+		result.nonCacheableData |= part.nonCacheableData;
+		for (auto& ag : part.aggregationResults) result.aggregationResults.push_back(ag);
+		for (auto& facets : part.aggregationFacets) result.aggregationFacets.push_back(std::move(facets));
+	}
+}
 
-		if (q.start > 0) {
-			auto end = q.start < result.size() ? result.begin() + q.start : result.end();
-			result.Erase(result.begin(), end);
+void ReindexerImpl::doMergeSelect(const Query& q, QueryResults& result, NsLocker& locks, SelectFunctionsHolder& func,
+								  SelectExplain* explain) {
+	vector<const Query*> queries{&q};
+	for (auto& mq : q.mergeQueries_) queries.push_back(&mq);
+
+	// Only top items of each query could get into merged results after offset and limit
+	unsigned limit = (q.count == UINT_MAX || q.start > UINT_MAX - q.count) ? UINT_MAX : q.start + q.count;
+
+	// Selects of different namespaces are independent, so they could be done in parallel. Select of the same namespace
+	// could commit it, and concurrent commits of one namespace are not allowed even under exclusive lock
+	bool parallel = selectWorkers_.Size() > 0;
+	for (size_t i = 0; i < queries.size() && parallel; ++i) {
+		for (size_t j = 0; j < i && parallel; ++j) parallel = queries[i]->_namespace != queries[j]->_namespace;
+	}
+
+	ParallelLockUpgrader upgrader(locks);
+	vector<QueryResults> parts(queries.size());
+	vector<size_t> totals(queries.size());
+	auto selectPart = [&](size_t i) {
+		auto ns = locks.Get(queries[i]->_namespace);
+		// Items of query without ranks and sort are ordered by ids in merged results. So if they are selected in order of ids,
+		// select could be stopped after limit, instead of selecting all items and sorting them
+		bool pushDown = limit != UINT_MAX && !q.calcTotal && canPushDownMergeLimit(*queries[i], *ns);
+		// Offset and limit are applied once, by merge of parts, and selecter applies them to forced all results too.
+		// So limits and offsets of parts are ignored, and with push down only top items are selected
+		const Query* partQ = queries[i];
+		Query limitedQ;
+		if (pushDown || partQ->start != 0 || partQ->count != UINT_MAX) {
+			limitedQ = *partQ;
+			limitedQ.Offset(0).Limit(pushDown ? limit : UINT_MAX);
+			partQ = &limitedQ;
 		}
 
-		if (result.size() > q.count) {
-			result.Erase(result.begin() + q.count, result.end());
+		SelectCtx ctx(*partQ, parallel ? static_cast<SelectLockUpgrader*>(&upgrader) : &locks);
+		ctx.functions = &func;
+		ctx.explain = i == 0 ? explain : nullptr;
+		ctx.nsid = i;
+		ctx.isForceAll = !pushDown;
+		ctx.selectInIdsOrder = pushDown;
+		ns->Select(parts[i], ctx);
+
+		auto& part = parts[i];
+		totals[i] = part.size();
+		if (pushDown) return;
+		if (part.size() > limit) {
+			std::partial_sort(part.begin(), part.begin() + limit, part.end(), ItemRefLess());
+			part.Erase(part.begin() + limit, part.end());
+		} else {
+			std::sort(part.begin(), part.end(), ItemRefLess());
 		}
+	};
 
-		if (q.start) {
-			result.Erase(result.begin(), result.begin() + q.start);
+	if (parallel) {
+		vector<Error> errors(queries.size());
+		{
+			// Stats are thread local, so parallel parts are measured at once by calling thread
+			STAT_FUNC(select);
+			selectWorkers_.Run(queries.size(), [&](size_t i) {
+				try {
+					selectPart(i);
+				} catch (const Error& err) {
+					errors[i] = err;
+				}
+			});
 		}
-		if (static_cast<size_t>(q.count) < result.size()) {
-			result.Erase(result.begin() + q.count, result.end());
+		// Upgrade throws errWasRelock, and query is retried with upgraded locks
+		if (upgrader.Requested()) locks.Upgrade();
+		for (auto& err : errors) {
+			if (!err.ok()) throw err;
+		}
+	} else {
+		for (size_t i = 0; i < queries.size(); ++i) {
+			STAT_FUNC(select);
+			selectPart(i);
 		}
 	}
-	// dummy selects for put ctx-es
-	for (auto& jq : q.joinQueries_) {
-		auto jns = locks.Get(jq._namespace);
-		Query tmpq(jq._namespace);
-		tmpq.Limit(0);
-		tmpq.selectFilter_ = jq.selectFilter_;
-		SelectCtx ctx(tmpq, &locks);
-		ctx.functions = &func;
-		jns->Select(result, ctx);
+
+	mergeSortedResults(parts, result, q.start, q.count);
+	if (q.calcTotal) {
+		result.totalCount = 0;
+		for (auto total : totals) result.totalCount += total;
+	}
+}
+
+bool ReindexerImpl::canPushDownMergeLimit(const Query& q, Namespace& ns) {
+	if (!q.sortBy.empty() || !q.forcedSortOrder.empty() || !q.aggregations_.empty() || !q.selectFunctions_.empty()) return false;
+	// Full text queries are ordered by ranks
+	for (auto& qe : q.entries) {
+		auto it = ns.indexesNames_.find(qe.index);
+		if (it != ns.indexesNames_.end() && isFullText(ns.indexes_[it->second]->Type())) return false;
 	}
+	return true;
 }
 
 Error ReindexerImpl::Commit(const string& _namespace) {
@@ -532,7 +860,7 @@ Error ReindexerImpl::ConfigureIndex(const string& _namespace, const string& inde
 }
 
 shared_ptr<Namespace> ReindexerImpl::getNamespace(const string& _namespace) {
-	shared_lock<shared_timed_mutex> lock(ns_mutex);
+	shared_lock<profiled_shared_mutex> lock(ns_mutex);
 	auto nsIt = namespaces.find(_namespace);
 
 	if (nsIt == namespaces.end()) {
@@ -572,7 +900,7 @@ Error ReindexerImpl::DropIndex(const string& _namespace, const string& index) {
 }
 
 Error ReindexerImpl::EnumNamespaces(vector<NamespaceDef>& defs, bool bEnumAll) {
-	shared_lock<shared_timed_mutex> lock(ns_mutex);
+	shared_lock<profiled_shared_mutex> lock(ns_mutex);
 
 	for (auto& ns : namespaces) {
 		defs.push_back(ns.second->GetDefinition());
@@ -597,12 +925,49 @@ Error ReindexerImpl::EnumNamespaces(vector<NamespaceDef>& defs, bool bEnumAll) {
 	return 0;
 }
 
+Error ReindexerImpl::GetCacheStats(vector<NamespaceCacheStats>& stats) {
+	shared_lock<profiled_shared_mutex> lock(ns_mutex);
+
+	for (auto& ns : namespaces) {
+		stats.push_back(ns.second->GetCacheStats());
+	}
+	return 0;
+}
+
+Error ReindexerImpl::GetMemStat(const string& _namespace, NamespaceMemStat& stat) {
+	try {
+		stat = getNamespace(_namespace)->GetMemStat();
+	} catch (const Error& err) {
+		return err;
+	}
+	return 0;
+}
+
+Error ReindexerImpl::GetPerfStats(vector<NamespacePerfStat>& stats) {
+	shared_lock<profiled_shared_mutex> lock(ns_mutex);
+
+	for (auto& ns : namespaces) {
+		stats.push_back(ns.second->GetPerfStat());
+	}
+	return 0;
+}
+
+Error ReindexerImpl::ConfigureSlowQueryLog(uint64_t thresholdUs, size_t maxEntries) {
+	slowQueryLog_.Configure(thresholdUs, maxEntries);
+	return 0;
+}
+
+Error ReindexerImpl::GetSlowQueries(vector<SlowQueryEntry>& entries) {
+	entries = slowQueryLog_.Get();
+	return 0;
+}
+
 void ReindexerImpl::flusherThread() {
 	vector<string> nsarray;
 	while (!stopFlusher_) {
 		nsarray.clear();
 		{
-			shared_lock<shared_timed_mutex> lock(ns_mutex);
+			shared_lock<profiled_shared_mutex> lock(ns_mutex);
 			for (auto ns : namespaces) nsarray.push_back(ns.first);
 		}
 
@@ -11,12 +11,15 @@
 #include "estl/shared_mutex.h"
 #include "query/querycache.h"
 #include "tools/errors.h"
+#include "tools/threadpool.h"
 
 using std::shared_ptr;
 using std::string;
 
 namespace reindexer {
 
+struct HashJoinCtx;
+
 class ReindexerImpl {
 public:
 	ReindexerImpl();
@@ -30,6 +33,11 @@ public:
 	Error AddIndex(const string &_namespace, const IndexDef &index);
 	Error DropIndex(const string &_namespace, const string &index);
 	Error EnumNamespaces(vector<NamespaceDef> &defs, bool bEnumAll);
+	Error GetCacheStats(vector<NamespaceCacheStats> &stats);
+	Error GetMemStat(const string &_namespace, NamespaceMemStat &stat);
+	Error GetPerfStats(vector<NamespacePerfStat> &stats);
+	Error ConfigureSlowQueryLog(uint64_t thresholdUs, size_t maxEntries);
+	Error GetSlowQueries(vector<SlowQueryEntry> &entries);
 	Error ConfigureIndex(const string &_namespace, const string &index, const string &config);
 	Error Insert(const string &_namespace, Item &item);
 	Error Update(const string &_namespace, Item &item);
@@ -47,7 +55,7 @@ public:
 	Error GetStats(reindexer_stat &stat);
 
 protected:
-	class NsLocker : public SelectLockUpgrader, h_vector<pair<Namespace::Ptr, smart_lock<shared_timed_mutex>>, 4> {
+	class NsLocker : public SelectLockUpgrader, h_vector<pair<Namespace::Ptr, smart_lock<profiled_shared_mutex>>, 4> {
 	public:
 		~NsLocker() {
 			while (size()) {
@@ -57,8 +65,8 @@ protected:
 		virtual void Upgrade() override {
 			assert(locked_);
 			if (upgraded_) return;
-			for (auto it = rbegin(); it != rend(); it++) it->second = smart_lock<shared_timed_mutex>();
-			for (auto it = begin(); it != end(); it++) it->second = smart_lock<shared_timed_mutex>(it->first->mtx_, true);
+			for (auto it = rbegin(); it != rend(); it++) it->second = smart_lock<profiled_shared_mutex>();
+			for (auto it = begin(); it != end(); it++) it->second = smart_lock<profiled_shared_mutex>(it->first->mtx_, true);
 			upgraded_ = true;
 			if (size() > 1) {
 				throw Error(errWasRelock, "Internal - was lock upgrade, need retry");
@@ -70,14 +78,14 @@ protected:
 			for (auto it = begin(); it != end(); it++)
 				if (it->first.get() == ns.get()) return;
 
-			push_back({ns, smart_lock<shared_timed_mutex>()});
+			push_back({ns, smart_lock<profiled_shared_mutex>()});
 			return;
 		}
 		void Lock() {
 			std::sort(begin(), end(),
-					  [](const pair<Namespace::Ptr, smart_lock<shared_timed_mutex>> &lhs,
-						 const pair<Namespace::Ptr, smart_lock<shared_timed_mutex>> &rhs) { return lhs.first.get() < rhs.first.get(); });
-			for (auto it = begin(); it != end(); it++) it->second = smart_lock<shared_timed_mutex>(it->first->mtx_, false);
+					  [](const pair<Namespace::Ptr, smart_lock<profiled_shared_mutex>> &lhs,
+						 const pair<Namespace::Ptr, smart_lock<profiled_shared_mutex>> &rhs) { return lhs.first.get() < rhs.first.get(); });
+			for (auto it = begin(); it != end(); it++) it->second = smart_lock<profiled_shared_mutex>(it->first->mtx_, false);
 			locked_ = true;
 		}
 
@@ -86,14 +94,36 @@ protected:
 				if (it->first->name_ == name) return it->first;
 			return nullptr;
 		}
+		bool Upgraded() const { return upgraded_; }
 
 	protected:
 		bool locked_ = false;
 		bool upgraded_ = false;
 	};
-	void doSelect(const Query &q, QueryResults &res, JoinedSelectors &joinedSelectors, NsLocker &locker, SelectFunctionsHolder &func);
+	// Lock upgrader for selects, running in parallel. Locks can't be upgraded, while other selects are running,
+	// so select is interrupted, and locks are upgraded after all selects are done
+	class ParallelLockUpgrader : public SelectLockUpgrader {
+	public:
+		ParallelLockUpgrader(NsLocker &locks) : locks_(locks), requested_(false) {}
+		virtual void Upgrade() override {
+			if (locks_.Upgraded()) return;
+			requested_ = true;
+			throw Error(errWasRelock, "Internal - lock upgrade is required in parallel select, need retry");
+		}
+		bool Requested() const { return requested_; }
+
+	protected:
+		NsLocker &locks_;
+		std::atomic<bool> requested_;
+	};
+	void doSelect(const Query &q, QueryResults &res, JoinedSelectors &joinedSelectors, NsLocker &locker, SelectFunctionsHolder &func,
+				  SelectExplain *explain);
 	JoinedSelectors prepareJoinedSelectors(const Query &q, QueryResults &result, NsLocker &locks, h_vector<Query, 4> &queries,
 										   SelectFunctionsHolder &func);
+	void doMergeSelect(const Query &q, QueryResults &res, NsLocker &locker, SelectFunctionsHolder &func, SelectExplain *explain);
+	static bool canPushDownMergeLimit(const Query &q, Namespace &ns);
+	static std::shared_ptr<HashJoinCtx> prepareHashJoin(const Query &jq, Namespace &ns, Namespace &jns,
+														const SelectCtx::PreResult::Ptr &preResult);
 
 	void flusherThread();
 	Error closeNamespace(const string &_namespace, bool dropStorage);
@@ -101,11 +131,15 @@ protected:
 
 	fast_hash_map<string, Namespace::Ptr> namespaces;
 
-	shared_timed_mutex ns_mutex;
+	profiled_shared_mutex ns_mutex;
 	string storagePath_;
 
 	std::thread flusher_;
 	std::atomic<bool> stopFlusher_;
+
+	SlowQueryLog slowQueryLog_;
+	// Workers for parallel selects of merged queries
+	ThreadPool selectWorkers_;
 };
 
 }  // namespace reindexer
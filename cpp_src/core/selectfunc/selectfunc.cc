@@ -26,7 +26,9 @@ static inline void trim(std::string &s) {
 SelectFunction::Ptr SelectFunctionsHolder::AddNamespace(const Query &q, const Namespace &nm, bool force) {
 	if (q.selectFunctions_.empty() && !force) {
 		return nullptr;
-	} else if (!q.selectFunctions_.empty()) {
+	}
+	std::lock_guard<std::mutex> lck(mtx_);
+	if (!q.selectFunctions_.empty()) {
 		force_only_ = false;
 	}
 
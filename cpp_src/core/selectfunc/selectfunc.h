@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include <set>
 #include "core/query/query.h"
 #include "core/query/queryresults.h"
@@ -33,5 +34,7 @@ public:
 private:
 	bool force_only_ = true;
 	unique_ptr<fast_hash_map<string, SelectFunction::Ptr>> querys_;
+	// Merged queries could be selected in parallel
+	std::mutex mtx_;
 };
 }  // namespace reindexer
@@ -31,6 +31,7 @@ typedef enum IndexType {
 	IndexStrStore = 15,
 	IndexDoubleStore = 16,
 	IndexCompositeFuzzyFT = 17,
+	IndexPointGrid = 18,
 } IndexType;
 
 typedef enum QueryItemType {
@@ -45,6 +46,10 @@ typedef enum QueryItemType {
 	QueryAggregation,
 	QuerySelectFilter,
 	QuerySelectFunction,
+	QueryCacheResults,
+	QueryAggregationLimit,
+	QueryGroupBy,
+	QueryApproxAggregations,
 	QueryEnd
 } QueryItemType;
 
@@ -66,6 +71,8 @@ typedef enum CondType {
 	CondSet = 7,
 	CondAllSet = 8,
 	CondEmpty = 9,
+	CondDWithin = 10,
+	CondBox = 11,
 } CondType;
 
 enum ErrorCode {
@@ -85,13 +92,13 @@ enum ErrorCode {
 
 enum OpType { OpOr = 1, OpAnd = 2, OpNot = 3 };
 
-enum AggType { AggSum, AggAvg };
+enum AggType { AggSum, AggAvg, AggFacet, AggMin, AggMax, AggCount, AggCountDistinct, AggCountDistinctApprox };
 
 enum { TAG_VARINT, TAG_DOUBLE, TAG_STRING, TAG_ARRAY, TAG_BOOL, TAG_NULL, TAG_OBJECT, TAG_END };
 
 enum JoinType { LeftJoin, InnerJoin, OrInnerJoin, Merge };
 
-enum CalcTotalMode { ModeNoTotal, ModeCachedTotal, ModeAccurateTotal };
+enum CalcTotalMode { ModeNoTotal, ModeCachedTotal, ModeAccurateTotal, ModeApproxTotal };
 
 enum DataFormat { FormatJson, FormatCJson };
 
@@ -109,9 +116,16 @@ enum {
 	kResultsWithCJson = 0x2,
 	kResultsWithJson = 0x3,
 	kResultsWithPayloadTypes = 0x8,
+	kResultsWithGroups = 0x10,
 };
 
-typedef enum IndexOpt { kIndexOptPK = 1 << 7, kIndexOptArray = 1 << 6, kIndexOptDense = 1 << 5, kIndexOptAppendable = 1 << 4 } IndexOpt;
+typedef enum IndexOpt {
+	kIndexOptPK = 1 << 7,
+	kIndexOptArray = 1 << 6,
+	kIndexOptDense = 1 << 5,
+	kIndexOptAppendable = 1 << 4,
+	kIndexOptSparse = 1 << 3
+} IndexOpt;
 
 typedef enum StotageOpt {
 	kStorageOptEnabled = 1 << 0,
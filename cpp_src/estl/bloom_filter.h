@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace reindexer {
+
+// Cache blocked Bloom filter over 64-bit hashes.
+// All bits of the key are placed into single 512-bit block, so each lookup touches at most one cache line.
+// Filter does not support deletes: owner must rebuild it, when set of keys changes significantly.
+class blocked_bloom_filter {
+public:
+	blocked_bloom_filter() : size_(0), capacity_(0) {}
+	// Create filter for 'capacity' keys with about 1% false positive rate
+	explicit blocked_bloom_filter(size_t capacity) : size_(0), capacity_(capacity) {
+		size_t blocks = (capacity * kBitsPerKey + kBlockBits - 1) / kBlockBits;
+		data_.resize((blocks ? blocks : 1) * kBlockWords, 0);
+	}
+
+	void add(uint64_t hash) {
+		hash = mix(hash);
+		uint64_t *block = blockOf(hash);
+		uint32_t h1 = uint32_t(hash), h2 = ((h1 >> 17) | (h1 << 15)) | 1;
+		for (int i = 0; i < kHashes; i++, h1 += h2) block[(h1 >> 6) & (kBlockWords - 1)] |= uint64_t(1) << (h1 & 63);
+		size_++;
+	}
+
+	bool may_contain(uint64_t hash) const {
+		if (data_.empty()) return false;
+		hash = mix(hash);
+		const uint64_t *block = blockOf(hash);
+		uint32_t h1 = uint32_t(hash), h2 = ((h1 >> 17) | (h1 << 15)) | 1;
+		for (int i = 0; i < kHashes; i++, h1 += h2)
+			if (!(block[(h1 >> 6) & (kBlockWords - 1)] & (uint64_t(1) << (h1 & 63)))) return false;
+		return true;
+	}
+
+	// Count of keys added to filter
+	size_t size() const { return size_; }
+	// Count of keys, filter was sized for
+	size_t capacity() const { return capacity_; }
+	bool empty() const { return data_.empty(); }
+	size_t heap_size() const { return data_.capacity() * sizeof(uint64_t); }
+
+protected:
+	enum { kBlockBits = 512, kBlockWords = kBlockBits / 64, kBitsPerKey = 10, kHashes = 7 };
+
+	// Keys hashes can be weak (e.g. std::hash<int> is identity), so mix bits before use
+	static uint64_t mix(uint64_t h) {
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return h;
+	}
+	uint64_t *blockOf(uint64_t hash) { return &data_[((hash >> 32) % (data_.size() / kBlockWords)) * kBlockWords]; }
+	const uint64_t *blockOf(uint64_t hash) const { return &data_[((hash >> 32) % (data_.size() / kBlockWords)) * kBlockWords]; }
+
+	std::vector<uint64_t> data_;
+	size_t size_;
+	size_t capacity_;
+};
+
+}  // namespace reindexer
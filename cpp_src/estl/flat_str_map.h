@@ -199,6 +199,9 @@ public:
 		if (Multi) multi_.reserve(map_sz / 10);
 	}
 	size_t size() { return map_.size(); }
+	size_t heap_size() const {
+		return buf_.capacity() + map_.bucket_count() * sizeof(typename hash_map::value_type) + multi_.capacity() * sizeof(multi_node);
+	}
 
 	void shrink_to_fit() {
 		buf_.shrink_to_fit();
@@ -250,6 +250,8 @@ public:
 	}
 	size_type size() const noexcept { return size_; }
 	size_type capacity() const noexcept { return is_hdata_ ? holdSize : e_.cap_; }
+	// Size of memory, allocated on heap. Elements inside holdSize are not counted
+	size_t heap_size() const noexcept { return is_hdata_ ? 0 : e_.cap_ * sizeof(T); }
 	bool empty() const noexcept { return size_ == 0; }
 	const_reference operator[](size_type pos) const { return ptr()[pos]; }
 	reference operator[](size_type pos) { return ptr()[pos]; }
@@ -76,6 +76,7 @@ public:
 	}
 	void shrink_to_fit() { data_.shrink_to_fit(); }
 	size_type real_size() { return data_.size(); }
+	size_t heap_size() const { return data_.heap_size(); }
 	void clear() {
 		data_.clear();
 		size_ = 0;
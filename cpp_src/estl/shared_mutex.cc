@@ -0,0 +1,71 @@
+#include "shared_mutex.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace reindexer {
+
+std::atomic<bool> profiled_shared_mutex::enabled_{true};
+
+// Registry of alive mutexes. Never destroyed, because mutexes of static objects could outlive it
+static std::mutex &registryMutex() {
+	static std::mutex *mtx = new std::mutex;
+	return *mtx;
+}
+
+static std::vector<profiled_shared_mutex *> &registry() {
+	static std::vector<profiled_shared_mutex *> *reg = new std::vector<profiled_shared_mutex *>;
+	return *reg;
+}
+
+profiled_shared_mutex::profiled_shared_mutex(const std::string &name) : name_(name) {
+	std::lock_guard<std::mutex> lck(registryMutex());
+	registry().push_back(this);
+}
+
+profiled_shared_mutex::~profiled_shared_mutex() {
+	std::lock_guard<std::mutex> lck(registryMutex());
+	auto &reg = registry();
+	auto it = std::find(reg.begin(), reg.end(), this);
+	assert(it != reg.end());
+	*it = reg.back();
+	reg.pop_back();
+}
+
+void profiled_shared_mutex::set_name(const std::string &name) {
+	std::lock_guard<std::mutex> lck(registryMutex());
+	name_ = name;
+}
+
+std::vector<lock_stat> profiled_shared_mutex::get_stats() {
+	std::vector<lock_stat> stats;
+	std::unordered_map<std::string, size_t> byName;
+
+	std::unique_lock<std::mutex> lck(registryMutex());
+	for (auto mtx : registry()) {
+		auto it = byName.emplace(mtx->name_, stats.size());
+		if (it.second) {
+			stats.push_back(lock_stat());
+			stats.back().name = mtx->name_;
+		}
+		auto &stat = stats[it.first->second];
+		stat.instances++;
+		stat.acquisitions += mtx->acquisitions_.load(std::memory_order_relaxed);
+		stat.shared_acquisitions += mtx->shared_acquisitions_.load(std::memory_order_relaxed);
+		stat.contended += mtx->contended_.load(std::memory_order_relaxed);
+		stat.shared_contended += mtx->shared_contended_.load(std::memory_order_relaxed);
+		stat.wait_time += mtx->wait_time_.load(std::memory_order_relaxed);
+		stat.shared_wait_time += mtx->shared_wait_time_.load(std::memory_order_relaxed);
+		stat.max_wait_time = std::max(stat.max_wait_time, mtx->max_wait_time_.load(std::memory_order_relaxed));
+		stat.hold_time += mtx->hold_time_.load(std::memory_order_relaxed);
+		stat.max_hold_time = std::max(stat.max_hold_time, mtx->max_hold_time_.load(std::memory_order_relaxed));
+	}
+	lck.unlock();
+
+	std::sort(stats.begin(), stats.end(), [](const lock_stat &lhs, const lock_stat &rhs) {
+		return lhs.wait_time + lhs.shared_wait_time > rhs.wait_time + rhs.shared_wait_time;
+	});
+	return stats;
+}
+
+}  // namespace reindexer
@@ -157,6 +157,10 @@ public:
 		built_ = false;
 	}
 	size_type size() { return sa_.size(); }
+	size_t heap_size() const {
+		return (sa_.capacity() + words_.capacity()) * sizeof(int) + (lcp_.capacity() + words_len_.capacity()) * sizeof(int16_t) +
+			   mapped_.capacity() * sizeof(V) + text_.capacity();
+	}
 	const K &text() const { return text_; }
 
 protected:
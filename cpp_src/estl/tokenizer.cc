@@ -40,6 +40,12 @@ token tokenizer::next_token(bool to_lower) {
 		do {
 			res.text += *cur++;
 		} while (isdigit(*cur));
+		// Fractional part of double value, e.g. coordinates of points
+		if (*cur == '.' && isdigit(*(cur + 1))) {
+			do {
+				res.text += *cur++;
+			} while (isdigit(*cur));
+		}
 	} else if (*cur == '>' || *cur == '<' || *cur == '=') {
 		res.type = TokenOp;
 		do {
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""Benchmarks regression harness.
+
+Runs benchmark targets with fixed random seed and repetitions, stores google-benchmark JSON results,
+and compares them against baselines, checked in to baseline/<target>.json.
+
+Run fails, if any benchmark became slower (items per second, or time per iteration, if items are not counted),
+allocates more bytes per operation, or target's peak RSS has grown more than tolerance.
+Difference of timings must also exceed 3 standard deviations of repetitions, to filter out noise.
+Missing baseline of target is failure too, unless --allow-missing-baseline is passed.
+Benchmarks, which failed with error, or are present in baseline but missing in the current run, are regressions.
+
+Usage:
+    bench_regression.py --bin-dir <build>/gtests/bench                     # run and compare with baseline
+    bench_regression.py --bin-dir <build>/gtests/bench --update-baseline   # run and save results as new baseline
+    bench_regression.py --compare-only results/benchmarking.json           # compare saved results
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_TARGETS = ['benchmarking', 'ft_benchmarking', 'concurrent_benchmarking']
+AGGREGATES = ['mean', 'median', 'stddev']
+
+
+def run_target(binary, out_file, args):
+    cmd = [binary, '--benchmark_out=' + out_file, '--benchmark_out_format=json',
+           '--benchmark_repetitions=%d' % args.repetitions, '--benchmark_report_aggregates_only=true']
+    if args.filter:
+        cmd.append('--benchmark_filter=' + args.filter)
+    env = dict(os.environ, REINDEXER_BENCH_SEED=str(args.seed))
+    print('Running: ' + ' '.join(cmd))
+    # ft_benchmarking reads dictionary from source dir
+    proc = subprocess.Popen(cmd, env=env, cwd=SCRIPT_DIR)
+    _, status, rusage = os.wait4(proc.pid, 0)
+    if status != 0:
+        raise RuntimeError('%s failed with status %d' % (binary, status))
+
+    with open(out_file) as f:
+        result = json.load(f)
+    # ru_maxrss is in kilobytes on linux
+    result['context']['peak_rss_kb'] = rusage.ru_maxrss
+    with open(out_file, 'w') as f:
+        json.dump(result, f, indent=2)
+    return result
+
+
+def split_aggregate(bench):
+    """Returns (benchmark name, aggregate name) for both new and old google-benchmark JSON formats."""
+    if 'aggregate_name' in bench:
+        return bench.get('run_name', bench['name'].rsplit('_', 1)[0]), bench['aggregate_name']
+    for agg in AGGREGATES:
+        if bench['name'].endswith('_' + agg):
+            return bench['name'][:-len(agg) - 1], agg
+    return bench['name'], None
+
+
+def load_stats(result):
+    """Returns ({benchmark name: {aggregate: benchmark entry}}, {failed benchmark name: error message}).
+    Single runs are treated as median."""
+    stats, errors = {}, {}
+    for bench in result.get('benchmarks', []):
+        name, agg = split_aggregate(bench)
+        if bench.get('error_occurred'):
+            errors[name] = bench.get('error_message', '')
+            continue
+        stats.setdefault(name, {})[agg or 'median'] = bench
+    return stats, errors
+
+
+def metric(entries, key, agg='median'):
+    entry = entries.get(agg) or entries.get('mean')
+    if entry is None or key not in entry:
+        return None
+    return float(entry[key])
+
+
+def compare(baseline, current, tolerance, name_filter=None):
+    """Returns list of regressions descriptions and prints comparison table.
+    'name_filter' - regex of benchmarks, which were run. Baseline benchmarks, not matching it, are not expected"""
+    regressions = []
+    base_stats, _ = load_stats(baseline)
+    cur_stats, cur_errors = load_stats(current)
+
+    print('%-70s %-16s %14s %14s %9s' % ('Benchmark', 'Metric', 'Baseline', 'Current', 'Change'))
+    for name in sorted(cur_errors):
+        print('%-70s %s' % (name, 'FAILED: ' + cur_errors[name]))
+        regressions.append('%s: failed with error: %s' % (name, cur_errors[name]))
+    for name in sorted(base_stats):
+        if name in cur_stats or name in cur_errors or (name_filter and not re.search(name_filter, name)):
+            continue
+        print('%-70s %s' % (name, 'MISSING in current run'))
+        regressions.append('%s: missing in current run' % name)
+    for name in sorted(cur_stats):
+        cur = cur_stats[name]
+        base = base_stats.get(name)
+        if base is None:
+            print('%-70s %s' % (name, 'new benchmark, no baseline'))
+            continue
+
+        # (key, higher is better, check noise)
+        checks = [('Bytes/Op', False, False)]
+        if metric(cur, 'items_per_second') is not None and metric(base, 'items_per_second') is not None:
+            checks.insert(0, ('items_per_second', True, True))
+        else:
+            checks.insert(0, ('real_time', False, True))
+
+        for key, higher_better, check_noise in checks:
+            b, c = metric(base, key), metric(cur, key)
+            if b is None or c is None or b == 0:
+                continue
+            change = (c - b) / b
+            worse = -change if higher_better else change
+            regressed = worse > tolerance
+            if regressed and check_noise:
+                b_dev, c_dev = metric(base, key, 'stddev') or 0.0, metric(cur, key, 'stddev') or 0.0
+                regressed = abs(c - b) > 3 * math.sqrt(b_dev ** 2 + c_dev ** 2)
+            mark = ' REGRESSION' if regressed else ''
+            print('%-70s %-16s %14.2f %14.2f %+8.1f%%%s' % (name, key, b, c, change * 100, mark))
+            if regressed:
+                regressions.append('%s: %s %.2f -> %.2f (%+.1f%%)' % (name, key, b, c, change * 100))
+
+    b_rss, c_rss = baseline['context'].get('peak_rss_kb'), current['context'].get('peak_rss_kb')
+    if b_rss and c_rss:
+        change = float(c_rss - b_rss) / b_rss
+        regressed = change > tolerance
+        print('%-70s %-16s %14d %14d %+8.1f%%%s' % ('(process)', 'peak_rss_kb', b_rss, c_rss, change * 100,
+                                                     ' REGRESSION' if regressed else ''))
+        if regressed:
+            regressions.append('peak RSS %d kB -> %d kB (%+.1f%%)' % (b_rss, c_rss, change * 100))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run benchmarks and compare results with baseline')
+    parser.add_argument('--bin-dir', help='directory with benchmark binaries')
+    parser.add_argument('--targets', nargs='+', default=DEFAULT_TARGETS, help='benchmark targets to run')
+    parser.add_argument('--baseline-dir', default=os.path.join(SCRIPT_DIR, 'baseline'), help='directory with baselines')
+    parser.add_argument('--out-dir', default='bench_results', help='directory for results of run')
+    parser.add_argument('--seed', type=int, default=42, help='seed of random generators of benchmarks')
+    parser.add_argument('--repetitions', type=int, default=5, help='repetitions of each benchmark')
+    parser.add_argument('--tolerance', type=float, default=0.1, help='max allowed relative degradation')
+    parser.add_argument('--filter', help='regex of benchmarks to run')
+    parser.add_argument('--update-baseline', action='store_true', help='save results as new baseline')
+    parser.add_argument('--allow-missing-baseline', action='store_true', help='skip targets without baseline instead of failing')
+    parser.add_argument('--compare-only', nargs='+', metavar='RESULT', help='compare saved results, without running')
+    args = parser.parse_args()
+
+    results = {}
+    if args.compare_only:
+        for path in args.compare_only:
+            with open(path) as f:
+                results[os.path.splitext(os.path.basename(path))[0]] = json.load(f)
+    else:
+        if not args.bin_dir:
+            parser.error('--bin-dir is required to run benchmarks')
+        if not os.path.isdir(args.out_dir):
+            os.makedirs(args.out_dir)
+        for target in args.targets:
+            out_file = os.path.abspath(os.path.join(args.out_dir, target + '.json'))
+            results[target] = run_target(os.path.join(os.path.abspath(args.bin_dir), target), out_file, args)
+            if args.update_baseline:
+                if not os.path.isdir(args.baseline_dir):
+                    os.makedirs(args.baseline_dir)
+                shutil.copyfile(out_file, os.path.join(args.baseline_dir, target + '.json'))
+                print('Baseline of %s is updated' % target)
+        if args.update_baseline:
+            return 0
+
+    regressions = []
+    missing = []
+    for target, result in sorted(results.items()):
+        baseline_file = os.path.join(args.baseline_dir, target + '.json')
+        if not os.path.exists(baseline_file):
+            print('No baseline for %s, run with --update-baseline to create it' % target)
+            missing.append(target)
+            continue
+        with open(baseline_file) as f:
+            baseline = json.load(f)
+        print('\n=== %s' % target)
+        regressions += ['%s/%s' % (target, r) for r in compare(baseline, result, args.tolerance, args.filter)]
+
+    if regressions:
+        print('\nRegressions found:\n  ' + '\n  '.join(regressions))
+        return 1
+    if missing and not args.allow_missing_baseline:
+        print('\nNo baselines for: ' + ', '.join(missing))
+        return 1
+    print('\nNo regressions found')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
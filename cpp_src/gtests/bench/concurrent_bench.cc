@@ -0,0 +1,45 @@
+#include <iostream>
+
+#include "benchmark/benchmark.h"
+
+#include "mixed_workload.h"
+
+#include "tools/fsops.h"
+
+#include "core/reindexer.h"
+
+#define STORAGE_PATH "/tmp/reindex/concurrent_bench"
+
+using std::shared_ptr;
+using reindexer::Reindexer;
+
+shared_ptr<Reindexer> DB = std::make_shared<Reindexer>();
+
+#if defined(REINDEX_WITH_ASAN) || defined(REINDEX_WITH_TSAN)
+const int kItemsInBenchDataset = 5000;
+#else
+const int kItemsInBenchDataset = 200000;
+#endif
+
+int main(int argc, char** argv) {
+	if (reindexer::RmDirAll(STORAGE_PATH) < 0 && errno != ENOENT) {
+		std::cerr << "Could not clean working dir '" << STORAGE_PATH << "'.";
+		std::cerr << "Reason: " << strerror(errno) << std::endl;
+
+		return 1;
+	}
+
+	DB->EnableStorage(STORAGE_PATH);
+
+	MixedWorkload mixedWorkload(DB.get(), "MixedWorkload", kItemsInBenchDataset);
+
+	auto err = mixedWorkload.Initialize();
+	if (!err.ok()) return err.code();
+
+	::benchmark::Initialize(&argc, argv);
+	if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+	mixedWorkload.RegisterAllCases();
+
+	::benchmark::RunSpecifiedBenchmarks();
+}
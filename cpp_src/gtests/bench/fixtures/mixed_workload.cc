@@ -0,0 +1,146 @@
+#include "mixed_workload.h"
+#include <chrono>
+#include <thread>
+#include "allocs_tracker.h"
+#include "aux.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::microseconds;
+
+using benchmark::AllocsTracker;
+
+using reindexer::LatencyHistogram;
+using reindexer::LatencyStat;
+using reindexer::Query;
+using reindexer::QueryResults;
+
+static uint64_t elapsedUs(high_resolution_clock::time_point tmStart) {
+	return duration_cast<microseconds>(high_resolution_clock::now() - tmStart).count();
+}
+
+Error MixedWorkload::Initialize() {
+	assert(db_);
+	auto err = db_->AddNamespace(nsdef_);
+	if (!err.ok()) return err;
+
+	for (int i = 0; i < id_seq_->Count(); ++i) {
+		auto item = MakeItem();
+		if (!item.Status().ok()) return item.Status();
+		err = db_->Upsert(nsdef_.name, item);
+		if (!err.ok()) return err;
+	}
+	return db_->Commit(nsdef_.name);
+}
+
+void MixedWorkload::RegisterAllCases() {
+	const int readPercents[] = {100, 95, 80, 50};
+	int maxThreads = std::max(2 * int(std::thread::hardware_concurrency()), 1);
+	for (int readPercent : readPercents) {
+		auto b = Register("Mixed/Read" + std::to_string(readPercent), &MixedWorkload::Mixed, this);
+		b->Arg(readPercent)->UseRealTime();
+		for (int threads = 1; threads <= std::min(maxThreads, 16); threads *= 2) b->Threads(threads);
+	}
+}
+
+reindexer::Item MixedWorkload::MakeItem() {
+	Item item = db_->NewItem(nsdef_.name);
+	if (item.Status().ok()) {
+		item["id"] = random<int>(id_seq_->Start(), id_seq_->End());
+		item["genre"] = random<int>(0, 49);
+		item["year"] = random<int>(2000, 2049);
+		item["age"] = random<int>(0, 4);
+		item["name"] = "name_" + std::to_string(random<int>(0, 999));
+	}
+	return item;
+}
+
+void MixedWorkload::Mixed(State& state) {
+	// Setup and teardown of thread 0 are separated from iterations of all threads by barriers
+	std::unique_ptr<AllocsTracker> allocsTracker;
+	if (state.thread_index == 0) {
+		reads_.reset(new LatencyHistogram);
+		writes_.reset(new LatencyHistogram);
+		commits_.reset(new LatencyHistogram);
+		allocsTracker.reset(new AllocsTracker(state, AllocsTracker::kNoPrint));
+	}
+
+	int readPercent = state.range(0);
+	int writesSinceCommit = 0;
+	for (auto _ : state) {
+		if (random<int>(0, 99) < readPercent) {
+			read(state);
+		} else {
+			write(state, writesSinceCommit);
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index == 0) {
+		// Counters of all threads are summed up, so only thread 0 reports shared stats
+		auto report = [&state](const char* prefix, const LatencyStat& stat) {
+			if (!stat.count) return;
+			state.counters[string(prefix) + "p50_us"] = stat.p50;
+			state.counters[string(prefix) + "p99_us"] = stat.p99;
+			state.counters[string(prefix) + "p999_us"] = stat.p999;
+		};
+		report("R_", reads_->GetStat());
+		report("W_", writes_->GetStat());
+		report("C_", commits_->GetStat());
+		// Allocations are counted process wide, so they are divided by operations of all threads.
+		// Each thread runs the same count of iterations
+		size_t ops = std::max(size_t(state.iterations()) * state.threads, size_t(1));
+		state.counters["Bytes/Op"] = allocsTracker->GetCurrentMemoryConsumption() / ops;
+		state.counters["Allocs/Op"] = allocsTracker->GetCurrentAllocCount() / ops;
+	}
+}
+
+void MixedWorkload::read(State& state) {
+	auto tmStart = high_resolution_clock::now();
+	Query q(nsdef_.name);
+	switch (random<int>(0, 2)) {
+		case 0:
+			q.Where("id", CondEq, random<int>(id_seq_->Start(), id_seq_->End()));
+			break;
+		case 1:
+			// Sort by tree index requires sort orders, which are invalidated by writes
+			q.Where("year", CondRange, {2010, 2015}).Sort("genre", false).Limit(20);
+			break;
+		default:
+			q.Where("genre", CondEq, random<int>(0, 49)).Where("age", CondEq, random<int>(0, 4)).Limit(20);
+	}
+
+	QueryResults qres;
+	auto err = db_->Select(q, qres);
+	if (!err.ok()) {
+		state.SkipWithError(err.what().c_str());
+		return;
+	}
+	reads_->Record(elapsedUs(tmStart));
+}
+
+void MixedWorkload::write(State& state, int& writesSinceCommit) {
+	auto tmStart = high_resolution_clock::now();
+	auto item = MakeItem();
+	if (!item.Status().ok()) {
+		state.SkipWithError(item.Status().what().c_str());
+		return;
+	}
+	auto err = db_->Upsert(nsdef_.name, item);
+	if (!err.ok()) {
+		state.SkipWithError(err.what().c_str());
+		return;
+	}
+	writes_->Record(elapsedUs(tmStart));
+
+	if (++writesSinceCommit >= kCommitPeriod) {
+		writesSinceCommit = 0;
+		tmStart = high_resolution_clock::now();
+		err = db_->Commit(nsdef_.name);
+		if (!err.ok()) {
+			state.SkipWithError(err.what().c_str());
+			return;
+		}
+		commits_->Record(elapsedUs(tmStart));
+	}
+}
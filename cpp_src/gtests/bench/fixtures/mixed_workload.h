@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include "base_fixture.h"
+#include "core/perfstat.h"
+
+// Concurrent mixed read/write workload over the single namespace.
+// Each case runs in several threads with given percent of reads, and reports throughput and latency percentiles
+// of reads, writes and commits. Reads with sort by tree index take lock upgrade path after writes,
+// so the workload catches contention on namespace lock and stalls on commit.
+class MixedWorkload : protected BaseFixture {
+public:
+	virtual ~MixedWorkload() {}
+	MixedWorkload(Reindexer* db, const string& name, size_t maxItems) : BaseFixture(db, name, maxItems) {
+		AddIndex("id", "id", "hash", "int", IndexOpts().PK())
+			.AddIndex("genre", "genre", "tree", "int", IndexOpts())
+			.AddIndex("year", "year", "tree", "int", IndexOpts())
+			.AddIndex("age", "age", "hash", "int", IndexOpts())
+			.AddIndex("name", "name", "hash", "string", IndexOpts());
+	}
+
+	virtual Error Initialize();
+	virtual void RegisterAllCases();
+
+protected:
+	virtual Item MakeItem();
+
+	void Mixed(State& state);
+
+	void read(State& state);
+	void write(State& state, int& writesSinceCommit);
+
+	// Count of writes of each thread between commits
+	enum { kCommitPeriod = 1000 };
+
+	std::unique_ptr<reindexer::LatencyHistogram> reads_, writes_, commits_;
+};
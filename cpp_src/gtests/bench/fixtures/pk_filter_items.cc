@@ -0,0 +1,25 @@
+#include "pk_filter_items.h"
+
+#include "aux.h"
+
+reindexer::Error PKFilterItems::Initialize() {
+	assert(db_);
+	auto err = db_->AddNamespace(nsdef_);
+	if (!err.ok()) return err;
+
+	if (pkFilter_) return db_->ConfigureIndex(nsdef_.name, "id", R"({"pk_filter":true})");
+	return 0;
+}
+
+void PKFilterItems::RegisterAllCases() { BaseFixture::RegisterAllCases(); }
+
+reindexer::Item PKFilterItems::MakeItem() {
+	Item item = db_->NewItem(nsdef_.name);
+	if (item.Status().ok()) {
+		int id = id_seq_->Next();
+		item["id"] = id;
+		item["uuid"] = "uuid_" + std::to_string(id);
+		item["data"] = random<int>(0, 1000);
+	}
+	return item;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "base_fixture.h"
+
+// Insert throughput of namespace with composite PK, with and without PK filter
+class PKFilterItems : protected BaseFixture {
+public:
+	virtual ~PKFilterItems() {}
+
+	PKFilterItems(Reindexer* db, const string& name, size_t maxItems, bool pkFilter)
+		: BaseFixture(db, name, maxItems), pkFilter_(pkFilter) {
+		AddIndex("id", "id", "tree", "int", IndexOpts().PK())
+			.AddIndex("uuid", "uuid", "hash", "string", IndexOpts().PK())
+			.AddIndex("data", "data", "hash", "int", IndexOpts());
+	}
+
+	virtual Error Initialize();
+	virtual void RegisterAllCases();
+
+protected:
+	virtual Item MakeItem();
+
+private:
+	bool pkFilter_;
+};
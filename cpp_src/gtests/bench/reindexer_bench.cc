@@ -5,6 +5,7 @@
 #include "api_tv_composite.h"
 #include "api_tv_simple.h"
 #include "join_items.h"
+#include "pk_filter_items.h"
 
 #include "tools/fsops.h"
 
@@ -36,6 +37,8 @@ int main(int argc, char** argv) {
 	JoinItems joinItems(DB.get(), 500);
 	ApiTvSimple apiTvSimple(DB.get(), "ApiTvSimple", kItemsInBenchDataset);
 	ApiTvComposite apiTvComposite(DB.get(), "ApiTvComposite", kItemsInBenchDataset);
+	PKFilterItems pkItems(DB.get(), "PKItems", kItemsInBenchDataset, false);
+	PKFilterItems pkFilterItems(DB.get(), "PKFilterItems", kItemsInBenchDataset, true);
 
 	auto err = apiTvSimple.Initialize();
 	if (!err.ok()) return err.code();
@@ -46,12 +49,20 @@ int main(int argc, char** argv) {
 	err = apiTvComposite.Initialize();
 	if (!err.ok()) return err.code();
 
+	err = pkItems.Initialize();
+	if (!err.ok()) return err.code();
+
+	err = pkFilterItems.Initialize();
+	if (!err.ok()) return err.code();
+
 	::benchmark::Initialize(&argc, argv);
 	if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
 
 	joinItems.RegisterAllCases();
 	apiTvSimple.RegisterAllCases();
 	apiTvComposite.RegisterAllCases();
+	pkItems.RegisterAllCases();
+	pkFilterItems.RegisterAllCases();
 
 	::benchmark::RunSpecifiedBenchmarks();
 }
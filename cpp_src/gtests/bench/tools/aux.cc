@@ -1,7 +1,16 @@
 #include "aux.h"
 
+#include <stdlib.h>
+#include <atomic>
 #include <cmath>
 
+unsigned randomSeed() {
+	static const char* seedEnv = getenv("REINDEXER_BENCH_SEED");
+	static std::atomic<unsigned> threadsCount{0};
+	if (!seedEnv || !*seedEnv) return std::random_device{}();
+	return unsigned(strtoul(seedEnv, nullptr, 10)) + threadsCount++;
+}
+
 string HumanReadableNumber(size_t number, bool si, const string& unitLabel) {
 	const string siPrefix = "kMGTPE";
 	const string prefix = "KMGTPE";
@@ -44,9 +44,13 @@ KeyRefs toArray(const vector<T>& vec) {
 	return internal::to_array_helper<T>::to_array(vec);
 }
 
+// Seed for random generator of new thread. If REINDEXER_BENCH_SEED environment variable is set,
+// seeds are derived from it, so datasets and queries are reproducible between runs
+unsigned randomSeed();
+
 template <typename T = int>
 T random(T from, T to) {
-	thread_local static std::mt19937 gen(std::random_device{}());
+	thread_local static std::mt19937 gen(randomSeed());
 
 	using dist_type =
 		typename std::conditional<std::is_integral<T>::value, std::uniform_int_distribution<T>, std::uniform_real_distribution<T> >::type;
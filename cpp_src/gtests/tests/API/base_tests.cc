@@ -381,8 +381,7 @@ TEST_F(ReindexerApi, SortByUnorderedIndexWithJoins) {
 
 	for (size_t i = 0; i < queryResult.size(); ++i) {
 		const reindexer::ItemRef& itemRef = queryResult[i];
-		auto itFind(queryResult.joined_->find(itemRef.id));
-		EXPECT_TRUE(itFind != queryResult.joined_->end());
+		EXPECT_TRUE(queryResult.joined_->Has(itemRef.id));
 	}
 }
 
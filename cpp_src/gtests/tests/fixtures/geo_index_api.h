@@ -0,0 +1,42 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "core/geopoint.h"
+#include "reindexer_api.h"
+
+using reindexer::GeoPoint;
+
+class GeoIndexApi : public ReindexerApi {
+protected:
+	void SetUp() override {
+		CreateNamespace(default_namespace);
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{kFieldId, "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{kFieldLocation, "grid", "point", IndexOpts()}});
+		char buf[256];
+		for (int id = 0; id < kItemsCount; ++id) {
+			// Integer coordinates are stored in JSON without loss of precision
+			GeoPoint p{double(rand() % 101 - 50), double(rand() % 101 - 50)};
+			points_.push_back(p);
+			snprintf(buf, sizeof(buf), R"({"%s":%d,"%s":[%d,%d]})", kFieldId, id, kFieldLocation, int(p.x), int(p.y));
+			Item item = NewItem(default_namespace);
+			auto err = item.FromJSON(buf);
+			ASSERT_TRUE(err.ok()) << err.what();
+			Upsert(default_namespace, item);
+		}
+		Commit(default_namespace);
+	}
+
+	// Get sorted ids of items from query results
+	vector<int> ResultIds(QueryResults &qr) {
+		vector<int> ids;
+		for (size_t i = 0; i < qr.size(); ++i) ids.push_back(qr.GetItem(static_cast<int>(i))[kFieldId].Get<int>());
+		std::sort(ids.begin(), ids.end());
+		return ids;
+	}
+
+	const char *kFieldId = "id";
+	const char *kFieldLocation = "location";
+	const int kItemsCount = 2000;
+	vector<GeoPoint> points_;
+};
@@ -116,15 +116,8 @@ protected:
 			FillQueryResultFromItem(item, resultRow);
 
 			const reindexer::ItemRef& rowid = reindexerRes[i];
-			auto it = reindexerRes.joined_->find(rowid.id);
-			if (it == reindexerRes.joined_->end()) {
-				continue;
-			}
-
-			reindexer::QRVector& joinQueryRes(it->second);
-			const QueryResults& joinResult(joinQueryRes[0]);
-			for (size_t i = 0; i < joinResult.size(); ++i) {
-				Item joinItem(joinResult.GetItem(i));
+			for (auto& joinItemRef : reindexerRes.joined_->Get(rowid.id, 0)) {
+				Item joinItem(reindexerRes.GetItem(joinItemRef));
 				FillQueryResultFromItem(joinItem, resultRow);
 			}
 		}
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <limits>
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include "reindexer_api.h"
@@ -744,6 +745,306 @@ protected:
 
 		EXPECT_TRUE(AreDoublesEqual(testQr.aggregationResults[1], yearSum)) << "Aggregation Sum result is incorrect!";
 		EXPECT_TRUE(AreDoublesEqual(testQr.aggregationResults[0], yearSum / checkQr.size())) << "Aggregation Sum result is incorrect!";
+
+		Query funcsQuery = Query(default_namespace)
+							   .Where(kFieldNameGenre, CondEq, 10)
+							   .Limit(limit)
+							   .Aggregate(kFieldNameYear, AggMin)
+							   .Aggregate(kFieldNameYear, AggMax)
+							   .Aggregate(kFieldNamePackages, AggCount)
+							   .Aggregate(kFieldNameName, AggCountDistinct)
+							   .Aggregate(kFieldNameName, AggCountDistinctApprox)
+							   .Aggregate(kFieldNameYear, AggFacet);
+		reindexer::QueryResults funcsQr;
+		err = reindexer->Select(funcsQuery, funcsQr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(funcsQr.aggregationResults.size(), 6);
+		ASSERT_EQ(funcsQr.aggregationFacets.size(), 6);
+
+		int yearMin = INT_MAX, yearMax = INT_MIN;
+		size_t packagesCount = 0;
+		std::set<string> names;
+		std::map<string, int> yearFacets;
+		for (size_t i = 0; i < checkQr.size(); ++i) {
+			Item item(checkQr.GetItem(static_cast<int>(i)));
+			int year = item[kFieldNameYear].Get<int>();
+			yearMin = std::min(yearMin, year);
+			yearMax = std::max(yearMax, year);
+			packagesCount += static_cast<KeyRefs>(item[kFieldNamePackages]).size();
+			names.insert(item[kFieldNameName].As<string>());
+			yearFacets[std::to_string(year)]++;
+		}
+
+		if (checkQr.size()) {
+			EXPECT_EQ(funcsQr.aggregationResults[0], yearMin) << "Aggregation Min result is incorrect!";
+			EXPECT_EQ(funcsQr.aggregationResults[1], yearMax) << "Aggregation Max result is incorrect!";
+		}
+		EXPECT_EQ(funcsQr.aggregationResults[2], packagesCount) << "Aggregation Count result is incorrect!";
+		EXPECT_EQ(funcsQr.aggregationResults[3], names.size()) << "Aggregation Count Distinct result is incorrect!";
+		EXPECT_NEAR(funcsQr.aggregationResults[4], names.size(), names.size() * 0.05 + 1) << "Approximate Count Distinct is incorrect!";
+		EXPECT_EQ(funcsQr.aggregationResults[5], yearFacets.size()) << "Aggregation Facet result is incorrect!";
+
+		auto &facets = funcsQr.aggregationFacets[5];
+		ASSERT_EQ(facets.size(), yearFacets.size());
+		for (size_t i = 0; i < facets.size(); ++i) {
+			EXPECT_EQ(facets[i].count, yearFacets[facets[i].value]) << "Facet of value " << facets[i].value << " is incorrect!";
+			if (i) {
+				EXPECT_GE(facets[i - 1].count, facets[i].count) << "Facets are not ordered by count!";
+			}
+		}
+	}
+
+	void CheckAggregationPrecision() {
+		// Values of '-' indexes are aggregated from columns of indexes by batches
+		const string ns = "aggregation_precision_namespace";
+		CreateNamespace(ns);
+		DefineNamespaceDataset(ns, {IndexDeclaration{kFieldNameId, "hash", "int", IndexOpts().PK()},
+									IndexDeclaration{kFieldNameColumnInt64, "-", "int64", IndexOpts()},
+									IndexDeclaration{kFieldNameColumnDouble, "-", "double", IndexOpts()}});
+
+		// Small values are lost by naive summation of doubles after big one
+		const int itemsCount = 3000;
+		const int64_t base = 1000000000000000LL;
+		int64_t int64Sum = 0;
+		for (int i = 0; i < itemsCount; ++i) {
+			Item item(reindexer->NewItem(ns));
+			item[kFieldNameId] = i;
+			item[kFieldNameColumnInt64] = base + i;
+			item[kFieldNameColumnDouble] = (i == 0) ? 1e16 : (i == itemsCount - 1) ? -1e16 : 1.0;
+			Upsert(ns, item);
+			int64Sum += base + i;
+		}
+		Commit(ns);
+
+		reindexer::QueryResults qr;
+		Error err = reindexer->Select(Query(ns)
+										  .Aggregate(kFieldNameColumnDouble, AggSum)
+										  .Aggregate(kFieldNameColumnDouble, AggAvg)
+										  .Aggregate(kFieldNameColumnInt64, AggSum)
+										  .Aggregate(kFieldNameColumnInt64, AggMin)
+										  .Aggregate(kFieldNameColumnInt64, AggMax),
+									  qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(qr.aggregationResults.size(), 5);
+		EXPECT_EQ(qr.aggregationResults[0], itemsCount - 2) << "Sum of doubles is not compensated!";
+		EXPECT_EQ(qr.aggregationResults[1], double(itemsCount - 2) / itemsCount) << "Avg of doubles is not compensated!";
+		EXPECT_EQ(qr.aggregationResults[2], double(int64Sum)) << "Sum of int64 is not exact!";
+		EXPECT_EQ(qr.aggregationResults[3], double(base));
+		EXPECT_EQ(qr.aggregationResults[4], double(base + itemsCount - 1));
+	}
+
+	void CheckApproxQueries() {
+		const string ns = "approx_namespace";
+		CreateNamespace(ns);
+		DefineNamespaceDataset(ns, {IndexDeclaration{kFieldNameId, "hash", "int", IndexOpts().PK()},
+									IndexDeclaration{kFieldNameYear, "tree", "int", IndexOpts()},
+									IndexDeclaration{kFieldNameAge, "hash", "int", IndexOpts()},
+									IndexDeclaration{kFieldNameRate, "-", "double", IndexOpts()}});
+		for (int i = 0; i < 20000; ++i) {
+			Item item(reindexer->NewItem(ns));
+			item[kFieldNameId] = i;
+			item[kFieldNameYear] = rand() % 100;
+			item[kFieldNameAge] = rand() % 2;
+			item[kFieldNameRate] = static_cast<double>(rand() % 1000) / 10;
+			Upsert(ns, item);
+		}
+		Commit(ns);
+
+		// Total is extrapolated, when matches are not exhausted by sample
+		Query totalQuery = Query(ns).Where(kFieldNameYear, CondLt, 50).Where(kFieldNameAge, CondEq, 1).Limit(10);
+		reindexer::QueryResults exactQr, approxQr;
+		Error err = reindexer->Select(Query(totalQuery).ReqTotal(), exactQr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		err = reindexer->Select(Query(totalQuery).ApproxTotal(), approxQr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		EXPECT_EQ(approxQr.size(), exactQr.size());
+		EXPECT_NEAR(approxQr.totalCount, exactQr.totalCount, exactQr.totalCount * 0.1) << "Approximate total is incorrect!";
+
+		Query sqlQuery("");
+		sqlQuery.Parse("SELECT *, APPROX_COUNT(*) FROM " + ns + " WHERE year < 50");
+		EXPECT_EQ(sqlQuery.calcTotal, ModeApproxTotal);
+		EXPECT_NE(sqlQuery.Dump().find("APPROX_COUNT(*)"), string::npos);
+
+		// SUM and COUNT are extrapolated from sample, AVG is mean of sample
+		const double maxError = 0.02;
+		Query aggQuery = Query(ns)
+							 .Where(kFieldNameAge, CondEq, 1)
+							 .Aggregate(kFieldNameRate, AggSum)
+							 .Aggregate(kFieldNameRate, AggAvg)
+							 .Aggregate(kFieldNameRate, AggCount)
+							 .Aggregate(kFieldNameYear, AggMax);
+		reindexer::QueryResults exactAggQr, approxAggQr;
+		err = reindexer->Select(aggQuery, exactAggQr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		err = reindexer->Select(Query(aggQuery).ApproxAggregations(maxError), approxAggQr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(approxAggQr.aggregationResults.size(), 4);
+		for (size_t i = 0; i < 3; ++i) {
+			double exact = exactAggQr.aggregationResults[i], approx = approxAggQr.aggregationResults[i];
+			EXPECT_NEAR(approx, exact, exact * maxError * 3) << "Approximate aggregation " << i << " is incorrect!";
+		}
+		// Not extrapolated aggregations are exact
+		EXPECT_EQ(approxAggQr.aggregationResults[3], exactAggQr.aggregationResults[3]);
+	}
+
+	void CheckGroupByQueries() {
+		// Groups of big results by one field are taken from idsets of index, others are grouped by hash of keys
+		const Query filters[] = {Query(default_namespace), Query(default_namespace).Where(kFieldNameYear, CondGt, 2010),
+								 Query(default_namespace).Where(kFieldNameGenre, CondEq, 5)};
+		const std::vector<std::vector<string>> groupings = {{kFieldNameGenre}, {kFieldNameGenre, kFieldNameYear}};
+		for (const Query &filter : filters) {
+			reindexer::QueryResults checkQr;
+			Error err = reindexer->Select(filter, checkQr);
+			ASSERT_TRUE(err.ok()) << err.what();
+
+			for (auto &fields : groupings) {
+				Query groupQuery(filter);
+				for (auto &f : fields) groupQuery.GroupBy(f);
+				groupQuery.Aggregate(kFieldNameYear, AggSum).Aggregate(kFieldNameYear, AggMin);
+				reindexer::QueryResults groupQr;
+				err = reindexer->Select(groupQuery, groupQr);
+				ASSERT_TRUE(err.ok()) << err.what();
+				EXPECT_EQ(groupQr.size(), 0) << "Grouped query must not return items";
+
+				struct Group {
+					int count = 0;
+					double sum = 0;
+					int min = INT_MAX;
+				};
+				std::map<string, Group> expected;
+				for (size_t i = 0; i < checkQr.size(); ++i) {
+					Item item(checkQr.GetItem(static_cast<int>(i)));
+					string key;
+					for (auto &f : fields) key += item[f].As<string>() + "#";
+					int year = item[kFieldNameYear].Get<int>();
+					auto &g = expected[key];
+					g.count++;
+					g.sum += year;
+					g.min = std::min(g.min, year);
+				}
+
+				auto &groups = groupQr.groupedResults;
+				ASSERT_EQ(groups.fields.size(), fields.size());
+				ASSERT_EQ(groups.values.size(), 2);
+				ASSERT_EQ(groups.counts.size(), expected.size()) << groupQuery.Dump();
+				for (size_t g = 0; g < groups.counts.size(); ++g) {
+					string key;
+					for (size_t f = 0; f < fields.size(); ++f) key += groups.keys[f][g].As<string>() + "#";
+					auto it = expected.find(key);
+					ASSERT_TRUE(it != expected.end()) << "Unexpected group " << key;
+					EXPECT_EQ(groups.counts[g], it->second.count) << "Count of group " << key << " is incorrect!";
+					EXPECT_TRUE(AreDoublesEqual(groups.values[0][g], it->second.sum)) << "Sum of group " << key << " is incorrect!";
+					EXPECT_EQ(groups.values[1][g], it->second.min) << "Min of group " << key << " is incorrect!";
+				}
+			}
+		}
+
+		// COUNT(*) of grouped SQL query is count of items in groups
+		Query sqlQuery;
+		sqlQuery.Parse("SELECT genre, SUM(year), COUNT(*) FROM test_namespace WHERE year > 2010 GROUP BY genre");
+		EXPECT_EQ(sqlQuery.count, UINT_MAX);
+		EXPECT_EQ(sqlQuery.calcTotal, ModeNoTotal);
+		ASSERT_EQ(sqlQuery.groupBy_.size(), 1);
+		EXPECT_EQ(sqlQuery.groupBy_[0], kFieldNameGenre);
+		reindexer::QueryResults sqlQr;
+		Error err = reindexer->Select(sqlQuery, sqlQr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		EXPECT_FALSE(sqlQr.groupedResults.counts.empty());
+	}
+
+	void CheckFacetQueries() {
+		// Facets of big results are counted by idsets of indexes, and of small ones - by payloads
+		const Query filters[] = {Query(default_namespace), Query(default_namespace).Where(kFieldNameYear, CondGt, 2010),
+								 Query(default_namespace).Where(kFieldNameGenre, CondEq, 5)};
+		const unsigned facetsLimit = 3;
+		for (const Query &filter : filters) {
+			Query facetQuery(filter);
+			facetQuery.Aggregate(kFieldNameGenre, AggFacet).Aggregate(kFieldNamePackages, AggFacet, facetsLimit);
+			reindexer::QueryResults facetQr;
+			Error err = reindexer->Select(facetQuery, facetQr);
+			ASSERT_TRUE(err.ok()) << err.what();
+			ASSERT_EQ(facetQr.aggregationFacets.size(), 2);
+
+			reindexer::QueryResults checkQr;
+			err = reindexer->Select(filter, checkQr);
+			ASSERT_TRUE(err.ok()) << err.what();
+			std::map<string, int> genres, packages;
+			for (size_t i = 0; i < checkQr.size(); ++i) {
+				Item item(checkQr.GetItem(static_cast<int>(i)));
+				genres[item[kFieldNameGenre].As<string>()]++;
+				std::set<string> itemPackages;
+				for (auto &kr : static_cast<KeyRefs>(item[kFieldNamePackages])) itemPackages.insert(kr.As<string>());
+				for (auto &p : itemPackages) packages[p]++;
+			}
+
+			auto &genreFacets = facetQr.aggregationFacets[0];
+			EXPECT_EQ(genreFacets.size(), genres.size()) << facetQuery.Dump();
+			for (auto &f : genreFacets) EXPECT_EQ(f.count, genres[f.value]) << "Facet of genre " << f.value << " is incorrect!";
+
+			auto &packageFacets = facetQr.aggregationFacets[1];
+			EXPECT_EQ(packageFacets.size(), std::min(size_t(facetsLimit), packages.size())) << facetQuery.Dump();
+			int maxCount = 0;
+			for (auto &p : packages) maxCount = std::max(maxCount, p.second);
+			if (!packageFacets.empty()) {
+				EXPECT_EQ(packageFacets[0].count, maxCount) << "Top facet is not returned!";
+			}
+			for (auto &f : packageFacets) EXPECT_EQ(f.count, packages[f.value]) << "Facet of package " << f.value << " is incorrect!";
+		}
+	}
+
+	void CheckFacetsAfterUpdates() {
+		// Idsets of keys, which are updated after commit, must be committed before facets are counted by them
+		const string ns = "facets_updates_namespace";
+		CreateNamespace(ns);
+		DefineNamespaceDataset(ns, {IndexDeclaration{kFieldNameId, "hash", "int", IndexOpts().PK()},
+									IndexDeclaration{kFieldNameGenre, "hash", "int", IndexOpts()}});
+		std::map<string, int> genres;
+		auto fill = [&](int from, int count) {
+			for (int i = from; i < from + count; ++i) {
+				Item item(reindexer->NewItem(ns));
+				item[kFieldNameId] = i;
+				item[kFieldNameGenre] = i % 2;
+				Upsert(ns, item);
+				genres[std::to_string(i % 2)]++;
+			}
+			Commit(ns);
+		};
+		auto check = [&]() {
+			reindexer::QueryResults qr;
+			Error err = reindexer->Select(Query(ns).Aggregate(kFieldNameGenre, AggFacet), qr);
+			ASSERT_TRUE(err.ok()) << err.what();
+			ASSERT_EQ(qr.aggregationFacets.size(), 1);
+			auto &facets = qr.aggregationFacets[0];
+			EXPECT_EQ(facets.size(), genres.size());
+			for (auto &f : facets) EXPECT_EQ(f.count, genres[f.value]) << "Facet of genre " << f.value << " is incorrect!";
+
+			// Cached groups are invalidated by updates of grouped field
+			for (int i = 0; i < 2; ++i) {
+				reindexer::QueryResults groupQr;
+				err = reindexer->Select(Query(ns).GroupBy(kFieldNameGenre).CacheResults(), groupQr);
+				ASSERT_TRUE(err.ok()) << err.what();
+				auto &groups = groupQr.groupedResults;
+				ASSERT_EQ(groups.counts.size(), genres.size());
+				for (size_t g = 0; g < groups.counts.size(); ++g) {
+					string genre = groups.keys[0][g].As<string>();
+					EXPECT_EQ(groups.counts[g], genres[genre]) << "Count of group " << genre << " is incorrect!";
+				}
+			}
+		};
+
+		fill(0, 10);
+		check();
+		fill(10, 300);
+		check();
+
+		Item item(reindexer->NewItem(ns));
+		item[kFieldNameId] = 0;
+		item[kFieldNameGenre] = 1;
+		Upsert(ns, item);
+		Commit(ns);
+		genres["0"]--;
+		genres["1"]++;
+		check();
 	}
 
 	void CheckSqlQueries() {
@@ -200,3 +200,157 @@ TEST_F(CompositeIndexesApi, CompositeIndexesSelectTest) {
 	err = reindexer->Select(Query(default_namespace), qr13);
 	EXPECT_TRUE(err.ok()) << err.what();
 }
+
+TEST_F(CompositeIndexesApi, CompositeIndexesWithArraysTest) {
+	const string ns = "composite_arrays";
+	const int kItemsCount = 300;
+	CreateNamespace(ns);
+	DefineNamespaceDataset(ns, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+								IndexDeclaration{"tags", "hash", "int", IndexOpts().Array()},
+								IndexDeclaration{"category", "tree", "int", IndexOpts()},
+								IndexDeclaration{"tags+category", "hash", "composite", IndexOpts()}});
+
+	auto upsertItem = [&](int id, int tag1, int tag2) {
+		Item item = NewItem(ns);
+		// Duplicated tags must not break index
+		auto err = item.FromJSON("{\"id\":" + to_string(id) + ",\"tags\":[" + to_string(tag1) + "," + to_string(tag2) + "," +
+								 to_string(tag2) + "],\"category\":" + to_string(id % 3) + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(ns, item);
+	};
+	for (int id = 0; id < kItemsCount; ++id) upsertItem(id, id % 5, id % 7 + 10);
+	// Update and delete some items
+	for (int id = 0; id < kItemsCount; id += 4) upsertItem(id, 100, 101);
+	for (int id = 1; id < kItemsCount; id += 4) {
+		Item item = NewItem(ns);
+		item["id"] = id;
+		auto err = reindexer->Delete(ns, item);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+	Commit(ns);
+
+	auto expectedCount = [&](int tag, int category) {
+		size_t count = 0;
+		for (int id = 0; id < kItemsCount; ++id) {
+			if (id % 4 == 1 || id % 3 != category) continue;
+			bool hasTag = (id % 4 == 0) ? (tag == 100 || tag == 101) : (tag == id % 5 || tag == id % 7 + 10);
+			if (hasTag) count++;
+		}
+		return count;
+	};
+
+	for (int tag : {2, 12, 100}) {
+		for (int category = 0; category < 3; ++category) {
+			// Conditions on subindexes are substituted with composite index
+			QueryResults qr;
+			auto err = reindexer->Select(Query(ns).Where("tags", CondEq, tag).Where("category", CondEq, category), qr);
+			ASSERT_TRUE(err.ok()) << err.what();
+			EXPECT_EQ(qr.size(), expectedCount(tag, category)) << "tag=" << tag << ", category=" << category;
+
+			QueryResults qrComposite;
+			err = reindexer->Select(Query(ns).WhereComposite("tags+category", CondEq, {{KeyValue(tag), KeyValue(category)}}), qrComposite);
+			ASSERT_TRUE(err.ok()) << err.what();
+			EXPECT_EQ(qrComposite.size(), expectedCount(tag, category)) << "tag=" << tag << ", category=" << category;
+		}
+	}
+
+	// Large set of keys is checked by comparator
+	vector<KeyValues> keys;
+	for (int tag = 0; tag < 400; ++tag) {
+		for (int category = 0; category < 3; ++category) keys.emplace_back(KeyValues{KeyValue(tag), KeyValue(category)});
+	}
+	QueryResults qr;
+	auto err = reindexer->Select(Query(ns).WhereComposite("tags+category", CondSet, keys), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.size(), size_t(kItemsCount - kItemsCount / 4));
+}
+
+TEST_F(CompositeIndexesApi, CompositeIndexesRangeByPrefixTest) {
+	const string ns = "composite_ranges";
+	const int kItemsCount = 500;
+	CreateNamespace(ns);
+	DefineNamespaceDataset(ns, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"a", "hash", "int", IndexOpts()},
+								IndexDeclaration{"b", "tree", "int64", IndexOpts()},
+								IndexDeclaration{"a+b", "tree", "composite", IndexOpts()}});
+	for (int id = 0; id < kItemsCount; ++id) {
+		Item item = NewItem(ns);
+		item["id"] = id;
+		item["a"] = id % 5;
+		item["b"] = int64_t((id * 7919) % 1000 - 500);
+		Upsert(ns, item);
+	}
+	Commit(ns);
+
+	auto check = [&](const Query& q, int a, int64_t lo, int64_t hi, bool desc) {
+		QueryResults qr;
+		auto err = reindexer->Select(q, qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		size_t expected = 0;
+		for (int id = 0; id < kItemsCount; ++id) {
+			int64_t b = (id * 7919) % 1000 - 500;
+			if (id % 5 == a && b >= lo && b <= hi) expected++;
+		}
+		ASSERT_EQ(qr.size(), expected);
+		for (size_t i = 0; i < qr.size(); ++i) {
+			Item item(qr.GetItem(i));
+			EXPECT_EQ(item["a"].Get<int>(), a);
+			int64_t b = item["b"].Get<int64_t>();
+			EXPECT_TRUE(b >= lo && b <= hi) << b;
+			if (i > 0) {
+				Item prev(qr.GetItem(i - 1));
+				int64_t prevB = prev["b"].Get<int64_t>();
+				EXPECT_TRUE(desc ? prevB >= b : prevB <= b) << prevB << " " << b;
+			}
+		}
+	};
+
+	const int64_t kMin = std::numeric_limits<int64_t>::lowest(), kMax = std::numeric_limits<int64_t>::max();
+	check(Query(ns).Where("a", CondEq, 1).Where("b", CondGt, int64_t(10)).Sort("b", false), 1, 11, kMax, false);
+	check(Query(ns).Where("a", CondEq, 2).Where("b", CondLe, int64_t(-100)).Sort("b", true), 2, kMin, -100, true);
+	check(Query(ns).Where("a", CondEq, 3).Where("b", CondRange, {int64_t(-200), int64_t(200)}).Sort("b", false), 3, -200, 200, false);
+	check(Query(ns).Where("a", CondEq, 4).Sort("b", false), 4, kMin, kMax, false);
+	// Bound on limit of type must not overflow
+	check(Query(ns).Where("a", CondEq, 0).Where("b", CondGt, kMax), 0, 1, 0, false);
+	// Values of other numeric types are converted to types of fields
+	check(Query(ns).Where("a", CondEq, int64_t(1)).Where("b", CondGe, 10).Sort("b", false), 1, 10, kMax, false);
+	check(Query(ns).Where("a", CondEq, 2.0).Where("b", CondRange, {-50.0, 50.0}).Sort("b", false), 2, -50, 50, false);
+	// Values, which are changed by conversion, are left to conditions on fields
+	QueryResults qr;
+	auto err = reindexer->Select(Query(ns).Where("a", CondEq, 1.5).Where("b", CondGe, int64_t(0)), qr);
+	EXPECT_TRUE(err.ok()) << err.what();
+}
+
+TEST_F(CompositeIndexesApi, CompositeIndexesRangeByDoubleTest) {
+	const string ns = "composite_double_ranges";
+	const double kInf = std::numeric_limits<double>::infinity();
+	CreateNamespace(ns);
+	DefineNamespaceDataset(ns, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"a", "hash", "int", IndexOpts()},
+								IndexDeclaration{"b", "tree", "double", IndexOpts()},
+								IndexDeclaration{"a+b", "tree", "composite", IndexOpts()}});
+	const double values[] = {-kInf, -1.5, 0.0, 2.5, kInf};
+	int id = 0;
+	for (int a = 0; a < 2; ++a) {
+		for (double b : values) {
+			Item item = NewItem(ns);
+			item["id"] = id++;
+			item["a"] = a;
+			item["b"] = b;
+			Upsert(ns, item);
+		}
+	}
+	Commit(ns);
+
+	auto count = [&](const Query& q) -> size_t {
+		QueryResults qr;
+		auto err = reindexer->Select(q, qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		return qr.size();
+	};
+	// Items with infinite values of the last field are in the open ranges
+	EXPECT_EQ(count(Query(ns).Where("a", CondEq, 1).Sort("b", false)), 5u);
+	EXPECT_EQ(count(Query(ns).Where("a", CondEq, 1).Where("b", CondGe, 0.0)), 3u);
+	EXPECT_EQ(count(Query(ns).Where("a", CondEq, 1).Where("b", CondLt, 0.0)), 2u);
+	// There are no values beyond infinities
+	EXPECT_EQ(count(Query(ns).Where("a", CondEq, 1).Where("b", CondGt, kInf)), 0u);
+	EXPECT_EQ(count(Query(ns).Where("a", CondEq, 1).Where("b", CondLt, -kInf)), 0u);
+}
@@ -0,0 +1,68 @@
+#include "geo_index_api.h"
+
+TEST_F(GeoIndexApi, DWithin) {
+	const GeoPoint center{1.5, -2.5};
+	const double distance = 15.5;
+
+	QueryResults qr;
+	auto err = reindexer->Select(Query(default_namespace).DWithin(kFieldLocation, center.x, center.y, distance), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	vector<int> expected;
+	for (int id = 0; id < kItemsCount; ++id) {
+		if (reindexer::GeoDistance(points_[id], center) <= distance) expected.push_back(id);
+	}
+	ASSERT_FALSE(expected.empty());
+	EXPECT_EQ(ResultIds(qr), expected);
+}
+
+TEST_F(GeoIndexApi, Box) {
+	QueryResults qr;
+	auto err = reindexer->Select("SELECT * FROM " + default_namespace + " WHERE " + kFieldLocation + " BOX (42.25, -35, -10, 20)", qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	vector<int> expected;
+	for (int id = 0; id < kItemsCount; ++id) {
+		const GeoPoint &p = points_[id];
+		if (p.x >= -10 && p.x <= 42.25 && p.y >= -35 && p.y <= 20) expected.push_back(id);
+	}
+	ASSERT_FALSE(expected.empty());
+	EXPECT_EQ(ResultIds(qr), expected);
+}
+
+TEST_F(GeoIndexApi, NotDWithinSortedByDistance) {
+	const GeoPoint center{-40, 40};
+	const double distance = 50;
+	const unsigned limit = 20;
+
+	QueryResults qr;
+	Query q(default_namespace);
+	q.Not().DWithin(kFieldLocation, center.x, center.y, distance).SortByDistance(kFieldLocation, center.x, center.y).Limit(limit);
+	auto err = reindexer->Select(q, qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.size(), limit);
+
+	double prevDistance = distance;
+	for (size_t i = 0; i < qr.size(); ++i) {
+		int id = qr.GetItem(static_cast<int>(i))[kFieldId].Get<int>();
+		double itemDistance = reindexer::GeoDistance(points_[id], center);
+		EXPECT_GT(itemDistance, distance);
+		EXPECT_GE(itemDistance, prevDistance);
+		prevDistance = itemDistance;
+	}
+}
+
+TEST_F(GeoIndexApi, ReconfigureCellSize) {
+	auto err = reindexer->ConfigureIndex(default_namespace, kFieldLocation, R"({"cell_size":5})");
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	QueryResults qr;
+	err = reindexer->Select(Query(default_namespace).DWithin(kFieldLocation, 0, 0, 17.5), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	vector<int> expected;
+	for (int id = 0; id < kItemsCount; ++id) {
+		if (reindexer::GeoDistance(points_[id], GeoPoint{0, 0}) <= 17.5) expected.push_back(id);
+	}
+	EXPECT_EQ(ResultIds(qr), expected);
+}
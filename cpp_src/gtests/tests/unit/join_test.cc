@@ -48,6 +48,67 @@ TEST_F(JoinSelectsApi, InnerJoinTest) {
 	}
 }
 
+TEST_F(JoinSelectsApi, InnerJoinByHashTableTest) {
+	// Count of main namespace items is much greater, than count of authors, so join is switched to hash table
+	Query queryAuthors = Query(authors_namespace).Where(age, CondGe, 50);
+	Query queryBooks = Query(books_namespace).Where(price, CondGe, 100);
+	Query joinQuery = Query(queryBooks).InnerJoin(authorid_fk, authorid, CondEq, queryAuthors);
+
+	reindexer::QueryResults joinQueryRes;
+	Error err = reindexer->Select(joinQuery, joinQueryRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	reindexer::QueryResults pureSelectRes;
+	err = reindexer->Select(queryBooks, pureSelectRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	QueryResultRows pureSelectRows;
+	for (size_t i = 0; i < pureSelectRes.size(); ++i) {
+		Item booksItem(pureSelectRes.GetItem(i));
+		KeyRef authorIdKeyRef = booksItem[authorid_fk];
+
+		reindexer::QueryResults authorsSelectRes;
+		err = reindexer->Select(Query(queryAuthors).Where(authorid, CondEq, authorIdKeyRef), authorsSelectRes);
+		ASSERT_TRUE(err.ok()) << err.what();
+		if (authorsSelectRes.size() == 0) continue;
+
+		QueryResultRow& pureSelectRow = pureSelectRows[booksItem[bookid].Get<int>()];
+		FillQueryResultFromItem(booksItem, pureSelectRow);
+		for (size_t j = 0; j < authorsSelectRes.size(); ++j) {
+			Item authorsItem(authorsSelectRes.GetItem(j));
+			FillQueryResultFromItem(authorsItem, pureSelectRow);
+		}
+	}
+
+	QueryResultRows joinSelectRows;
+	FillQueryResultRows(joinQueryRes, joinSelectRows);
+	EXPECT_EQ(CompareQueriesResults(pureSelectRows, joinSelectRows), true);
+}
+
+TEST_F(JoinSelectsApi, JoinedItemsAreSharedByEqualKeys) {
+	Query queryAuthors(authors_namespace);
+	Query joinQuery = Query(books_namespace).InnerJoin(authorid_fk, authorid, CondEq, queryAuthors);
+
+	reindexer::QueryResults joinQueryRes;
+	Error err = reindexer->Select(joinQuery, joinQueryRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_GT(joinQueryRes.size(), authorsIds.size());
+
+	// Each author is stored once, and books of the same author refer to the same joined items
+	EXPECT_LE(joinQueryRes.joined_->Items().size(), authorsIds.size());
+	std::unordered_map<int, const reindexer::ItemRef*> authorsItems;
+	for (size_t i = 0; i < joinQueryRes.size(); ++i) {
+		Item booksItem(joinQueryRes.GetItem(i));
+		auto joinedItems = joinQueryRes.joined_->Get(joinQueryRes[i].id, 0);
+		ASSERT_EQ(joinedItems.size(), 1u);
+
+		Item authorsItem(joinQueryRes.GetItem(joinedItems[0]));
+		EXPECT_EQ(authorsItem[authorid].Get<int>(), booksItem[authorid_fk].Get<int>());
+		auto it = authorsItems.emplace(booksItem[authorid_fk].Get<int>(), joinedItems.begin()).first;
+		EXPECT_EQ(it->second, joinedItems.begin());
+	}
+}
+
 TEST_F(JoinSelectsApi, LeftJoinTest) {
 	Query booksQuery = Query(books_namespace).Where(price, CondGe, 500);
 	Query joinQuery = Query(authors_namespace).LeftJoin(authorid, authorid_fk, CondEq, booksQuery);
@@ -81,25 +142,23 @@ TEST_F(JoinSelectsApi, LeftJoinTest) {
 			Item item(joinQueryRes.GetItem(i));
 			KeyRef authorIdKeyRef1 = item[authorid];
 			const reindexer::ItemRef& rowid = joinQueryRes[i];
-			auto it = joinQueryRes.joined_->find(rowid.id);
-			if (it != joinQueryRes.joined_->end()) {
-				reindexer::QRVector& queryResults = it->second;
-				for (const QueryResults& queryRes : queryResults) {
-					Item item2(queryRes.GetItem(0));
-					KeyRef authorIdKeyRef2 = item2[authorid_fk];
-					EXPECT_TRUE(authorIdKeyRef1 == authorIdKeyRef2);
-				}
+			for (int j = 0; j < joinQueryRes.joined_->JoinedQueries(); ++j) {
+				auto joinedItems = joinQueryRes.joined_->Get(rowid.id, j);
+				if (joinedItems.empty()) continue;
+				Item item2(joinQueryRes.GetItem(joinedItems[0]));
+				KeyRef authorIdKeyRef2 = item2[authorid_fk];
+				EXPECT_TRUE(authorIdKeyRef1 == authorIdKeyRef2);
 			}
 
 			presentedAuthorIds.insert(static_cast<int>(authorIdKeyRef1));
 			rowidsIndexes.insert({rowid.id, i});
 		}
 
-		for (const std::pair<const IdType, reindexer::QRVector>& itempair : *joinQueryRes.joined_) {
-			if (itempair.second.empty()) continue;
-			const QueryResults& joinedQueryRes(itempair.second[0]);
+		for (size_t k = 0; k < joinQueryRes.size(); ++k) {
+			const IdType id = joinQueryRes[k].id;
+			auto joinedQueryRes = joinQueryRes.joined_->Get(id, 0);
 			for (size_t i = 0; i < joinedQueryRes.size(); ++i) {
-				Item item(joinedQueryRes.GetItem(i));
+				Item item(joinQueryRes.GetItem(joinedQueryRes[i]));
 
 				KeyRef authorIdKeyRef1 = item[authorid_fk];
 				int authorId = static_cast<int>(authorIdKeyRef1);
@@ -107,7 +166,7 @@ TEST_F(JoinSelectsApi, LeftJoinTest) {
 				auto itAutorid(presentedAuthorIds.find(authorId));
 				EXPECT_TRUE(itAutorid != presentedAuthorIds.end());
 
-				int rowid(itempair.first);
+				int rowid(id);
 				auto itRowidIndex(rowidsIndexes.find(rowid));
 				EXPECT_TRUE(itRowidIndex != rowidsIndexes.end());
 
@@ -121,6 +180,32 @@ TEST_F(JoinSelectsApi, LeftJoinTest) {
 	}
 }
 
+TEST_F(JoinSelectsApi, LeftJoinBatchedTest) {
+	// Few items of main namespace and many items of joined namespace, so left join is done by batched selects
+	Query booksQuery(books_namespace);
+	Query joinQuery = Query(authors_namespace, 0, 100).LeftJoin(authorid, authorid_fk, CondEq, booksQuery);
+
+	reindexer::QueryResults joinQueryRes;
+	Error err = reindexer->Select(joinQuery, joinQueryRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(joinQueryRes.size(), 100u);
+
+	for (size_t i = 0; i < joinQueryRes.size(); ++i) {
+		Item authorsItem(joinQueryRes.GetItem(i));
+		KeyRef authorIdKeyRef = authorsItem[authorid];
+		reindexer::QueryResults booksSelectRes;
+		err = reindexer->Select(Query(books_namespace).Where(authorid_fk, CondEq, authorIdKeyRef), booksSelectRes);
+		ASSERT_TRUE(err.ok()) << err.what();
+
+		auto joinedBooks = joinQueryRes.joined_->Get(joinQueryRes[i].id, 0);
+		ASSERT_EQ(joinedBooks.size(), booksSelectRes.size());
+		for (size_t j = 0; j < joinedBooks.size(); ++j) {
+			Item joinedItem(joinQueryRes.GetItem(joinedBooks[j])), bookItem(booksSelectRes.GetItem(j));
+			EXPECT_EQ(joinedItem[bookid].Get<int>(), bookItem[bookid].Get<int>());
+		}
+	}
+}
+
 TEST_F(JoinSelectsApi, OrInnerJoinTest) {
 	Query queryGenres(genres_namespace);
 	Query queryAuthors(authors_namespace);
@@ -143,15 +228,13 @@ TEST_F(JoinSelectsApi, OrInnerJoinTest) {
 			Item item(queryRes.GetItem(i));
 			reindexer::ItemRef& itemRef(queryRes[i]);
 
-			auto it = queryRes.joined_->find(itemRef.id);
-			if (it != queryRes.joined_->end()) {
-				reindexer::QRVector& joinedResult = queryRes.joined_->at(itemRef.id);
-				QueryResults& authorNsJoinResults = joinedResult[authorsNsJoinIndex];
-				QueryResults& genresNsJoinResults = joinedResult[genresNsJoinIndex];
+			if (queryRes.joined_->Has(itemRef.id)) {
+				auto authorNsJoinResults = queryRes.joined_->Get(itemRef.id, authorsNsJoinIndex);
+				auto genresNsJoinResults = queryRes.joined_->Get(itemRef.id, genresNsJoinIndex);
 
 				KeyRef authorIdKeyRef1 = item[authorid_fk];
 				for (size_t j = 0; j < authorNsJoinResults.size(); ++j) {
-					Item authorsItem(authorNsJoinResults.GetItem(j));
+					Item authorsItem(queryRes.GetItem(authorNsJoinResults[j]));
 					KeyRef authorIdKeyRef2 = authorsItem[authorid];
 					EXPECT_TRUE(authorIdKeyRef1 == authorIdKeyRef2);
 				}
@@ -159,7 +242,7 @@ TEST_F(JoinSelectsApi, OrInnerJoinTest) {
 				KeyRef genresIdKeyRef1 = item[genreId_fk];
 				for (size_t k = 0; k < genresNsJoinResults.size(); ++k) {
 					KeyRefs genreIdKeyRef;
-					Item genresItem(genresNsJoinResults.GetItem(k));
+					Item genresItem(queryRes.GetItem(genresNsJoinResults[k]));
 					KeyRef genresIdKeyRef2 = genresItem[genreid];
 					EXPECT_TRUE(genresIdKeyRef1 == genresIdKeyRef2);
 				}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "estl/shared_mutex.h"
+
+using reindexer::profiled_shared_mutex;
+using reindexer::shared_lock;
+
+TEST(LockProfiling, StatsAreGroupedByName) {
+	const int kThreads = 4;
+	const int kIterations = 10000;
+	profiled_shared_mutex mtx1("test_lock"), mtx2("test_lock");
+
+	int counter = 0;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < kThreads; ++t) {
+		threads.emplace_back([&]() {
+			for (int i = 0; i < kIterations; ++i) {
+				{
+					std::lock_guard<profiled_shared_mutex> lck(mtx1);
+					counter++;
+				}
+				shared_lock<profiled_shared_mutex> lck(mtx2);
+			}
+		});
+	}
+	for (auto &th : threads) th.join();
+	EXPECT_EQ(counter, kThreads * kIterations);
+
+	auto stats = profiled_shared_mutex::get_stats();
+	auto it = std::find_if(stats.begin(), stats.end(), [](const reindexer::lock_stat &s) { return s.name == "test_lock"; });
+	ASSERT_TRUE(it != stats.end());
+	EXPECT_EQ(it->instances, 2u);
+	EXPECT_EQ(it->acquisitions, uint64_t(kThreads * kIterations));
+	EXPECT_EQ(it->shared_acquisitions, uint64_t(kThreads * kIterations));
+	EXPECT_LE(it->contended, it->acquisitions);
+	EXPECT_LE(it->max_wait_time, it->wait_time + it->shared_wait_time);
+	EXPECT_GT(it->hold_time, 0u);
+}
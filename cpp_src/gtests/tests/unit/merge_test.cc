@@ -0,0 +1,84 @@
+#include "join_selects_api.h"
+
+TEST_F(JoinSelectsApi, MergeQueriesTest) {
+	// Queries to different namespaces are selected in parallel
+	Query queryBooks = Query(books_namespace).Where(price, CondGe, 900);
+	Query queryAuthors = Query(authors_namespace).Where(age, CondLt, 30);
+	Query queryGenres(genres_namespace);
+
+	Query mergeQuery(queryBooks);
+	mergeQuery.mergeQueries_.push_back(queryAuthors);
+	mergeQuery.mergeQueries_.push_back(queryGenres);
+
+	reindexer::QueryResults mergeQueryRes;
+	reindexer->ResetStats();
+	Error err = reindexer->Select(mergeQuery, mergeQueryRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	// Selects of parts are accounted in stats of calling thread, in addition to the whole select
+	reindexer_stat stat;
+	err = reindexer->GetStats(stat);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_GE(stat.count_select, 2);
+
+	// Without ranks merged results are ordered by namespace, then by id
+	size_t pos = 0;
+	const Query* queries[] = {&queryBooks, &queryAuthors, &queryGenres};
+	for (size_t nsid = 0; nsid < 3; ++nsid) {
+		reindexer::QueryResults res;
+		err = reindexer->Select(*queries[nsid], res);
+		ASSERT_TRUE(err.ok()) << err.what();
+		std::vector<IdType> ids;
+		for (auto& itemRef : res) ids.push_back(itemRef.id);
+		std::sort(ids.begin(), ids.end());
+
+		for (size_t i = 0; i < ids.size(); ++i, ++pos) {
+			ASSERT_LT(pos, mergeQueryRes.size());
+			EXPECT_EQ(mergeQueryRes[pos].nsid, nsid);
+			EXPECT_EQ(mergeQueryRes[pos].id, ids[i]);
+
+			Item item(mergeQueryRes.GetItem(pos));
+			EXPECT_EQ(item.GetID(), ids[i]);
+		}
+	}
+	EXPECT_EQ(pos, mergeQueryRes.size());
+}
+
+TEST_F(JoinSelectsApi, MergeQueriesLimitOffsetTest) {
+	Query queryBooks = Query(books_namespace).Where(price, CondGe, 500);
+	Query queryAuthors(authors_namespace);
+
+	Query mergeQuery(queryBooks);
+	mergeQuery.mergeQueries_.push_back(queryAuthors);
+
+	reindexer::QueryResults allRes;
+	Error err = reindexer->Select(mergeQuery, allRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	const unsigned offset = 5, limit = 20;
+	mergeQuery.Offset(offset).Limit(limit);
+	mergeQuery.calcTotal = ModeAccurateTotal;
+	reindexer::QueryResults limitedRes;
+	err = reindexer->Select(mergeQuery, limitedRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	// Offset and limit are applied once, to merged results
+	EXPECT_EQ(limitedRes.totalCount, allRes.size());
+	size_t expected = allRes.size() > offset ? std::min(size_t(allRes.size() - offset), size_t(limit)) : 0;
+	ASSERT_EQ(limitedRes.size(), expected);
+	for (size_t i = 0; i < limitedRes.size(); ++i) {
+		EXPECT_EQ(limitedRes[i].nsid, allRes[i + offset].nsid);
+		EXPECT_EQ(limitedRes[i].id, allRes[i + offset].id);
+	}
+
+	// Limit is pushed down to merged queries, when total count is not requested
+	mergeQuery.calcTotal = ModeNoTotal;
+	reindexer::QueryResults pushedRes;
+	err = reindexer->Select(mergeQuery, pushedRes);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(pushedRes.size(), limitedRes.size());
+	for (size_t i = 0; i < pushedRes.size(); ++i) {
+		EXPECT_EQ(pushedRes[i].nsid, limitedRes[i].nsid);
+		EXPECT_EQ(pushedRes[i].id, limitedRes[i].id);
+	}
+}
@@ -55,3 +55,378 @@ TEST_F(NsApi, UpsertWithPrecepts) {
 		}
 	}
 }
+
+TEST_F(NsApi, PKFilter) {
+	const int kItemsCount = 3000;
+	CreateNamespace(default_namespace);
+	DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "tree", "int", IndexOpts().PK()},
+											   IndexDeclaration{"name", "hash", "string", IndexOpts().PK()}});
+
+	auto err = reindexer->ConfigureIndex(default_namespace, "id", R"({"pk_filter":true})");
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	auto makeItem = [&](int id) {
+		Item item = NewItem(default_namespace);
+		item["id"] = id;
+		item["name"] = "name" + to_string(id);
+		return item;
+	};
+
+	// Filter grows beyond initial capacity while inserting
+	for (int id = 0; id < kItemsCount; ++id) {
+		Item item = makeItem(id);
+		err = reindexer->Insert(default_namespace, item);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_NE(item.GetID(), -1) << "Item " << id << " was not inserted";
+	}
+
+	// Existing items must be found in spite of filter
+	for (int id = 0; id < kItemsCount; id += 7) {
+		Item item = makeItem(id);
+		err = reindexer->Insert(default_namespace, item);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(item.GetID(), -1) << "Duplicate of item " << id << " was inserted";
+	}
+
+	// Delete most of items to force filter rebuild, and insert them again
+	for (int id = 0; id < kItemsCount; ++id) {
+		if (id % 3 == 0) continue;
+		Item item = makeItem(id);
+		err = reindexer->Delete(default_namespace, item);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+	for (int id = 0; id < kItemsCount; ++id) {
+		Item item = makeItem(id);
+		err = reindexer->Insert(default_namespace, item);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(item.GetID() != -1, id % 3 != 0) << "Wrong insert result of item " << id;
+	}
+	Commit(default_namespace);
+
+	QueryResults qr;
+	err = reindexer->Select(Query(default_namespace), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.size(), size_t(kItemsCount));
+}
+
+TEST_F(NsApi, PKFilterWithCollate) {
+	CreateNamespace(default_namespace);
+	DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "string", IndexOpts().PK().SetCollateMode(CollateASCII)}});
+
+	// Equal keys in terms of collate mode have different hashes
+	auto err = reindexer->ConfigureIndex(default_namespace, "id", R"({"pk_filter":true})");
+	ASSERT_FALSE(err.ok());
+}
+
+TEST_F(NsApi, SparseIndex) {
+	const int kItemsCount = 1000;
+	CreateNamespace(default_namespace);
+	DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+											   IndexDeclaration{"tags", "hash", "int", IndexOpts().Array().Sparse()},
+											   IndexDeclaration{"rating", "-", "int", IndexOpts().Sparse()}});
+
+	// Absent scalar field is indexed as default value, so sparse tree and hash indexes must be arrays
+	auto err = reindexer->AddIndex(default_namespace, {"year", "year", "tree", "int", IndexOpts().Sparse()});
+	EXPECT_FALSE(err.ok());
+	err = reindexer->AddIndex(default_namespace, {"genre", "genre", "hash", "int", IndexOpts().Sparse()});
+	EXPECT_FALSE(err.ok());
+
+	// Only every 10th item has tags, and every 3rd item has no rating
+	for (int id = 0; id < kItemsCount; ++id) {
+		Item item = NewItem(default_namespace);
+		string json = "{\"id\":" + to_string(id);
+		if (id % 3) json += ",\"rating\":" + to_string(id % 100);
+		if (id % 10 == 0) json += ",\"tags\":[" + to_string(id % 3) + "," + to_string(id % 7 + 10) + "]";
+		json += "}";
+		auto err = item.FromJSON(json);
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(default_namespace, item);
+	}
+	// Remove tags from some items
+	for (int id = 0; id < kItemsCount; id += 50) {
+		Item item = NewItem(default_namespace);
+		auto err = item.FromJSON("{\"id\":" + to_string(id) + ",\"rating\":1}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(default_namespace, item);
+	}
+	Commit(default_namespace);
+
+	QueryResults qr;
+	err = reindexer->Select(Query(default_namespace).Where("tags", CondEmpty, 0), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.size(), size_t(kItemsCount - kItemsCount / 10 + kItemsCount / 50));
+
+	QueryResults qrAny;
+	err = reindexer->Select(Query(default_namespace).Where("tags", CondAny, 0), qrAny);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qrAny.size(), size_t(kItemsCount / 10 - kItemsCount / 50));
+
+	QueryResults qrEq;
+	err = reindexer->Select(Query(default_namespace).Where("tags", CondEq, 10).Where("rating", CondLt, 50), qrEq);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_GT(qrEq.size(), size_t(0));
+	for (size_t i = 0; i < qrEq.size(); ++i) {
+		int id = qrEq.GetItem(static_cast<int>(i))["id"].Get<int>();
+		EXPECT_TRUE(id % 10 == 0 && id % 50 != 0 && id % 7 == 0 && (id % 3 == 0 || id % 100 < 50)) << "Wrong item " << id;
+	}
+
+	// Items without rating are read as default value from payload
+	QueryResults qrRating;
+	err = reindexer->Select(Query(default_namespace).Where("rating", CondGe, 1), qrRating);
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (size_t i = 0; i < qrRating.size(); ++i) {
+		int id = qrRating.GetItem(static_cast<int>(i))["id"].Get<int>();
+		EXPECT_TRUE(id % 3 != 0 || id % 50 == 0) << "Item without rating " << id;
+	}
+}
+
+TEST_F(NsApi, QueryResultsCache) {
+	const int kItemsCount = 1000;
+	CreateNamespace(default_namespace);
+	DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+											   IndexDeclaration{"value", "tree", "int", IndexOpts()}});
+
+	auto upsertItem = [&](int id, int value) {
+		Item item = NewItem(default_namespace);
+		item["id"] = id;
+		item["value"] = value;
+		Upsert(default_namespace, item);
+	};
+	for (int id = 0; id < kItemsCount; ++id) upsertItem(id, id % 100);
+	Commit(default_namespace);
+
+	auto selectIds = [&](const Query& q, int& total) {
+		QueryResults qr;
+		auto err = reindexer->Select(q, qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		vector<int> ids;
+		for (size_t i = 0; i < qr.size(); ++i) {
+			Item item(qr.GetItem(i));
+			ids.push_back(item["id"].Get<int>());
+		}
+		total = qr.totalCount;
+		return ids;
+	};
+
+	Query qNoCache = Query(default_namespace).Where("value", CondLt, 10).Sort("value", true).Limit(20).Offset(5).ReqTotal();
+	Query q = Query(qNoCache).CacheResults();
+	int total = 0, expectedTotal = 0;
+	auto expected = selectIds(qNoCache, expectedTotal);
+	ASSERT_EQ(expectedTotal, 100);
+	// Query is cached after second request, and taken from cache on next ones
+	for (int i = 0; i < 5; ++i) {
+		EXPECT_EQ(selectIds(q, total), expected);
+		EXPECT_EQ(total, expectedTotal);
+	}
+
+	// Modification of namespace invalidates cached results
+	upsertItem(kItemsCount, 9);
+	upsertItem(5, 50);
+	Commit(default_namespace);
+	expected = selectIds(qNoCache, expectedTotal);
+	ASSERT_EQ(expectedTotal, 100);
+	for (int i = 0; i < 5; ++i) {
+		EXPECT_EQ(selectIds(q, total), expected);
+		EXPECT_EQ(total, expectedTotal);
+	}
+}
+
+TEST_F(NsApi, QueryCacheInvalidationByIndexes) {
+	const int kItemsCount = 500;
+	CreateNamespace(default_namespace);
+	DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+											   IndexDeclaration{"value", "tree", "int", IndexOpts()},
+											   IndexDeclaration{"name", "hash", "string", IndexOpts()}});
+
+	auto upsertItem = [&](int id, int value, const string& name, int extra) {
+		// 'extra' is not indexed field, it's stored only in tuple
+		Item item = NewItem(default_namespace);
+		auto err = item.FromJSON("{\"id\":" + std::to_string(id) + ",\"value\":" + std::to_string(value) + ",\"name\":\"" + name +
+								 "\",\"extra\":" + std::to_string(extra) + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(default_namespace, item);
+	};
+	for (int id = 0; id < kItemsCount; ++id) upsertItem(id, id % 50, "name" + std::to_string(id % 7), 0);
+	Commit(default_namespace);
+
+	auto selectItems = [&](const Query& q, int& total) {
+		QueryResults qr;
+		auto err = reindexer->Select(q, qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		vector<string> items;
+		for (size_t i = 0; i < qr.size(); ++i) {
+			Item item(qr.GetItem(i));
+			items.push_back(item.GetJSON().ToString());
+		}
+		total = qr.totalCount;
+		return items;
+	};
+	auto checkCached = [&](const Query& qNoCache) {
+		Query q = Query(qNoCache).CacheResults();
+		q.calcTotal = ModeCachedTotal;
+		int total = 0, expectedTotal = 0;
+		auto expected = selectItems(qNoCache, expectedTotal);
+		for (int i = 0; i < 3; ++i) {
+			EXPECT_EQ(selectItems(q, total), expected);
+			EXPECT_EQ(total, expectedTotal);
+		}
+	};
+
+	Query qNoCache = Query(default_namespace).Where("value", CondLt, 5).Sort("value", false).Limit(10).ReqTotal();
+	checkCached(qNoCache);
+
+	// Update of not queried index and of not indexed field must not break cached results
+	upsertItem(1, 1, "updated", 0);
+	upsertItem(2, 2, "name2", 42);
+	Commit(default_namespace);
+	checkCached(qNoCache);
+
+	// Update of queried index must change results
+	upsertItem(3, 40, "name3", 0);
+	upsertItem(kItemsCount + 1, 0, "new", 0);
+	Commit(default_namespace);
+	checkCached(qNoCache);
+
+	Query qByName = Query(default_namespace).Where("name", CondEq, "name3").Sort("id", false).ReqTotal();
+	checkCached(qByName);
+	upsertItem(10, 10, "name3", 0);
+	upsertItem(3, 3, "name0", 0);
+	Commit(default_namespace);
+	checkCached(qByName);
+}
+
+TEST_F(NsApi, MemStat) {
+	const int kItemsCount = 1000;
+	CreateNamespace(default_namespace);
+	DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+											   IndexDeclaration{"value", "tree", "int", IndexOpts()},
+											   IndexDeclaration{"name", "hash", "string", IndexOpts()}});
+
+	for (int id = 0; id < kItemsCount; ++id) {
+		Item item = NewItem(default_namespace);
+		item["id"] = id;
+		item["value"] = id % 10;
+		item["name"] = "long name of item, which does not fit into string object " + std::to_string(id % 100);
+		Upsert(default_namespace, item);
+	}
+	Commit(default_namespace);
+	// Sort orders are built by first query with sort
+	QueryResults sortQr;
+	auto err = reindexer->Select(Query(default_namespace).Sort("value", false).Limit(1), sortQr);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	reindexer::NamespaceMemStat stat;
+	err = reindexer->GetMemStat(default_namespace, stat);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(stat.name, default_namespace);
+	EXPECT_EQ(stat.itemsCount, size_t(kItemsCount));
+	EXPECT_EQ(stat.emptyItemsCount, 0u);
+	EXPECT_GE(stat.dataSize, size_t(kItemsCount) * sizeof(reindexer::PayloadValue));
+
+	auto findIndex = [&](const string& name) -> const reindexer::IndexMemStat* {
+		for (auto& idx : stat.indexes)
+			if (idx.name == name) return &idx;
+		return nullptr;
+	};
+	auto idStat = findIndex("id");
+	ASSERT_TRUE(idStat != nullptr);
+	EXPECT_EQ(idStat->uniqKeysCount, size_t(kItemsCount));
+	EXPECT_GT(idStat->dataSize, 0u);
+	auto valueStat = findIndex("value");
+	ASSERT_TRUE(valueStat != nullptr);
+	EXPECT_EQ(valueStat->uniqKeysCount, 10u);
+	EXPECT_GT(valueStat->idsetBTreeSize + valueStat->idsetPlainSize, 0u);
+	EXPECT_GE(valueStat->sortOrdersSize, size_t(kItemsCount) * sizeof(IdType));
+	auto nameStat = findIndex("name");
+	ASSERT_TRUE(nameStat != nullptr);
+	EXPECT_EQ(nameStat->uniqKeysCount, 100u);
+	// Strings of keys are allocated on heap
+	EXPECT_GT(nameStat->dataSize, 100u * 50);
+
+	size_t indexesTotal = 0;
+	for (auto& idx : stat.indexes) indexesTotal += idx.Total();
+	EXPECT_EQ(stat.Total(), stat.dataSize + stat.pkFilterSize + stat.queryCache.totalSize + stat.resultsCache.totalSize + indexesTotal);
+
+	QueryResults qr;
+	err = reindexer->Delete(Query(default_namespace).Where("value", CondEq, 5), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	Commit(default_namespace);
+	err = reindexer->GetMemStat(default_namespace, stat);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(stat.itemsCount, size_t(kItemsCount - kItemsCount / 10));
+	EXPECT_EQ(stat.emptyItemsCount, size_t(kItemsCount / 10));
+
+	err = reindexer->GetMemStat("not_existing_namespace", stat);
+	EXPECT_FALSE(err.ok());
+}
+
+TEST_F(NsApi, PerfStatAndSlowQueries) {
+	reindexer::LatencyHistogram hist;
+	for (uint64_t us = 1; us <= 1000; ++us) hist.Record(us);
+	auto lat = hist.GetStat();
+	EXPECT_EQ(lat.count, 1000u);
+	EXPECT_EQ(lat.maxTime, 1000u);
+	EXPECT_EQ(lat.totalTime, 500500u);
+	// Relative error of percentiles is limited by width of histogram buckets
+	EXPECT_NEAR(double(lat.p50), 500.0, 500.0 / 8);
+	EXPECT_NEAR(double(lat.p99), 990.0, 990.0 / 8);
+	EXPECT_LE(lat.p999, lat.maxTime);
+
+	CreateNamespace(default_namespace);
+	DefineNamespaceDataset(default_namespace,
+						   {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"value", "tree", "int", IndexOpts()}});
+	auto err = reindexer->ConfigureSlowQueryLog(1, 5);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	for (int id = 0; id < 100; ++id) {
+		Item item = NewItem(default_namespace);
+		item["id"] = id;
+		item["value"] = id % 10;
+		Upsert(default_namespace, item);
+	}
+	Commit(default_namespace);
+
+	const int kSelectsCount = 10;
+	for (int i = 0; i < kSelectsCount; ++i) {
+		QueryResults qr;
+		err = reindexer->Select(Query(default_namespace).Where("value", CondEq, i), qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	// Shape hash is the same for the same stripped dumps and differs for different ones
+	EXPECT_EQ(Query(default_namespace).Where("value", CondEq, 1).ShapeHash(),
+			  Query(default_namespace).Where("value", CondEq, 2).ShapeHash());
+	EXPECT_EQ(Query(default_namespace).Where("value", CondSet, {1, 2}).ShapeHash(),
+			  Query(default_namespace).Where("value", CondSet, {1, 2, 3}).ShapeHash());
+	EXPECT_NE(Query(default_namespace).Where("value", CondEq, 1).ShapeHash(),
+			  Query(default_namespace).Where("value", CondGt, 1).ShapeHash());
+	EXPECT_NE(Query(default_namespace).Where("value", CondEq, 1).ShapeHash(), Query(default_namespace).Where("id", CondEq, 1).ShapeHash());
+	EXPECT_NE(Query(default_namespace).Where("value", CondEq, 1).ShapeHash(),
+			  Query(default_namespace).Where("value", CondEq, 1).Limit(10).ShapeHash());
+
+	vector<reindexer::NamespacePerfStat> stats;
+	err = reindexer->GetPerfStats(stats);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(stats.size(), 1u);
+	auto& stat = stats[0];
+	EXPECT_EQ(stat.name, default_namespace);
+	EXPECT_EQ(stat.itemsCount, 100u);
+	EXPECT_EQ(stat.upserts.count, 100u);
+	EXPECT_EQ(stat.selects.count, uint64_t(kSelectsCount));
+	EXPECT_GE(stat.commits.count, 1u);
+	// Queries, which differ only by values, have the same shape
+	ASSERT_EQ(stat.queries.size(), 1u);
+	EXPECT_EQ(stat.queries[0].shape, "SELECT * FROM " + default_namespace + " WHERE value = ?");
+	EXPECT_EQ(stat.queries[0].latency.count, uint64_t(kSelectsCount));
+
+	vector<reindexer::SlowQueryEntry> slowQueries;
+	err = reindexer->GetSlowQueries(slowQueries);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(slowQueries.size(), 5u);
+	// Log keeps the last queries, the newest first
+	EXPECT_EQ(slowQueries[0].query, "SELECT * FROM " + default_namespace + " WHERE value = '" + to_string(kSelectsCount - 1) + "'");
+	EXPECT_EQ(slowQueries[0].shape, stat.queries[0].shape);
+	EXPECT_EQ(slowQueries[0].explain.ns, default_namespace);
+	EXPECT_EQ(slowQueries[0].itemsCount, 10u);
+	EXPECT_FALSE(slowQueries[0].explain.iterators.empty());
+}
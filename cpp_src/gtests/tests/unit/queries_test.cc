@@ -9,6 +9,11 @@ TEST_F(QueriesApi, QueriesStandardTestSet) {
 
 	CheckStandartQueries();
 	CheckAggregationQueries();
+	CheckAggregationPrecision();
+	CheckApproxQueries();
+	CheckFacetQueries();
+	CheckFacetsAfterUpdates();
+	CheckGroupByQueries();
 	CheckSqlQueries();
 	CheckCompositeIndexesQueries();
 	CheckComparatorsQueries();
@@ -67,6 +72,8 @@ TEST_F(QueriesApi, QueriesStandardTestSet) {
 
 	CheckStandartQueries();
 	CheckAggregationQueries();
+	CheckFacetQueries();
+	CheckGroupByQueries();
 	CheckSqlQueries();
 	CheckCompositeIndexesQueries();
 	CheckComparatorsQueries();
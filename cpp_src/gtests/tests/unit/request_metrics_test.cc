@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "net/metrics.h"
+#include "tools/serializer.h"
+
+using reindexer::net::RequestMetrics;
+using reindexer::WrSerializer;
+
+TEST(RequestMetrics, ThreadShardsAreSummed) {
+	const int kThreads = 4;
+	const int kRequests = 1000;
+	RequestMetrics metrics(2);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < kThreads; ++t) {
+		threads.emplace_back([&metrics]() {
+			for (int i = 0; i < kRequests; ++i) metrics.Record(i % 2, i, i % 10 == 0);
+		});
+	}
+	for (auto &th : threads) th.join();
+	// Out of range kinds are ignored
+	metrics.Record(2, 1, true);
+
+	auto counters = metrics.Get();
+	ASSERT_EQ(counters.size(), 2u);
+	uint64_t total = 0;
+	for (auto &c : counters) {
+		EXPECT_EQ(c.count, uint64_t(kThreads * kRequests / 2));
+		uint64_t inBuckets = 0;
+		for (auto b : c.buckets) inBuckets += b;
+		EXPECT_EQ(inBuckets, c.count);
+		total += c.totalTime;
+	}
+	EXPECT_EQ(counters[0].errors, uint64_t(kThreads * kRequests / 10));
+	EXPECT_EQ(counters[1].errors, 0u);
+	EXPECT_EQ(total, uint64_t(kThreads) * kRequests * (kRequests - 1) / 2);
+	// Requests shorter than 100us are in the first bucket, the rest are in the next ones
+	EXPECT_EQ(counters[0].buckets[0] + counters[1].buckets[0], uint64_t(kThreads * 101));
+
+	WrSerializer ser(true);
+	RequestMetrics::GetPrometheus(ser, "test_request", counters, {"cmd=\"even\"", "cmd=\"odd\""});
+	std::string out(reinterpret_cast<const char *>(ser.Buf()), ser.Len());
+	EXPECT_NE(out.find("test_request_duration_seconds_bucket{cmd=\"even\",le=\"+Inf\"} 2000\n"), std::string::npos) << out;
+	EXPECT_NE(out.find("test_request_errors_total{cmd=\"even\"} 400\n"), std::string::npos) << out;
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
 #include <vector>
 
 #include "core/query/query.h"
@@ -50,3 +52,87 @@ TEST(LruCache, SimpleTest) {
 		}
 	}
 }
+
+TEST(LruCache, ConcurrentTest) {
+	const int threadsCount = 8;
+	const int iterCount = 20000;
+	const int keysCount = 1000;
+	typedef reindexer::LRUCache<QueryCacheKey, QueryCacheVal, reindexer::HashQueryCacheKey, EqQueryCacheKey> Cache;
+
+	vector<QueryCacheKey> keys;
+	for (int i = 0; i < keysCount; i++) keys.emplace_back(Query("namespace" + std::to_string(i)));
+
+	// Cache can hold only part of keys, so some of them will be evicted
+	Cache cache(keysCount * 256 / 4, 1);
+	std::atomic<int> wrongValues(0);
+	vector<std::thread> threads;
+	for (int t = 0; t < threadsCount; t++) {
+		threads.emplace_back([&, t]() {
+			for (int i = 0; i < iterCount; i++) {
+				// Half of requests are for small set of hot keys
+				int idx = (i % 2) ? (i % 50) : (i * 7 + t * 13) % keysCount;
+				auto cached = cache.Get(keys[idx]);
+				if (!cached.key) continue;
+				if (cached.val.total_count < 0) {
+					cache.Put(keys[idx], QueryCacheVal{static_cast<size_t>(idx)});
+				} else if (cached.val.total_count != idx) {
+					wrongValues++;
+				}
+			}
+		});
+	}
+	for (auto& th : threads) th.join();
+
+	EXPECT_EQ(wrongValues.load(), 0);
+	auto stats = cache.GetStats();
+	EXPECT_EQ(stats.hits + stats.misses, size_t(threadsCount * iterCount));
+	EXPECT_GT(stats.hits, 0u);
+	EXPECT_GT(stats.evictions, 0u);
+	EXPECT_LT(stats.items, size_t(keysCount));
+}
+
+TEST(LruCache, AdmittedEntryIsNotEvictedTest) {
+	typedef reindexer::LRUCache<QueryCacheKey, QueryCacheVal, reindexer::HashQueryCacheKey, EqQueryCacheKey> Cache;
+	// Limit is less than size of any entry, so entries of shard are evicted by the next admission to it
+	Cache cache(1, 1);
+	for (int i = 0; i < 100; i++) {
+		QueryCacheKey key(Query("namespace" + std::to_string(i)));
+		auto cached = cache.Get(key);
+		ASSERT_TRUE(cached.key != nullptr);
+		EXPECT_TRUE(EqQueryCacheKey()(key, *cached.key));
+		EXPECT_GE(cache.GetStats().items, 1u);
+	}
+	EXPECT_GT(cache.GetStats().evictions, 0u);
+}
+
+TEST(LruCache, MemoryBudgetTest) {
+	const int keysCount = 1000;
+	const size_t budgetLimit = 64 * 1024;
+	typedef reindexer::LRUCache<QueryCacheKey, QueryCacheVal, reindexer::HashQueryCacheKey, EqQueryCacheKey> Cache;
+	auto& budget = reindexer::CacheMemoryBudget::Instance();
+
+	vector<QueryCacheKey> keys;
+	for (int i = 0; i < keysCount; i++) keys.emplace_back(Query("namespace" + std::to_string(i)));
+
+	size_t usedBefore = budget.Used();
+	budget.SetLimit(usedBefore + budgetLimit);
+	{
+		// Own limits of caches are large, so entries are evicted only by shared budget
+		Cache cache1(1 << 30, 1), cache2(1 << 30, 1);
+		for (int i = 0; i < keysCount; i++) {
+			Cache& cache = (i % 2) ? cache1 : cache2;
+			auto cached = cache.Get(keys[i]);
+			if (cached.key) cache.Put(keys[i], QueryCacheVal{static_cast<size_t>(i)});
+		}
+		EXPECT_LE(budget.Used(), usedBefore + budgetLimit);
+		auto stats1 = cache1.GetStats(), stats2 = cache2.GetStats();
+		EXPECT_GT(stats1.evictions, 0u);
+		EXPECT_GT(stats2.evictions, 0u);
+		EXPECT_GT(stats1.items, 0u);
+		EXPECT_GT(stats2.items, 0u);
+		EXPECT_EQ(stats1.totalSize + stats2.totalSize, budget.Used() - usedBefore);
+	}
+	// Destroyed caches release their memory from budget
+	EXPECT_EQ(budget.Used(), usedBefore);
+	budget.SetLimit(0);
+}
@@ -27,6 +27,7 @@ std::unordered_map<int, const char *> kRPCCodes = {
 	{kCmdGetMeta, "GetMeta"},
 	{kCmdPutMeta, "PutMeta"},
 	{kCmdEnumMeta, "EnumMeta"},
+	{kCmdGetMemStat, "GetMemStat"},
 };
 
 const char *CmdName(CmdCode cmd) {
@@ -31,6 +31,8 @@ enum CmdCode {
 	kCmdPutMeta = 65,
 	kCmdEnumMeta = 66,
 
+	kCmdGetMemStat = 80,
+
 	kCmdCodeMax = 128
 };
 
@@ -1,4 +1,5 @@
 #include "dispatcher.h"
+#include <chrono>
 #include <cstdarg>
 #include <unordered_map>
 #include "debug/allocdebug.h"
@@ -11,20 +12,30 @@ namespace cproto {
 
 Error Dispatcher::handle(Context &ctx) {
 	if (ctx.call->cmd < handlers_.size()) {
+		auto tmStart = std::chrono::high_resolution_clock::now();
+		Error ret;
 		for (auto &middleware : middlewares_) {
-			auto ret = middleware.func_(middleware.object_, ctx);
-			if (!ret.ok()) {
-				return ret;
-			}
+			ret = middleware.func_(middleware.object_, ctx);
+			if (!ret.ok()) break;
 		}
 		auto handler = handlers_[ctx.call->cmd];
 		if (handler.func_) {
-			return handler.func_(handler.object_, ctx);
+			if (ret.ok()) ret = handler.func_(handler.object_, ctx);
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tmStart);
+			metrics_.Record(ctx.call->cmd, elapsed.count(), !ret.ok());
+			return ret;
 		}
+		if (!ret.ok()) return ret;
 	}
 	return Error(errParams, "Invalid RPC call. CmdCode %08X\n", ctx.call->cmd);
 }
 
+std::vector<RequestMetrics::Counters> Dispatcher::GetMetrics(std::vector<std::string> &labels) const {
+	labels.clear();
+	for (size_t cmd = 0; cmd < handlers_.size(); ++cmd) labels.push_back(string("cmd=\"") + CmdName(CmdCode(cmd)) + "\"");
+	return metrics_.Get();
+}
+
 }  // namespace cproto
 }  // namespace net
 }  // namespace reindexer
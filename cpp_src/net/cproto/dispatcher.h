@@ -7,6 +7,7 @@
 #include <vector>
 #include "args.h"
 #include "cproto.h"
+#include "net/metrics.h"
 #include "net/stat.h"
 #include "tools/errors.h"
 #include "tools/slice.h"
@@ -55,7 +56,7 @@ class Dispatcher {
 	friend class Connection;
 
 public:
-	Dispatcher() : handlers_(kCmdCodeMax, {nullptr, nullptr}) {}
+	Dispatcher() : handlers_(kCmdCodeMax, {nullptr, nullptr}), metrics_(kCmdCodeMax) {}
 
 	/// Add handler for command.
 	/// @param cmd - Command code
@@ -97,6 +98,11 @@ public:
 		onClose_ = [=](Context &ctx, const Error &err) { (static_cast<K *>(object)->*func)(ctx, err); };
 	}
 
+	/// Get counters of handled calls of each registered command
+	/// @param labels - prometheus labels of commands, e.g. cmd="Select"
+	/// @return counters of commands
+	std::vector<RequestMetrics::Counters> GetMetrics(std::vector<std::string> &labels) const;
+
 protected:
 	Error handle(Context &ctx);
 
@@ -137,6 +143,8 @@ protected:
 
 	std::function<void(Context &ctx, const Error &err, const Args &args)> logger_;
 	std::function<void(Context &ctx, const Error &err)> onClose_;
+
+	RequestMetrics metrics_;
 };
 }  // namespace cproto
 }  // namespace net
@@ -1,4 +1,5 @@
 #include "router.h"
+#include <chrono>
 #include <cstdarg>
 #include <unordered_map>
 #include "debug/allocdebug.h"
@@ -109,6 +110,8 @@ HttpMethod lookupMethod(const char *method) {
 	return HttpMethod(-1);
 }
 
+const char *Router::methodName(HttpMethod method) { return mathodNames[method]; }
+
 int Router::handle(Context &ctx) {
 	auto method = lookupMethod(ctx.request->method);
 	if (method < 0) {
@@ -137,6 +140,7 @@ int Router::handle(Context &ctx) {
 				if ((asteriskPtr && strncmp(urlPtr, routePtr, asteriskPtr - routePtr)) || (!asteriskPtr && strcmp(urlPtr, routePtr))) break;
 
 				int res = 0;
+				auto tmStart = std::chrono::high_resolution_clock::now();
 				for (auto &mw : middlewares_) {
 					auto ret = mw.func_(mw.object_, ctx);
 					if (ret != 0) {
@@ -146,6 +150,9 @@ int Router::handle(Context &ctx) {
 
 				res = r.h_.func_(r.h_.object_, ctx);
 
+				auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tmStart);
+				metrics_.Record(r.metricsId_, elapsed.count(), ctx.writer->RespCode() >= StatusInternalServerError);
+
 				if (logger_) {
 					logger_(ctx);
 				}
@@ -6,6 +6,7 @@
 #include <mutex>
 #include <string>
 #include "estl/h_vector.h"
+#include "net/metrics.h"
 #include "net/stat.h"
 #include "tools/slice.h"
 
@@ -201,14 +202,25 @@ public:
 		notFoundHandler_ = Handler{func_wrapper<K, func>, object};
 	}
 
+	/// Get counters of handled requests of each route
+	/// @param labels - prometheus labels of routes, e.g. method="GET",route="/api/v1/db"
+	/// @return counters of routes
+	std::vector<RequestMetrics::Counters> GetMetrics(std::vector<std::string> &labels) const {
+		labels = metricsLabels_;
+		return metrics_.Get();
+	}
+
 protected:
 	int handle(Context &ctx);
+	static const char *methodName(HttpMethod method);
 
 	template <class K, int (K::*func)(Context &)>
 	void addRoute(HttpMethod method, const char *path, K *object) {
 		Handler h{func_wrapper<K, func>, object};
-		Route r(path, h);
+		Route r(path, h, metricsLabels_.size());
 		routes_[method].push_back(r);
+		metricsLabels_.push_back(string("method=\"") + methodName(method) + "\",route=\"" + path + "\"");
+		metrics_.Resize(metricsLabels_.size());
 	}
 
 	template <class K, int (K::*func)(Context &ctx)>
@@ -222,10 +234,11 @@ protected:
 	};
 
 	struct Route {
-		Route(string path, Handler h) : path_(path), h_(h) {}
+		Route(string path, Handler h, size_t metricsId) : path_(path), h_(h), metricsId_(metricsId) {}
 
 		string path_;
 		Handler h_;
+		size_t metricsId_;
 	};
 
 	std::vector<Route> routes_[kMaxMethod];
@@ -233,6 +246,9 @@ protected:
 
 	Handler notFoundHandler_;
 	std::function<void(Context &ctx)> logger_;
+
+	RequestMetrics metrics_;
+	std::vector<std::string> metricsLabels_;
 };
 }  // namespace http
 }  // namespace net
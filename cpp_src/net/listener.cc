@@ -144,6 +144,7 @@ void Listener::io_accept(ev::io &watcher, int revents) {
 		connectons_.push_back(std::unique_ptr<IConnection>(shared_->connFactory_(loop_, client_fd)));
 	}
 	connCount_++;
+	shared_->accepted_.fetch_add(1, std::memory_order_relaxed);
 	shared_->lck_.lock();
 	if (shared_->count_ < shared_->maxListeners_) {
 		shared_->count_++;
@@ -160,6 +161,7 @@ void Listener::timeout_cb(ev::periodic &, int) {
 			std::swap(*it, connectons_[idleConns_]);
 			++idleConns_;
 			connCount_--;
+			shared_->closed_.fetch_add(1, std::memory_order_relaxed);
 		}
 	}
 	if (connectons_.size() - idleConns_ != 0) {
@@ -212,7 +214,7 @@ void Listener::reserveStack() {
 }
 
 Listener::Shared::Shared(ConnectionFactory connFactory, int maxListeners)
-	: fd_(-1), maxListeners_(maxListeners), count_(1), connFactory_(connFactory), terminating_(false) {}
+	: fd_(-1), maxListeners_(maxListeners), count_(1), connFactory_(connFactory), terminating_(false), accepted_(0), closed_(0) {}
 
 Listener::Shared::~Shared() { close(fd_); }
 
@@ -32,6 +32,13 @@ public:
 	void Fork(int clones);
 	/// Stop synchroniusly stops listener
 	void Stop();
+	/// Get total count of accepted connections of all listener threads
+	uint64_t AcceptedConnections() const { return shared_->accepted_.load(std::memory_order_relaxed); }
+	/// Get count of currently open connections of all listener threads.
+	/// Closed connections are reaped by periodic timer, so value could lag behind a bit
+	uint64_t ActiveConnections() const {
+		return shared_->accepted_.load(std::memory_order_relaxed) - shared_->closed_.load(std::memory_order_relaxed);
+	}
 
 protected:
 	void reserveStack();
@@ -50,6 +57,7 @@ protected:
 		ConnectionFactory connFactory_;
 		std::atomic<bool> terminating_;
 		std::string addr_;
+		std::atomic<uint64_t> accepted_, closed_;
 	};
 	Listener(ev::dynamic_loop &loop, std::shared_ptr<Shared> shared);
 	static void clone(std::shared_ptr<Shared>);
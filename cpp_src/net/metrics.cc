@@ -0,0 +1,99 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cassert>
+#include "tools/serializer.h"
+
+namespace reindexer {
+namespace net {
+
+const uint64_t RequestMetrics::kBucketsBounds[kBuckets - 1] = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 100000, 500000, 1000000};
+
+static std::atomic<uint64_t> metricsCounter_{0};
+
+// Shards of all metrics objects, used by current thread
+static thread_local std::vector<std::pair<uint64_t, void *>> threadShards_;
+
+static inline void increment(std::atomic<uint64_t> &counter, uint64_t delta) {
+	// Only owner thread writes to shard, so RMW is not needed
+	counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+RequestMetrics::AtomicCounters::AtomicCounters() : count(0), errors(0), totalTime(0) {
+	for (auto &b : buckets) b.store(0, std::memory_order_relaxed);
+}
+
+RequestMetrics::RequestMetrics(size_t kinds) : id_(metricsCounter_++), kinds_(kinds) {}
+
+RequestMetrics::~RequestMetrics() {}
+
+void RequestMetrics::Resize(size_t kinds) {
+	std::lock_guard<std::mutex> lck(mtx_);
+	assert(shards_.empty());
+	kinds_ = kinds;
+}
+
+RequestMetrics::Shard *RequestMetrics::threadShard() {
+	for (auto &s : threadShards_) {
+		if (s.first == id_) return static_cast<Shard *>(s.second);
+	}
+	std::lock_guard<std::mutex> lck(mtx_);
+	shards_.emplace_back(new Shard(kinds_));
+	threadShards_.push_back({id_, shards_.back().get()});
+	return shards_.back().get();
+}
+
+void RequestMetrics::Record(size_t kind, uint64_t timeUs, bool error) {
+	if (kind >= kinds_) return;
+	auto &c = threadShard()->counters[kind];
+	increment(c.count, 1);
+	if (error) increment(c.errors, 1);
+	increment(c.totalTime, timeUs);
+	auto bucket = std::lower_bound(std::begin(kBucketsBounds), std::end(kBucketsBounds), timeUs) - std::begin(kBucketsBounds);
+	increment(c.buckets[bucket], 1);
+}
+
+std::vector<RequestMetrics::Counters> RequestMetrics::Get() const {
+	std::lock_guard<std::mutex> lck(mtx_);
+	std::vector<Counters> ret(kinds_);
+	for (auto &shard : shards_) {
+		for (size_t kind = 0; kind < kinds_; ++kind) {
+			auto &src = shard->counters[kind];
+			auto &dst = ret[kind];
+			dst.count += src.count.load(std::memory_order_relaxed);
+			dst.errors += src.errors.load(std::memory_order_relaxed);
+			dst.totalTime += src.totalTime.load(std::memory_order_relaxed);
+			for (int i = 0; i < kBuckets; ++i) dst.buckets[i] += src.buckets[i].load(std::memory_order_relaxed);
+		}
+	}
+	return ret;
+}
+
+void RequestMetrics::GetPrometheus(WrSerializer &ser, const char *metric, const std::vector<Counters> &counters,
+								   const std::vector<std::string> &labels) {
+	assert(counters.size() <= labels.size());
+	ser.Printf("# TYPE %s_duration_seconds histogram\n", metric);
+	for (size_t kind = 0; kind < counters.size(); ++kind) {
+		auto &c = counters[kind];
+		if (!c.count) continue;
+		const char *lbl = labels[kind].c_str();
+		// Buckets are counted separately, so sum of buckets could be a bit inconsistent with count on concurrent scrape
+		uint64_t cumulative = 0;
+		for (int i = 0; i < kBuckets - 1; ++i) {
+			cumulative += c.buckets[i];
+			ser.Printf("%s_duration_seconds_bucket{%s,le=\"%g\"} %llu\n", metric, lbl, double(kBucketsBounds[i]) / 1000000,
+					   static_cast<unsigned long long>(cumulative));
+		}
+		cumulative += c.buckets[kBuckets - 1];
+		ser.Printf("%s_duration_seconds_bucket{%s,le=\"+Inf\"} %llu\n", metric, lbl, static_cast<unsigned long long>(cumulative));
+		ser.Printf("%s_duration_seconds_sum{%s} %g\n", metric, lbl, double(c.totalTime) / 1000000);
+		ser.Printf("%s_duration_seconds_count{%s} %llu\n", metric, lbl, static_cast<unsigned long long>(cumulative));
+	}
+	ser.Printf("# TYPE %s_errors_total counter\n", metric);
+	for (size_t kind = 0; kind < counters.size(); ++kind) {
+		if (!counters[kind].count) continue;
+		ser.Printf("%s_errors_total{%s} %llu\n", metric, labels[kind].c_str(), static_cast<unsigned long long>(counters[kind].errors));
+	}
+}
+
+}  // namespace net
+}  // namespace reindexer
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace reindexer {
+
+class WrSerializer;
+
+namespace net {
+
+/// Counters of handled requests of each kind (RPC command, HTTP route).
+/// Each thread updates it's own shard of counters by plain relaxed stores, without locks and atomic RMW operations.
+/// Shards are summed only on scrape, so overhead of counting on hot path is near zero.
+class RequestMetrics {
+public:
+	/// Count of latency histogram buckets, including +Inf bucket
+	enum { kBuckets = 12 };
+	/// Upper bounds of latency histogram buckets in microseconds
+	static const uint64_t kBucketsBounds[kBuckets - 1];
+
+	struct Counters {
+		uint64_t count = 0;
+		uint64_t errors = 0;
+		uint64_t totalTime = 0;
+		// Count of requests in each bucket (not cumulative)
+		uint64_t buckets[kBuckets] = {};
+	};
+
+	RequestMetrics(size_t kinds = 0);
+	~RequestMetrics();
+	RequestMetrics(const RequestMetrics &) = delete;
+	RequestMetrics &operator=(const RequestMetrics &) = delete;
+
+	/// Set count of request kinds. Must not be called after first request is recorded
+	void Resize(size_t kinds);
+	size_t Size() const { return kinds_; }
+	/// Record handled request
+	/// @param kind - kind of request
+	/// @param timeUs - time of request handling in microseconds
+	/// @param error - true if request failed
+	void Record(size_t kind, uint64_t timeUs, bool error);
+	/// Get sum of counters of all threads
+	std::vector<Counters> Get() const;
+
+	/// Put counters in prometheus text format: histogram 'metric'_duration_seconds and counter 'metric'_errors_total.
+	/// Kinds without requests are skipped
+	/// @param ser - output serializer
+	/// @param metric - metric name prefix
+	/// @param counters - counters of each kind
+	/// @param labels - labels of each kind, e.g. cmd="Select"
+	static void GetPrometheus(WrSerializer &ser, const char *metric, const std::vector<Counters> &counters,
+							  const std::vector<std::string> &labels);
+
+protected:
+	struct AtomicCounters {
+		AtomicCounters();
+		std::atomic<uint64_t> count, errors, totalTime;
+		std::atomic<uint64_t> buckets[kBuckets];
+	};
+	struct Shard {
+		explicit Shard(size_t kinds) : counters(new AtomicCounters[kinds]) {}
+		std::unique_ptr<AtomicCounters[]> counters;
+	};
+
+	Shard *threadShard();
+
+	// Unique id of metrics object. Used as key of thread local shards cache, instead of pointer, which could be reused
+	const uint64_t id_;
+	size_t kinds_;
+	mutable std::mutex mtx_;
+	std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace net
+}  // namespace reindexer
@@ -0,0 +1,52 @@
+#include "tools/hyperloglog.h"
+#include <assert.h>
+#include <math.h>
+
+namespace reindexer {
+
+// Finalizer of MurmurHash3
+static inline uint64_t mix64(uint64_t h) {
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+HyperLogLog::HyperLogLog(int precision) : precision_(precision), registers_(size_t(1) << precision, 0) {
+	assert(precision >= 4 && precision <= 18);
+}
+
+void HyperLogLog::Add(uint64_t hash) {
+	hash = mix64(hash);
+	size_t idx = hash >> (64 - precision_);
+	// Position of first set bit in the rest of hash. Guard bit limits it, if the rest is zero
+	uint64_t rest = (hash << precision_) | (uint64_t(1) << (precision_ - 1));
+	uint8_t rank = __builtin_clzll(rest) + 1;
+	if (rank > registers_[idx]) registers_[idx] = rank;
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+	assert(other.precision_ == precision_);
+	for (size_t i = 0; i < registers_.size(); ++i) {
+		if (other.registers_[i] > registers_[i]) registers_[i] = other.registers_[i];
+	}
+}
+
+double HyperLogLog::Estimate() const {
+	double m = registers_.size();
+	double sum = 0;
+	int zeros = 0;
+	for (auto r : registers_) {
+		sum += ldexp(1.0, -r);
+		if (!r) ++zeros;
+	}
+	double alpha = 0.7213 / (1.0 + 1.079 / m);
+	double estimate = alpha * m * m / sum;
+	// Linear counting is more precise for small cardinalities. Large range correction is not needed with 64 bit hashes
+	if (estimate <= 2.5 * m && zeros) estimate = m * log(m / zeros);
+	return estimate;
+}
+
+}  // namespace reindexer
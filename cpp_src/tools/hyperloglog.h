@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace reindexer {
+
+/// HyperLogLog estimator of count of distinct values.
+/// Standard error of estimation is 1.04 / sqrt(2 ^ precision), i.e. ~0.8% for default precision
+class HyperLogLog {
+public:
+	explicit HyperLogLog(int precision = 14);
+
+	/// Add value by it's hash. Hash is mixed, so weak hashes (e.g. identity hash of ints) are allowed
+	void Add(uint64_t hash);
+	/// Add all values of other estimator with the same precision
+	void Merge(const HyperLogLog &other);
+	double Estimate() const;
+
+protected:
+	int precision_;
+	std::vector<uint8_t> registers_;
+};
+
+}  // namespace reindexer
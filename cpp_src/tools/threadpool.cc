@@ -0,0 +1,56 @@
+#include "threadpool.h"
+#include <algorithm>
+
+namespace reindexer {
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lck(mtx_);
+		terminate_ = true;
+	}
+	jobsCond_.notify_all();
+	for (auto &th : threads_) th.join();
+}
+
+size_t ThreadPool::takeTask(Job *job) {
+	size_t idx = job->next++;
+	if (job->next == job->count) jobs_.erase(std::find(jobs_.begin(), jobs_.end(), job));
+	return idx;
+}
+
+void ThreadPool::Run(size_t count, const std::function<void(size_t)> &task) {
+	if (!count) return;
+	Job job(task, count);
+
+	std::unique_lock<std::mutex> lck(mtx_);
+	if (count > 1 && threads_.size() < threadsCount_) {
+		for (size_t i = threads_.size(); i < threadsCount_; ++i) threads_.emplace_back([this]() { worker(); });
+	}
+	jobs_.push_back(&job);
+	if (count > 1) jobsCond_.notify_all();
+
+	while (job.next < job.count) {
+		size_t idx = takeTask(&job);
+		lck.unlock();
+		task(idx);
+		lck.lock();
+		job.done++;
+	}
+	doneCond_.wait(lck, [&job]() { return job.done == job.count; });
+}
+
+void ThreadPool::worker() {
+	std::unique_lock<std::mutex> lck(mtx_);
+	for (;;) {
+		jobsCond_.wait(lck, [this]() { return terminate_ || !jobs_.empty(); });
+		if (terminate_) return;
+		Job *job = jobs_.front();
+		size_t idx = takeTask(job);
+		lck.unlock();
+		job->task(idx);
+		lck.lock();
+		if (++job->done == job->count) doneCond_.notify_all();
+	}
+}
+
+}  // namespace reindexer
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace reindexer {
+
+/// Pool of worker threads for parallel execution of parts of one request.
+/// Threads are started on first use.
+class ThreadPool {
+public:
+	explicit ThreadPool(size_t threads) : threadsCount_(threads) {}
+	~ThreadPool();
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	/// Execute task(0) ... task(count - 1) in parallel and wait for all of them.
+	/// Calling thread executes tasks too, so tasks are done even if all workers are busy.
+	/// @param count - count of tasks
+	/// @param task - task function. Must not throw
+	void Run(size_t count, const std::function<void(size_t)> &task);
+	size_t Size() const { return threadsCount_; }
+
+protected:
+	struct Job {
+		Job(const std::function<void(size_t)> &t, size_t c) : task(t), count(c) {}
+		const std::function<void(size_t)> &task;
+		size_t count;
+		// Index of next task to start
+		size_t next = 0;
+		size_t done = 0;
+	};
+
+	void worker();
+	// Take index of next task of job. Job is removed from queue, when all it's tasks are taken. Must be called under mtx_
+	size_t takeTask(Job *job);
+
+	size_t threadsCount_;
+	std::vector<std::thread> threads_;
+	// Jobs, which have not started tasks
+	std::deque<Job *> jobs_;
+	std::mutex mtx_;
+	std::condition_variable jobsCond_, doneCond_;
+	bool terminate_ = false;
+};
+
+}  // namespace reindexer
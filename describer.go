@@ -48,15 +48,30 @@ type NamespaceDescription struct {
 	StorageOK       bool               `json:"storage_ok"`
 	StoragePath     string             `json:"storage_path,omitempty"`
 	StorageError    string             `json:"storage_error,omitempty"`
+	PKFilterEnabled bool               `json:"pk_filter_enabled"`
+	PKFilterMemSize int64              `json:"pk_filter_mem_size"`
+	QueryCache      CacheStats         `json:"query_cache"`
+	ResultsCache    CacheStats         `json:"query_results_cache"`
+	CacheTotalSize  int64              `json:"cache_total_size"`
 	ItemsCount      int                `json:"items_count,omitempty"`
 }
 
 type IndexDescription struct {
-	Name       string   `json:"name"`
-	FieldType  string   `json:"field_type"`
-	IsArray    bool     `json:"is_array"`
-	Sortable   bool     `json:"sortable"`
-	PK         bool     `json:"pk"`
-	Fulltext   bool     `json:"fulltext"`
-	Conditions []string `json:"conditions"`
+	Name       string     `json:"name"`
+	FieldType  string     `json:"field_type"`
+	IsArray    bool       `json:"is_array"`
+	Sortable   bool       `json:"sortable"`
+	PK         bool       `json:"pk"`
+	Fulltext   bool       `json:"fulltext"`
+	Cache      CacheStats `json:"cache"`
+	Conditions []string   `json:"conditions"`
+}
+
+// CacheStats is statistics of namespace or index cache
+type CacheStats struct {
+	Hits       int64 `json:"hits"`
+	Misses     int64 `json:"misses"`
+	Evictions  int64 `json:"evictions"`
+	ItemsCount int64 `json:"items_count"`
+	TotalSize  int64 `json:"total_size"`
 }
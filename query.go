@@ -23,7 +23,10 @@ const (
 	queryAggregation    = bindings.QueryAggregation
 	querySelectFilter   = bindings.QuerySelectFilter
 	QuerySelectFunction = bindings.QuerySelectFunction
+	queryCacheResults   = bindings.QueryCacheResults
 	queryEnd            = bindings.QueryEnd
+
+	queryApproxAggregations = bindings.QueryApproxAggregations
 )
 
 // Constants for calc total
@@ -31,6 +34,7 @@ const (
 	modeNoCalc        = bindings.ModeNoCalc
 	modeCachedTotal   = bindings.ModeCachedTotal
 	modeAccurateTotal = bindings.ModeAccurateTotal
+	modeApproxTotal   = bindings.ModeApproxTotal
 )
 
 // Operator
@@ -348,6 +352,17 @@ func (q *Query) CachedTotal(totalNames ...string) *Query {
 	return q
 }
 
+// ApproxTotal Request approximate total items calculation.
+// Total is extrapolated from matches among sampled items, after requested items are selected
+func (q *Query) ApproxTotal(totalNames ...string) *Query {
+	q.ser.PutVarCUInt(queryReqTotal)
+	q.ser.PutVarCUInt(modeApproxTotal)
+	if len(totalNames) != 0 {
+		q.totalName = totalNames[0]
+	}
+	return q
+}
+
 // Limit - Set limit (count) of returned items
 func (q *Query) Limit(limitItems int) *Query {
 	if limitItems > cInt32Max {
@@ -372,6 +387,20 @@ func (q *Query) Debug(level int) *Query {
 	return q
 }
 
+// CacheResults - Enable cache of query results. Results of repeated query are taken from cache until namespace is modified.
+// Query must not contain joins, merges, select functions and fulltext conditions
+func (q *Query) CacheResults() *Query {
+	q.ser.PutVarCUInt(queryCacheResults).PutVarCUInt(1)
+	return q
+}
+
+// ApproxAggregations - Calculate SUM, AVG and COUNT aggregations by random sample of matched items.
+// Sample grows until relative error of results with 95% confidence is less than maxError
+func (q *Query) ApproxAggregations(maxError float64) *Query {
+	q.ser.PutVarCUInt(queryApproxAggregations).PutDouble(maxError)
+	return q
+}
+
 // SetContext set interface, which will be passed to Joined interface
 func (q *Query) SetContext(ctx interface{}) *Query {
 	q.context = ctx
@@ -19,6 +19,7 @@ const (
 	IndexOptArray      = bindings.IndexOptArray
 	IndexOptDense      = bindings.IndexOptDense
 	IndexOptAppendable = bindings.IndexOptAppendable
+	IndexOptSparse     = bindings.IndexOptSparse
 )
 
 func (db *Reindexer) createIndex(namespace string, st reflect.Type, subArray bool, reindexBasePath, jsonBasePath string, joined *map[string][]int) (err error) {
@@ -69,6 +70,7 @@ func (db *Reindexer) createIndex(namespace string, st reflect.Type, subArray boo
 		opts.PK(strings.Index(idxOpts, "pk") >= 0)
 		opts.Dense(strings.Index(idxOpts, "dense") >= 0)
 		opts.Appendable(strings.Index(idxOpts, "appendable") >= 0)
+		opts.Sparse(strings.Index(idxOpts, "sparse") >= 0)
 
 		if opts.IsPK() && strings.TrimSpace(idxName) == "" {
 			return fmt.Errorf("No index name is specified for primary key in field %s", st.Field(i).Name)
@@ -39,6 +39,10 @@ const (
 	ANY = bindings.ANY
 	// Empty value (usualy zero len array)
 	EMPTY = bindings.EMPTY
+	// Point within distance from point (x, y, distance)
+	DWITHIN = bindings.DWITHIN
+	// Point inside bounding box (x1, y1, x2, y2)
+	BOX = bindings.BOX
 )
 
 const (
@@ -53,8 +57,13 @@ const (
 )
 
 const (
-	AggAvg = bindings.AggAvg
-	AggSum = bindings.AggSum
+	AggAvg                 = bindings.AggAvg
+	AggSum                 = bindings.AggSum
+	AggMin                 = bindings.AggMin
+	AggMax                 = bindings.AggMax
+	AggCount               = bindings.AggCount
+	AggCountDistinct       = bindings.AggCountDistinct
+	AggCountDistinctApprox = bindings.AggCountDistinctApprox
 )
 
 var logger Logger = &nullLogger{}
@@ -515,6 +524,56 @@ func (db *Reindexer) ResetStats() {
 	db.binding.ResetStats()
 }
 
+// LRUCacheStats is statistics of cache usage
+type LRUCacheStats struct {
+	Hits       int64 `json:"hits"`
+	Misses     int64 `json:"misses"`
+	Evictions  int64 `json:"evictions"`
+	ItemsCount int64 `json:"items_count"`
+	TotalSize  int64 `json:"total_size"`
+}
+
+// IndexMemStat is memory, used by index. All sizes are in bytes
+type IndexMemStat struct {
+	Name           string        `json:"name"`
+	UniqKeysCount  int64         `json:"uniq_keys_count"`
+	DataSize       int64         `json:"data_size"`
+	IdsetPlainSize int64         `json:"idset_plain_size"`
+	IdsetBTreeSize int64         `json:"idset_btree_size"`
+	SortOrdersSize int64         `json:"sort_orders_size"`
+	FulltextSize   int64         `json:"fulltext_size"`
+	TotalSize      int64         `json:"total_size"`
+	IdsetCache     LRUCacheStats `json:"idset_cache"`
+}
+
+// NamespaceMemStat is memory, used by namespace and it's indexes. All sizes are in bytes
+type NamespaceMemStat struct {
+	Name              string         `json:"name"`
+	ItemsCount        int64          `json:"items_count"`
+	EmptyItemsCount   int64          `json:"empty_items_count"`
+	DataSize          int64          `json:"data_size"`
+	PKFilterSize      int64          `json:"pk_filter_size"`
+	TotalSize         int64          `json:"total_size"`
+	QueryCache        LRUCacheStats  `json:"query_cache"`
+	QueryResultsCache LRUCacheStats  `json:"query_results_cache"`
+	Indexes           []IndexMemStat `json:"indexes"`
+}
+
+// GetMemStat returns memory statistics of namespace and it's indexes
+func (db *Reindexer) GetMemStat(namespace string) (*NamespaceMemStat, error) {
+	out, err := db.binding.GetMemStat(namespace)
+	if err != nil {
+		return nil, err
+	}
+	defer out.Free()
+
+	stat := &NamespaceMemStat{}
+	if err = json.Unmarshal(out.GetBuf(), stat); err != nil {
+		return nil, err
+	}
+	return stat, nil
+}
+
 // EnableStorage enables persistent storage of data
 // [[deprecated]] storage path should be passed as DSN part to reindexer.NewReindex (""), e.g. reindexer.NewReindexer ("builtin:///tmp/reindex")
 func (db *Reindexer) EnableStorage(storagePath string) error {
@@ -0,0 +1,55 @@
+package reindexer
+
+import (
+	"testing"
+
+	"github.com/restream/reindexer"
+)
+
+type TestItemMemStat struct {
+	ID    int    `reindex:"id,,pk"`
+	Genre int64  `reindex:"genre,tree"`
+	Name  string `reindex:"name,hash"`
+}
+
+func init() {
+	tnamespaces["test_items_memstat"] = TestItemMemStat{}
+}
+
+func TestMemStat(t *testing.T) {
+	const itemsCount = 100
+	for i := 0; i < itemsCount; i++ {
+		if err := DB.Upsert("test_items_memstat", TestItemMemStat{ID: i, Genre: int64(i % 10), Name: randString()}); err != nil {
+			panic(err)
+		}
+	}
+
+	stat, err := DB.GetMemStat("test_items_memstat")
+	if err != nil {
+		panic(err)
+	}
+	if stat.Name != "test_items_memstat" || stat.ItemsCount != itemsCount {
+		t.Fatalf("Unexpected namespace stats: %+v", *stat)
+	}
+	if stat.DataSize == 0 || stat.TotalSize < stat.DataSize {
+		t.Fatalf("Unexpected sizes of namespace data: %+v", *stat)
+	}
+
+	indexes := make(map[string]reindexer.IndexMemStat)
+	for _, idx := range stat.Indexes {
+		indexes[idx.Name] = idx
+	}
+	for name, uniqKeys := range map[string]int64{"id": itemsCount, "genre": 10} {
+		idx, ok := indexes[name]
+		if !ok {
+			t.Fatalf("No stats of index '%s'", name)
+		}
+		if idx.UniqKeysCount != uniqKeys || idx.TotalSize == 0 {
+			t.Fatalf("Unexpected stats of index '%s': %+v", name, idx)
+		}
+	}
+
+	if _, err = DB.GetMemStat("test_items_memstat_not_exists"); err == nil {
+		t.Fatalf("Stats of not existing namespace must return error")
+	}
+}